@@ -0,0 +1,117 @@
+#include "ArchivoMapeado.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+ArchivoMapeado::ArchivoMapeado()
+    : datos(nullptr),
+      tamano(0),
+#ifdef _WIN32
+      archivo(INVALID_HANDLE_VALUE),
+      mapeo(nullptr)
+#else
+      descriptor(-1)
+#endif
+{
+}
+
+ArchivoMapeado::~ArchivoMapeado()
+{
+    cerrar();
+}
+
+#ifdef _WIN32
+
+bool ArchivoMapeado::abrir(const std::string& ruta)
+{
+    cerrar();
+
+    archivo = CreateFileA(ruta.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                          OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (archivo == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER tamanoArchivo;
+    if (!GetFileSizeEx(archivo, &tamanoArchivo) || tamanoArchivo.QuadPart == 0) {
+        cerrar();
+        return false;
+    }
+
+    mapeo = CreateFileMappingA(archivo, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapeo == nullptr) {
+        cerrar();
+        return false;
+    }
+
+    datos = static_cast<const unsigned char*>(MapViewOfFile(mapeo, FILE_MAP_READ, 0, 0, 0));
+    if (datos == nullptr) {
+        cerrar();
+        return false;
+    }
+    tamano = static_cast<size_t>(tamanoArchivo.QuadPart);
+    return true;
+}
+
+void ArchivoMapeado::cerrar()
+{
+    if (datos != nullptr) {
+        UnmapViewOfFile(datos);
+        datos = nullptr;
+    }
+    if (mapeo != nullptr) {
+        CloseHandle(mapeo);
+        mapeo = nullptr;
+    }
+    if (archivo != INVALID_HANDLE_VALUE) {
+        CloseHandle(archivo);
+        archivo = INVALID_HANDLE_VALUE;
+    }
+    tamano = 0;
+}
+
+#else
+
+bool ArchivoMapeado::abrir(const std::string& ruta)
+{
+    cerrar();
+
+    descriptor = open(ruta.c_str(), O_RDONLY);
+    if (descriptor < 0) return false;
+
+    struct stat info;
+    if (fstat(descriptor, &info) != 0 || info.st_size == 0) {
+        cerrar();
+        return false;
+    }
+
+    void* mapeo = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+    if (mapeo == MAP_FAILED) {
+        cerrar();
+        return false;
+    }
+    datos = static_cast<const unsigned char*>(mapeo);
+    tamano = static_cast<size_t>(info.st_size);
+    return true;
+}
+
+void ArchivoMapeado::cerrar()
+{
+    if (datos != nullptr) {
+        munmap(const_cast<unsigned char*>(datos), tamano);
+        datos = nullptr;
+    }
+    if (descriptor >= 0) {
+        close(descriptor);
+        descriptor = -1;
+    }
+    tamano = 0;
+}
+
+#endif
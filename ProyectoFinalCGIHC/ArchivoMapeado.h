@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+// Archivo de solo lectura mapeado a memoria
+// El contenido se lee directo de la mapping sin copiarlo a un buffer propio
+class ArchivoMapeado {
+public:
+    ArchivoMapeado();
+    ~ArchivoMapeado();
+
+    ArchivoMapeado(const ArchivoMapeado&) = delete;
+    ArchivoMapeado& operator=(const ArchivoMapeado&) = delete;
+
+    bool abrir(const std::string& ruta);
+    void cerrar();
+
+    const unsigned char* getDatos() const { return datos; }
+    size_t getTamano() const { return tamano; }
+    bool estaAbierto() const { return datos != nullptr; }
+
+private:
+    const unsigned char* datos;
+    size_t tamano;
+#ifdef _WIN32
+    void* archivo;      // HANDLE del archivo
+    void* mapeo;        // HANDLE de la mapping
+#else
+    int descriptor;
+#endif
+};
@@ -285,8 +285,8 @@ namespace AssetConstants {
 	// Rutas de shaders
 	namespace ShaderPaths {
 		const std::string SHADER_PATH = "shaders/";
-		const std::string VERTEX_SHADER = SHADER_PATH + "shader_light.vert";
 		const std::string FRAGMENT_SHADER = SHADER_PATH + "shader_light.frag";
+		const std::string DIBUJOS_VERTEX_SHADER = SHADER_PATH + "shader_light_dibujos.vert";
 	}
 
 	// Nombres de skybox
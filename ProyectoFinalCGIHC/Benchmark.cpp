@@ -0,0 +1,236 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <glm.hpp>
+
+namespace {
+
+// Puntos por los que pasa la camara (los mismos lugares que los teletransportes H/J/K/L)
+struct PuntoRecorrido {
+    glm::vec3 posicion;
+    float yaw;
+    float pitch;
+};
+
+const PuntoRecorrido RECORRIDO[] = {
+    { glm::vec3(0.0f, 5.0f, -70.0f), -90.0f, 0.0f },       // Piramide
+    { glm::vec3(0.0f, 40.0f, 10.0f), -90.0f, -35.0f },     // Sobre el centro de la escena
+    { glm::vec3(80.0f, 5.0f, 90.0f), 0.0f, 0.0f },         // Cancha de juego de pelota
+    { glm::vec3(160.0f, 5.0f, -150.0f), 90.0f, 0.0f },     // Boss room
+    { glm::vec3(-130.0f, 5.0f, -130.0f), 180.0f, 0.0f },   // Chinampas
+};
+const unsigned int NUM_PUNTOS = sizeof(RECORRIDO) / sizeof(RECORRIDO[0]);
+
+bool terminaCon(const std::string& texto, const char* sufijo)
+{
+    size_t largo = strlen(sufijo);
+    return texto.size() >= largo && texto.compare(texto.size() - largo, largo, sufijo) == 0;
+}
+
+bool leerEntero(const char* texto, unsigned int& valor, long minimo)
+{
+    char* fin = nullptr;
+    long leido = strtol(texto, &fin, 10);
+    if (fin == texto || *fin != '\0' || leido < minimo) return false;
+    valor = static_cast<unsigned int>(leido);
+    return true;
+}
+
+// Percentil por rango mas cercano sobre valores ya ordenados
+double percentil(const std::vector<double>& ordenados, double p)
+{
+    if (ordenados.empty()) return 0.0;
+    size_t i = static_cast<size_t>(p * (ordenados.size() - 1) + 0.5);
+    return ordenados[std::min(i, ordenados.size() - 1)];
+}
+
+} // namespace
+
+ConfiguracionBenchmark::ConfiguracionBenchmark()
+    : activo(false), frames(600), framesCalentamiento(120), ancho(1366), alto(768),
+      salida("benchmark.csv"), secuencial(false)
+{
+}
+
+bool Benchmark::leerArgumentos(int argc, char** argv, ConfiguracionBenchmark& config)
+{
+    for (int i = 1; i < argc; i++) {
+        std::string argumento = argv[i];
+        bool hayValor = i + 1 < argc;
+        if (argumento == "--benchmark") {
+            config.activo = true;
+        }
+        else if (argumento == "--secuencial") {
+            config.secuencial = true;
+        }
+        else if (argumento == "--frames" && hayValor) {
+            if (!leerEntero(argv[++i], config.frames, 1)) return false;
+        }
+        else if (argumento == "--calentamiento" && hayValor) {
+            if (!leerEntero(argv[++i], config.framesCalentamiento, 0)) return false;
+        }
+        else if (argumento == "--tamano" && hayValor) {
+            if (sscanf(argv[++i], "%dx%d", &config.ancho, &config.alto) != 2 ||
+                config.ancho <= 0 || config.alto <= 0) {
+                return false;
+            }
+        }
+        else if (argumento == "--salida" && hayValor) {
+            config.salida = argv[++i];
+        }
+        else {
+            printf("[Benchmark] Argumento no reconocido: %s\n", argumento.c_str());
+            return false;
+        }
+    }
+    if (!terminaCon(config.salida, ".csv") && !terminaCon(config.salida, ".json")) {
+        printf("[Benchmark] La salida debe terminar en .csv o .json: %s\n", config.salida.c_str());
+        return false;
+    }
+    return true;
+}
+
+Benchmark::Benchmark(const ConfiguracionBenchmark& config)
+    : config(config), fbo(0), colorRbo(0), profundidadRbo(0)
+{
+    muestras.reserve(config.frames);
+}
+
+Benchmark::~Benchmark()
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (fbo != 0) glDeleteFramebuffers(1, &fbo);
+    if (colorRbo != 0) glDeleteRenderbuffers(1, &colorRbo);
+    if (profundidadRbo != 0) glDeleteRenderbuffers(1, &profundidadRbo);
+}
+
+bool Benchmark::inicializar()
+{
+    // Renderbuffers en lugar de texturas: el resultado nunca se lee
+    glGenRenderbuffers(1, &colorRbo);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorRbo);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, config.ancho, config.alto);
+    glGenRenderbuffers(1, &profundidadRbo);
+    glBindRenderbuffer(GL_RENDERBUFFER, profundidadRbo);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, config.ancho, config.alto);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorRbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, profundidadRbo);
+    GLenum estado = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    if (estado != GL_FRAMEBUFFER_COMPLETE) {
+        printf("[Benchmark] Framebuffer incompleto (0x%x)\n", estado);
+        return false;
+    }
+    glViewport(0, 0, config.ancho, config.alto);
+
+    printf("[Benchmark] %u frames (+%u de calentamiento) a %dx%d, simulacion %s -> %s\n",
+        config.frames, config.framesCalentamiento, config.ancho, config.alto,
+        config.secuencial ? "secuencial" : "en paralelo", config.salida.c_str());
+    return true;
+}
+
+void Benchmark::prepararFrame(Camera& camera, unsigned int frame)
+{
+    // El calentamiento se queda en el primer punto; despues el recorrido se reparte en
+    // los frames medidos y vuelve al inicio
+    float t = 0.0f;
+    if (frame >= config.framesCalentamiento) {
+        t = static_cast<float>(frame - config.framesCalentamiento) / config.frames * NUM_PUNTOS;
+    }
+    unsigned int tramo = static_cast<unsigned int>(t) % NUM_PUNTOS;
+    const PuntoRecorrido& a = RECORRIDO[tramo];
+    const PuntoRecorrido& b = RECORRIDO[(tramo + 1) % NUM_PUNTOS];
+    float f = t - static_cast<float>(static_cast<unsigned int>(t));
+    f = f * f * (3.0f - 2.0f * f);  // Arranca y frena suave en cada punto
+
+    // Girar por el lado corto
+    float giro = b.yaw - a.yaw;
+    if (giro > 180.0f) giro -= 360.0f;
+    if (giro < -180.0f) giro += 360.0f;
+
+    camera.setFreeCameraMode(true);
+    camera.teleportToLocation(glm::mix(a.posicion, b.posicion, f), a.yaw + giro * f, glm::mix(a.pitch, b.pitch, f));
+}
+
+void Benchmark::registrar(const MuestraBenchmark& muestra)
+{
+    if (muestra.frame < config.framesCalentamiento) return;
+    muestras.push_back(muestra);
+}
+
+bool Benchmark::escribir() const
+{
+    imprimirResumen();
+    bool escrito = terminaCon(config.salida, ".json") ? escribirJSON() : escribirCSV();
+    if (!escrito) {
+        printf("[Benchmark] No se pudo escribir %s\n", config.salida.c_str());
+    }
+    return escrito;
+}
+
+bool Benchmark::escribirCSV() const
+{
+    std::ofstream salida(config.salida.c_str(), std::ios::trunc);
+    if (!salida.is_open()) return false;
+    salida << "frame,ms_actualizar,ms_uniforms,ms_culling,ms_envio,ms_cpu,ms_frame,"
+              "draw_calls,triangulos,dibujados,descartados,llamadas_gl\n";
+    char linea[256];
+    for (const MuestraBenchmark& m : muestras) {
+        snprintf(linea, sizeof(linea), "%u,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%u,%u,%u,%u,%u\n",
+            m.frame, m.msActualizar, m.msUniforms, m.msCulling, m.msEnvio, m.msCpu, m.msFrame,
+            m.llamadasDibujo, m.triangulos, m.objetosDibujados, m.objetosDescartados, m.llamadasGL);
+        salida << linea;
+    }
+    return salida.good();
+}
+
+bool Benchmark::escribirJSON() const
+{
+    std::ofstream salida(config.salida.c_str(), std::ios::trunc);
+    if (!salida.is_open()) return false;
+    char linea[512];
+    snprintf(linea, sizeof(linea), "{\n  \"frames\": %u,\n  \"calentamiento\": %u,\n  \"ancho\": %d,\n  \"alto\": %d,\n  \"muestras\": [\n",
+        config.frames, config.framesCalentamiento, config.ancho, config.alto);
+    salida << linea;
+    for (size_t i = 0; i < muestras.size(); i++) {
+        const MuestraBenchmark& m = muestras[i];
+        snprintf(linea, sizeof(linea),
+            "    {\"frame\": %u, \"ms_actualizar\": %.4f, \"ms_uniforms\": %.4f, \"ms_culling\": %.4f, "
+            "\"ms_envio\": %.4f, \"ms_cpu\": %.4f, \"ms_frame\": %.4f, \"draw_calls\": %u, \"triangulos\": %u, "
+            "\"dibujados\": %u, \"descartados\": %u, \"llamadas_gl\": %u}%s\n",
+            m.frame, m.msActualizar, m.msUniforms, m.msCulling, m.msEnvio, m.msCpu, m.msFrame,
+            m.llamadasDibujo, m.triangulos, m.objetosDibujados, m.objetosDescartados, m.llamadasGL,
+            i + 1 < muestras.size() ? "," : "");
+        salida << linea;
+    }
+    salida << "  ]\n}\n";
+    return salida.good();
+}
+
+void Benchmark::imprimirResumen() const
+{
+    if (muestras.empty()) return;
+    std::vector<double> cpu;
+    std::vector<double> frame;
+    double sumaCpu = 0.0;
+    double sumaFrame = 0.0;
+    for (const MuestraBenchmark& m : muestras) {
+        cpu.push_back(m.msCpu);
+        frame.push_back(m.msFrame);
+        sumaCpu += m.msCpu;
+        sumaFrame += m.msFrame;
+    }
+    std::sort(cpu.begin(), cpu.end());
+    std::sort(frame.begin(), frame.end());
+    double n = static_cast<double>(muestras.size());
+    printf("[Benchmark] CPU   ms: promedio %.3f, p50 %.3f, p95 %.3f, p99 %.3f, max %.3f\n",
+        sumaCpu / n, percentil(cpu, 0.50), percentil(cpu, 0.95), percentil(cpu, 0.99), cpu.back());
+    printf("[Benchmark] Frame ms: promedio %.3f, p50 %.3f, p95 %.3f, p99 %.3f, max %.3f\n",
+        sumaFrame / n, percentil(frame, 0.50), percentil(frame, 0.95), percentil(frame, 0.99), frame.back());
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <glew.h>
+#include "Camera.h"
+
+// Parametros del modo benchmark que se leen de la linea de comandos
+struct ConfiguracionBenchmark {
+    bool activo;
+    unsigned int frames;                // Frames que se miden
+    unsigned int framesCalentamiento;   // Frames que se dibujan antes de medir (cargas y caches)
+    int ancho;
+    int alto;
+    std::string salida;                 // .csv o .json
+    bool secuencial;                    // Simular y dibujar en orden en lugar de en paralelo
+
+    ConfiguracionBenchmark();
+};
+
+// Tiempos de CPU (ms) y contadores de un frame medido
+struct MuestraBenchmark {
+    unsigned int frame;
+    double msActualizar;    // Simulacion y subidas a la GPU (en paralelo solo lo que se espero)
+    double msUniforms;
+    double msCulling;
+    double msEnvio;
+    double msCpu;           // Todo el frame en el hilo principal
+    double msFrame;         // msCpu mas la espera a que la GPU termine
+    unsigned int llamadasDibujo;
+    unsigned int triangulos;
+    unsigned int objetosDibujados;
+    unsigned int objetosDescartados;
+    unsigned int llamadasGL;
+};
+
+// Modo sin ventana para medir el renderizador: se dibuja en un framebuffer propio un numero fijo
+// de frames con la camara siguiendo un recorrido fijo por la escena y se guardan los tiempos
+// de cada frame. Con el mismo recorrido y el mismo delta los resultados se pueden comparar
+// entre versiones.
+class Benchmark {
+public:
+    // --benchmark [--secuencial] [--frames N] [--calentamiento N] [--tamano ANCHOxALTO] [--salida ruta]
+    // false si algun argumento no es valido
+    static bool leerArgumentos(int argc, char** argv, ConfiguracionBenchmark& config);
+
+    explicit Benchmark(const ConfiguracionBenchmark& config);
+    ~Benchmark();
+
+    // Crear el framebuffer fuera de pantalla; false si el driver no lo acepta
+    bool inicializar();
+
+    unsigned int getFramesTotales() const { return config.framesCalentamiento + config.frames; }
+
+    // Colocar la camara en su punto del recorrido (no llama a OpenGL: el framebuffer queda
+    // enlazado desde inicializar, asi que se puede llamar desde el hilo de simulacion)
+    void prepararFrame(Camera& camera, unsigned int frame);
+
+    // Guardar un frame (los de calentamiento se descartan)
+    void registrar(const MuestraBenchmark& muestra);
+
+    // Escribir las muestras (CSV o JSON segun la extension) e imprimir el resumen
+    bool escribir() const;
+
+private:
+    Benchmark(const Benchmark&) = delete;
+    Benchmark& operator=(const Benchmark&) = delete;
+
+    ConfiguracionBenchmark config;
+    GLuint fbo;
+    GLuint colorRbo;
+    GLuint profundidadRbo;
+    std::vector<MuestraBenchmark> muestras;
+
+    bool escribirCSV() const;
+    bool escribirJSON() const;
+    void imprimirResumen() const;
+};
@@ -0,0 +1,147 @@
+#include "BufferDibujos.h"
+#include <cstdio>
+#include "CommonValues.h"
+
+namespace {
+// Capacidad inicial por seccion; se duplica si un frame tiene mas dibujos
+const unsigned int CAPACIDAD_INICIAL = 4096;
+// Multiplo de la capacidad: las secciones quedan alineadas para glBindBufferRange
+// (GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT es como mucho 256)
+const unsigned int ALINEACION_CAPACIDAD = 256;
+// Espera maxima por intento de glClientWaitSync (1 ms)
+const GLuint64 ESPERA_FENCE_NS = 1000000;
+}
+
+BufferDibujos::BufferDibujos()
+    : buffer(0), bufferIndices(0), capacidad(0), generacion(0), persistente(false), mapeado(nullptr),
+      seccion(0), cantidadFrame(0), esperas(0)
+{
+    for (unsigned int i = 0; i < SECCIONES; i++) {
+        fences[i] = 0;
+    }
+}
+
+BufferDibujos::~BufferDibujos()
+{
+    destruir();
+}
+
+void BufferDibujos::inicializar()
+{
+    persistente = GLEW_ARB_buffer_storage != 0;
+    crear(CAPACIDAD_INICIAL);
+    if (REPORTE_ESTADISTICAS) {
+        printf("[BufferDibujos] %u dibujos por frame, %s\n", capacidad,
+            persistente ? "mapeo persistente" : "glBufferSubData (sin ARB_buffer_storage)");
+    }
+}
+
+void BufferDibujos::crear(unsigned int capacidadMinima)
+{
+    capacidad = (capacidadMinima + ALINEACION_CAPACIDAD - 1) / ALINEACION_CAPACIDAD * ALINEACION_CAPACIDAD;
+    GLsizeiptr tamano = (GLsizeiptr)(sizeof(DatosDibujoGPU) * capacidad * SECCIONES);
+
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+    if (persistente) {
+        // Coherente: lo escrito antes de una llamada de dibujo ya es visible para ella
+        GLbitfield banderas = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_SHADER_STORAGE_BUFFER, tamano, nullptr, banderas);
+        mapeado = static_cast<DatosDibujoGPU*>(glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, tamano, banderas));
+    }
+    else {
+        glBufferData(GL_SHADER_STORAGE_BUFFER, tamano, nullptr, GL_STREAM_DRAW);
+        copia.resize(capacidad);
+    }
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    // El indice de cada instancia es su posicion en la seccion
+    std::vector<GLuint> indices(capacidad);
+    for (unsigned int i = 0; i < capacidad; i++) {
+        indices[i] = i;
+    }
+    glGenBuffers(1, &bufferIndices);
+    glBindBuffer(GL_ARRAY_BUFFER, bufferIndices);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(sizeof(GLuint) * capacidad), indices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // Los VAO que tenian el buffer de indices anterior lo vuelven a ligar
+    generacion++;
+}
+
+void BufferDibujos::destruir()
+{
+    // Borrar un buffer que la GPU sigue leyendo es valido: se libera cuando termina
+    for (unsigned int i = 0; i < SECCIONES; i++) {
+        if (fences[i] != 0) {
+            glDeleteSync(fences[i]);
+            fences[i] = 0;
+        }
+    }
+    if (buffer != 0) {
+        if (mapeado != nullptr) {
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+            glUnmapBuffer(GL_SHADER_STORAGE_BUFFER);
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+            mapeado = nullptr;
+        }
+        glDeleteBuffers(1, &buffer);
+        buffer = 0;
+    }
+    if (bufferIndices != 0) {
+        glDeleteBuffers(1, &bufferIndices);
+        bufferIndices = 0;
+    }
+}
+
+void BufferDibujos::esperarSeccion(unsigned int indice)
+{
+    GLsync fence = fences[indice];
+    if (fence == 0) return;
+
+    // Normalmente la GPU ya termino; si no, se espera mandando los comandos pendientes
+    GLenum resultado = glClientWaitSync(fence, 0, 0);
+    if (resultado == GL_TIMEOUT_EXPIRED) {
+        esperas++;
+        do {
+            resultado = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, ESPERA_FENCE_NS);
+        } while (resultado == GL_TIMEOUT_EXPIRED);
+    }
+    glDeleteSync(fence);
+    fences[indice] = 0;
+}
+
+DatosDibujoGPU* BufferDibujos::comenzarFrame(unsigned int cantidad)
+{
+    if (cantidad > capacidad) {
+        unsigned int nueva = capacidad;
+        while (nueva < cantidad) nueva *= 2;
+        destruir();
+        crear(nueva);
+        seccion = 0;
+    }
+
+    esperarSeccion(seccion);
+    cantidadFrame = cantidad;
+    return persistente ? mapeado + (size_t)seccion * capacidad : copia.data();
+}
+
+void BufferDibujos::enviar()
+{
+    GLintptr inicio = (GLintptr)(sizeof(DatosDibujoGPU) * seccion * capacidad);
+    GLsizeiptr tamano = (GLsizeiptr)(sizeof(DatosDibujoGPU) * (cantidadFrame > 0 ? cantidadFrame : 1));
+
+    if (!persistente && cantidadFrame > 0) {
+        // La seccion ya no la usa la GPU (su fence se espero), asi que la copia no se bloquea
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, inicio, tamano, copia.data());
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    }
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, BINDING_DIBUJOS, buffer, inicio, tamano);
+}
+
+void BufferDibujos::terminarFrame()
+{
+    fences[seccion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    seccion = (seccion + 1) % SECCIONES;
+}
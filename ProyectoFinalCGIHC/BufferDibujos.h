@@ -0,0 +1,75 @@
+#pragma once
+
+#include <vector>
+#include <glew.h>
+#include <glm.hpp>
+
+// Datos de una llamada de dibujo con la misma disposicion que DatosDibujo en
+// shader_light_dibujos.vert (std430)
+struct DatosDibujoGPU {
+    glm::mat4 model;
+    glm::mat4 normal;       // Transpuesta de la inversa de model (se usa la 3x3 superior)
+    glm::vec4 material;     // x = intensidad especular, y = brillo
+};
+
+// Buffer circular con los datos de dibujo (matrices y material) de los ultimos frames
+// Se divide en SECCIONES partes y cada frame escribe en la siguiente mientras la GPU todavia
+// puede estar leyendo las anteriores; una fence por seccion evita sobrescribir datos que
+// la GPU no ha terminado de usar. Con ARB_buffer_storage (OpenGL 4.4) el buffer queda mapeado
+// de forma persistente y se escribe directamente; sin la extension se copia con glBufferSubData.
+// El shader encuentra los datos de cada dibujo con un indice que llega como atributo por
+// instancia: el buffer de indices tiene 0, 1, 2... y la base instance de la llamada elige
+// el primero.
+class BufferDibujos {
+public:
+    BufferDibujos();
+    ~BufferDibujos();
+
+    // Binding del SSBO en los shaders (ClustersLuces usa del 1 al 3)
+    static const GLuint BINDING_DIBUJOS = 4;
+    // Frames que puede tener la GPU en cola antes de que haya que esperarla
+    static const unsigned int SECCIONES = 3;
+
+    // Crear los buffers (requiere contexto de OpenGL)
+    void inicializar();
+
+    // Espacio para los datos de cantidad dibujos del frame
+    // Si la GPU sigue leyendo la seccion se espera a que termine
+    DatosDibujoGPU* comenzarFrame(unsigned int cantidad);
+
+    // Hacer visibles los datos escritos y ligar la seccion del frame al SSBO
+    void enviar();
+
+    // Poner la fence despues de las llamadas de dibujo del frame y pasar a la siguiente seccion
+    void terminarFrame();
+
+    // Buffer de indices para el atributo por instancia; cambia de generacion al crecer
+    GLuint getBufferIndices() const { return bufferIndices; }
+    unsigned int getGeneracion() const { return generacion; }
+
+    bool esPersistente() const { return persistente; }
+
+    // Frames en los que hubo que esperar a que la GPU liberara la seccion
+    unsigned int getEsperas() const { return esperas; }
+
+private:
+    BufferDibujos(const BufferDibujos&) = delete;
+    BufferDibujos& operator=(const BufferDibujos&) = delete;
+
+    GLuint buffer;
+    GLuint bufferIndices;
+    unsigned int capacidad;         // Dibujos por seccion
+    unsigned int generacion;
+    bool persistente;
+    DatosDibujoGPU* mapeado;                // Todo el buffer, con almacenamiento persistente
+    std::vector<DatosDibujoGPU> copia;      // Datos del frame, sin almacenamiento persistente
+
+    GLsync fences[SECCIONES];
+    unsigned int seccion;
+    unsigned int cantidadFrame;
+    unsigned int esperas;
+
+    void crear(unsigned int capacidadMinima);
+    void destruir();
+    void esperarSeccion(unsigned int indice);
+};
@@ -0,0 +1,296 @@
+#include "CacheModelo.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#endif
+
+namespace {
+
+const char MAGIA[4] = { 'P', 'F', 'M', 'C' };
+
+struct CabeceraCache {
+    char magia[4];
+    uint32_t version;
+    uint64_t tamanoFuente;
+    int64_t fechaFuente;
+    uint32_t numMeshes;
+    uint32_t numTexturas;
+    uint32_t numDependencias;
+    uint32_t reservado;
+};
+
+// Sello de un archivo del que depende el cache; le sigue la ruta
+struct EntradaDependencia {
+    uint64_t tamano;
+    int64_t fecha;
+    uint32_t existe;            // Una textura que falto tambien invalida el cache si aparece
+    uint32_t longitud;
+};
+
+struct EntradaMesh {
+    uint64_t offsetVertices;
+    uint64_t offsetIndices;
+    uint32_t numVertices;       // Vertices, no flotantes
+    uint32_t numIndices;
+    uint32_t formato;           // FormatoVertice::getBits
+    uint32_t materialIndex;
+    uint32_t nivelLOD;
+    uint32_t volumenesValidos;
+    float aabbMinimo[3];
+    float aabbMaximo[3];
+    float esferaCentro[3];
+    float esferaRadio;
+};
+
+size_t alinear4(size_t valor)
+{
+    return (valor + 3) & ~static_cast<size_t>(3);
+}
+
+void escribirBytes(std::vector<unsigned char>& destino, const void* datos, size_t tamano)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(datos);
+    destino.insert(destino.end(), bytes, bytes + tamano);
+    destino.resize(alinear4(destino.size()), 0);
+}
+
+} // namespace
+
+const char* CacheModelo::CARPETA = "Cache/";
+
+CacheModelo::CacheModelo()
+{
+}
+
+std::string CacheModelo::rutaCache(const std::string& rutaModelo)
+{
+    // Un archivo por modelo, con la ruta aplanada para no crear subcarpetas
+    std::string nombre = rutaModelo;
+    for (char& c : nombre) {
+        bool valido = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                      c == '.' || c == '-' || c == '_';
+        if (!valido) c = '_';
+    }
+    return std::string(CARPETA) + nombre + ".pfmc";
+}
+
+bool CacheModelo::leerSello(const std::string& ruta, uint64_t& tamano, int64_t& fecha)
+{
+#ifdef _WIN32
+    struct _stat64 info;
+    if (_stat64(ruta.c_str(), &info) != 0) return false;
+#else
+    struct stat info;
+    if (stat(ruta.c_str(), &info) != 0) return false;
+#endif
+    tamano = static_cast<uint64_t>(info.st_size);
+    fecha = static_cast<int64_t>(info.st_mtime);
+    return true;
+}
+
+bool CacheModelo::abrir(const std::string& rutaModelo)
+{
+    cerrar();
+
+    uint64_t tamanoFuente;
+    int64_t fechaFuente;
+    if (!leerSello(rutaModelo, tamanoFuente, fechaFuente)) return false;
+    if (!archivo.abrir(rutaCache(rutaModelo))) return false;
+
+    const unsigned char* datos = archivo.getDatos();
+    size_t tamano = archivo.getTamano();
+
+    CabeceraCache cabecera;
+    if (tamano < sizeof(cabecera)) {
+        cerrar();
+        return false;
+    }
+    memcpy(&cabecera, datos, sizeof(cabecera));
+    if (memcmp(cabecera.magia, MAGIA, sizeof(MAGIA)) != 0 || cabecera.version != VERSION ||
+        cabecera.tamanoFuente != tamanoFuente || cabecera.fechaFuente != fechaFuente) {
+        cerrar();
+        return false;
+    }
+
+    size_t posicion = sizeof(cabecera);
+    if (posicion + sizeof(EntradaMesh) * static_cast<size_t>(cabecera.numMeshes) > tamano) {
+        cerrar();
+        return false;
+    }
+    const unsigned char* tablaMeshes = datos + posicion;
+    posicion += sizeof(EntradaMesh) * cabecera.numMeshes;
+
+    texturas.reserve(cabecera.numTexturas);
+    for (uint32_t i = 0; i < cabecera.numTexturas; i++) {
+        uint32_t longitud, alfa;
+        if (posicion + 2 * sizeof(uint32_t) > tamano) {
+            cerrar();
+            return false;
+        }
+        memcpy(&longitud, datos + posicion, sizeof(uint32_t));
+        memcpy(&alfa, datos + posicion + sizeof(uint32_t), sizeof(uint32_t));
+        posicion += 2 * sizeof(uint32_t);
+        if (posicion + longitud > tamano) {
+            cerrar();
+            return false;
+        }
+        texturas.push_back({ std::string(reinterpret_cast<const char*>(datos + posicion), longitud), alfa != 0 });
+        posicion = alinear4(posicion + longitud);
+    }
+
+    // Cualquier dependencia que cambio, aparecio o desaparecio deja el cache desactualizado
+    for (uint32_t i = 0; i < cabecera.numDependencias; i++) {
+        EntradaDependencia dependencia;
+        if (posicion + sizeof(dependencia) > tamano) {
+            cerrar();
+            return false;
+        }
+        memcpy(&dependencia, datos + posicion, sizeof(dependencia));
+        posicion += sizeof(dependencia);
+        if (posicion + dependencia.longitud > tamano) {
+            cerrar();
+            return false;
+        }
+        std::string ruta(reinterpret_cast<const char*>(datos + posicion), dependencia.longitud);
+        posicion = alinear4(posicion + dependencia.longitud);
+
+        uint64_t tamanoActual = 0;
+        int64_t fechaActual = 0;
+        bool existe = leerSello(ruta, tamanoActual, fechaActual);
+        if (existe != (dependencia.existe != 0) ||
+            (existe && (tamanoActual != dependencia.tamano || fechaActual != dependencia.fecha))) {
+            cerrar();
+            return false;
+        }
+    }
+
+    // La geometria no se copia: los meshes apuntan directo a la mapping
+    meshes.reserve(cabecera.numMeshes);
+    for (uint32_t i = 0; i < cabecera.numMeshes; i++) {
+        EntradaMesh entrada;
+        memcpy(&entrada, tablaMeshes + i * sizeof(EntradaMesh), sizeof(entrada));
+        MeshCache mesh;
+        MeshEmpacado& geometria = mesh.geometria;
+        geometria.numVertices = entrada.numVertices;
+        geometria.numIndices = entrada.numIndices;
+        geometria.formato = FormatoVertice::desdeBits(entrada.formato);
+        uint64_t finVertices = entrada.offsetVertices + geometria.getBytesVertices();
+        uint64_t finIndices = entrada.offsetIndices + geometria.getBytesIndices();
+        if (finVertices > tamano || finIndices > tamano ||
+            (entrada.offsetVertices & 3) != 0 || (entrada.offsetIndices & 3) != 0) {
+            cerrar();
+            return false;
+        }
+        geometria.vertices = datos + entrada.offsetVertices;
+        geometria.indices = datos + entrada.offsetIndices;
+        if (entrada.volumenesValidos != 0) {
+            geometria.aabb.minimo = glm::vec3(entrada.aabbMinimo[0], entrada.aabbMinimo[1], entrada.aabbMinimo[2]);
+            geometria.aabb.maximo = glm::vec3(entrada.aabbMaximo[0], entrada.aabbMaximo[1], entrada.aabbMaximo[2]);
+            geometria.aabb.valido = true;
+            geometria.esfera.centro = glm::vec3(entrada.esferaCentro[0], entrada.esferaCentro[1], entrada.esferaCentro[2]);
+            geometria.esfera.radio = entrada.esferaRadio;
+            geometria.esfera.valido = true;
+        }
+        mesh.materialIndex = entrada.materialIndex;
+        mesh.nivelLOD = entrada.nivelLOD;
+        meshes.push_back(mesh);
+    }
+    return true;
+}
+
+void CacheModelo::cerrar()
+{
+    meshes.clear();
+    texturas.clear();
+    archivo.cerrar();
+}
+
+bool CacheModelo::escribir(const std::string& rutaModelo,
+                           const std::vector<MeshCache>& meshes,
+                           const std::vector<TexturaCache>& texturas,
+                           const std::vector<std::string>& dependencias)
+{
+    CabeceraCache cabecera;
+    memcpy(cabecera.magia, MAGIA, sizeof(MAGIA));
+    cabecera.version = VERSION;
+    if (!leerSello(rutaModelo, cabecera.tamanoFuente, cabecera.fechaFuente)) return false;
+    cabecera.numMeshes = static_cast<uint32_t>(meshes.size());
+    cabecera.numTexturas = static_cast<uint32_t>(texturas.size());
+    cabecera.numDependencias = static_cast<uint32_t>(dependencias.size());
+    cabecera.reservado = 0;
+
+    std::vector<unsigned char> contenido;
+    escribirBytes(contenido, &cabecera, sizeof(cabecera));
+
+    // La tabla de meshes se llena al final, cuando se conocen los offsets
+    size_t posicionTabla = contenido.size();
+    contenido.resize(posicionTabla + sizeof(EntradaMesh) * meshes.size(), 0);
+
+    for (const auto& textura : texturas) {
+        uint32_t longitud = static_cast<uint32_t>(textura.ruta.size());
+        uint32_t alfa = textura.alfa ? 1 : 0;
+        escribirBytes(contenido, &longitud, sizeof(longitud));
+        escribirBytes(contenido, &alfa, sizeof(alfa));
+        escribirBytes(contenido, textura.ruta.data(), longitud);
+    }
+
+    for (const auto& ruta : dependencias) {
+        EntradaDependencia dependencia;
+        memset(&dependencia, 0, sizeof(dependencia));
+        dependencia.existe = leerSello(ruta, dependencia.tamano, dependencia.fecha) ? 1 : 0;
+        dependencia.longitud = static_cast<uint32_t>(ruta.size());
+        escribirBytes(contenido, &dependencia, sizeof(dependencia));
+        escribirBytes(contenido, ruta.data(), dependencia.longitud);
+    }
+
+    std::vector<EntradaMesh> entradas(meshes.size());
+    for (size_t i = 0; i < meshes.size(); i++) {
+        const MeshEmpacado& geometria = meshes[i].geometria;
+        EntradaMesh& entrada = entradas[i];
+        memset(&entrada, 0, sizeof(entrada));
+        entrada.numVertices = geometria.numVertices;
+        entrada.numIndices = geometria.numIndices;
+        entrada.formato = geometria.formato.getBits();
+        entrada.materialIndex = meshes[i].materialIndex;
+        entrada.nivelLOD = meshes[i].nivelLOD;
+        // La caja y la esfera salen de los vertices sin empacar; no se recalculan al leer
+        entrada.volumenesValidos = geometria.aabb.valido && geometria.esfera.valido ? 1 : 0;
+        for (int c = 0; c < 3; c++) {
+            entrada.aabbMinimo[c] = geometria.aabb.minimo[c];
+            entrada.aabbMaximo[c] = geometria.aabb.maximo[c];
+            entrada.esferaCentro[c] = geometria.esfera.centro[c];
+        }
+        entrada.esferaRadio = geometria.esfera.radio;
+        entrada.offsetVertices = contenido.size();
+        escribirBytes(contenido, geometria.vertices, geometria.getBytesVertices());
+        entrada.offsetIndices = contenido.size();
+        escribirBytes(contenido, geometria.indices, geometria.getBytesIndices());
+    }
+    if (!entradas.empty()) {
+        memcpy(contenido.data() + posicionTabla, entradas.data(), sizeof(EntradaMesh) * entradas.size());
+    }
+
+#ifdef _WIN32
+    _mkdir(CARPETA);
+#else
+    mkdir(CARPETA, 0755);
+#endif
+
+    // Se escribe a un temporal y se renombra para que nunca quede un cache a medias
+    std::string ruta = rutaCache(rutaModelo);
+    std::string temporal = ruta + ".tmp";
+    std::ofstream salida(temporal.c_str(), std::ios::binary | std::ios::trunc);
+    if (!salida.is_open()) return false;
+    salida.write(reinterpret_cast<const char*>(contenido.data()), static_cast<std::streamsize>(contenido.size()));
+    salida.close();
+    if (!salida) {
+        remove(temporal.c_str());
+        return false;
+    }
+    remove(ruta.c_str());
+    return rename(temporal.c_str(), ruta.c_str()) == 0;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <glew.h>
+#include "ArchivoMapeado.h"
+#include "Mesh.h"
+
+// Geometria de un mesh ya empacada como la sube Mesh::CreateMeshEmpacado
+struct MeshCache {
+    MeshEmpacado geometria;
+    uint32_t materialIndex;
+    uint32_t nivelLOD;          // 0 = geometria completa; los niveles siguen a su mesh base
+};
+
+// Textura ya resuelta de un material (ruta final y si se carga con alfa)
+struct TexturaCache {
+    std::string ruta;
+    bool alfa;
+};
+
+// Cache binario de un modelo importado con Assimp
+// Guarda los vertices ya en el formato compacto de la GPU, los indices (de 16 bits cuando caben),
+// los volumenes, el material y el nivel de LOD de cada mesh y las texturas resueltas para que los
+// arranques siguientes no pasen por Assimp ni vuelvan a empacar. Se invalida si cambia la version
+// del formato o el tamano/fecha de modificacion del archivo fuente o de cualquiera de sus
+// dependencias (el .mtl y las texturas que se buscaron, aunque no existieran).
+class CacheModelo {
+public:
+    static constexpr uint32_t VERSION = 5;
+
+    // Carpeta donde se guardan los caches (relativa al directorio de trabajo)
+    static const char* CARPETA;
+
+    CacheModelo();
+
+    // Mapear el cache del modelo; false si no existe, esta corrupto o esta desactualizado
+    // Los punteros de getMeshes apuntan a la mapping y son validos hasta cerrar()
+    bool abrir(const std::string& rutaModelo);
+    void cerrar();
+    bool estaAbierto() const { return archivo.estaAbierto(); }
+
+    const std::vector<MeshCache>& getMeshes() const { return meshes; }
+    const std::vector<TexturaCache>& getTexturas() const { return texturas; }
+
+    // Escribir el cache de un modelo recien importado
+    // dependencias son los demas archivos que se leyeron o buscaron al importarlo
+    static bool escribir(const std::string& rutaModelo,
+                         const std::vector<MeshCache>& meshes,
+                         const std::vector<TexturaCache>& texturas,
+                         const std::vector<std::string>& dependencias);
+
+private:
+    ArchivoMapeado archivo;
+    std::vector<MeshCache> meshes;
+    std::vector<TexturaCache> texturas;
+
+    static std::string rutaCache(const std::string& rutaModelo);
+    // Tamano y fecha de modificacion del archivo fuente
+    static bool leerSello(const std::string& ruta, uint64_t& tamano, int64_t& fecha);
+};
@@ -0,0 +1,272 @@
+#include "CacheShaders.h"
+#include "CacheModelo.h"
+#include "ReporteCarga.h"
+#include "Shader_light.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#endif
+
+namespace {
+
+const char MAGIA[4] = { 'P', 'F', 'S', 'B' };
+const uint32_t VERSION_BINARIO = 1;
+
+// Segundos entre revisiones de las fechas de los archivos
+const double INTERVALO_REVISION = 0.5;
+
+struct CabeceraBinario {
+    char magia[4];
+    uint32_t version;
+    uint64_t hashFuente;
+    uint64_t hashDriver;
+    uint32_t formato;
+    uint32_t tamano;
+};
+
+// FNV-1a de 64 bits
+uint64_t fnv1a(const void* datos, size_t tamano, uint64_t hash = 14695981039346656037ull)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(datos);
+    for (size_t i = 0; i < tamano; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+} // namespace
+
+CacheShaders& CacheShaders::instancia()
+{
+    static CacheShaders cache;
+    return cache;
+}
+
+CacheShaders::CacheShaders()
+    : recargaEnCaliente(false), ultimaRevision(0.0),
+      desdeBinario(0), compilados(0), reutilizados(0), msCarga(0.0)
+{
+}
+
+std::string CacheShaders::leerArchivo(const std::string& ruta)
+{
+    std::ifstream archivo(ruta.c_str(), std::ios::in | std::ios::binary);
+    if (!archivo.is_open()) {
+        return "";
+    }
+    // Se lee de una vez en lugar de linea por linea
+    std::ostringstream contenido;
+    contenido << archivo.rdbuf();
+    return contenido.str();
+}
+
+uint64_t CacheShaders::calcularHash(const std::string& codigoVertice, const std::string& codigoFragmento)
+{
+    // El tamano del vertex shader separa "ab" + "c" de "a" + "bc"
+    uint64_t tamanoVertice = codigoVertice.size();
+    uint64_t hash = fnv1a(&tamanoVertice, sizeof(tamanoVertice));
+    hash = fnv1a(codigoVertice.data(), codigoVertice.size(), hash);
+    return fnv1a(codigoFragmento.data(), codigoFragmento.size(), hash);
+}
+
+uint64_t CacheShaders::hashDriver()
+{
+    static uint64_t hash = 0;
+    if (hash == 0) {
+        const GLenum cadenas[3] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+        hash = fnv1a(nullptr, 0);
+        for (GLenum cadena : cadenas) {
+            const char* texto = reinterpret_cast<const char*>(glGetString(cadena));
+            if (texto != nullptr) hash = fnv1a(texto, strlen(texto), hash);
+        }
+    }
+    return hash;
+}
+
+int64_t CacheShaders::fechaModificacion(const std::string& ruta)
+{
+#ifdef _WIN32
+    struct _stat64 info;
+    if (_stat64(ruta.c_str(), &info) != 0) return 0;
+#else
+    struct stat info;
+    if (stat(ruta.c_str(), &info) != 0) return 0;
+#endif
+    return static_cast<int64_t>(info.st_mtime);
+}
+
+std::string CacheShaders::rutaBinario(uint64_t hash) const
+{
+    char nombre[32];
+    snprintf(nombre, sizeof(nombre), "%016llx.glprog", static_cast<unsigned long long>(hash));
+    return std::string(CacheModelo::CARPETA) + nombre;
+}
+
+ProgramaShader* CacheShaders::adquirir(const std::string& rutaVertice, const std::string& rutaFragmento)
+{
+    std::string codigoVertice = leerArchivo(rutaVertice);
+    std::string codigoFragmento = leerArchivo(rutaFragmento);
+    if (codigoVertice.empty() || codigoFragmento.empty()) {
+        printf("[CacheShaders] No se pudo leer %s o %s\n", rutaVertice.c_str(), rutaFragmento.c_str());
+        return nullptr;
+    }
+
+    uint64_t hash = calcularHash(codigoVertice, codigoFragmento);
+    for (auto& entrada : entradas) {
+        if (entrada->hash == hash) {
+            entrada->referencias++;
+            reutilizados++;
+            return &entrada->programa;
+        }
+    }
+
+    auto inicio = std::chrono::steady_clock::now();
+    GLuint id = crearPrograma(hash, codigoVertice, codigoFragmento);
+    msCarga += ReporteCarga::msDesde(inicio);
+    if (id == 0) return nullptr;
+
+    std::unique_ptr<Entrada> entrada(new Entrada());
+    entrada->programa.id = id;
+    entrada->hash = hash;
+    entrada->rutaVertice = rutaVertice;
+    entrada->rutaFragmento = rutaFragmento;
+    entrada->fechaVertice = fechaModificacion(rutaVertice);
+    entrada->fechaFragmento = fechaModificacion(rutaFragmento);
+    entrada->referencias = 1;
+    entradas.push_back(std::move(entrada));
+    return &entradas.back()->programa;
+}
+
+void CacheShaders::liberar(ProgramaShader* programa)
+{
+    for (size_t i = 0; i < entradas.size(); i++) {
+        if (&entradas[i]->programa != programa) continue;
+        if (--entradas[i]->referencias == 0) {
+            glDeleteProgram(programa->id);
+            entradas.erase(entradas.begin() + i);
+        }
+        return;
+    }
+}
+
+GLuint CacheShaders::crearPrograma(uint64_t hash, const std::string& codigoVertice, const std::string& codigoFragmento)
+{
+    GLuint programa = cargarBinario(hash);
+    if (programa != 0) {
+        desdeBinario++;
+        return programa;
+    }
+
+    programa = Shader::EnlazarPrograma(codigoVertice.c_str(), codigoFragmento.c_str(), true);
+    if (programa != 0) {
+        compilados++;
+        guardarBinario(hash, programa);
+    }
+    return programa;
+}
+
+GLuint CacheShaders::cargarBinario(uint64_t hash)
+{
+    std::string contenido = leerArchivo(rutaBinario(hash));
+    CabeceraBinario cabecera;
+    if (contenido.size() < sizeof(cabecera)) return 0;
+    memcpy(&cabecera, contenido.data(), sizeof(cabecera));
+    if (memcmp(cabecera.magia, MAGIA, sizeof(MAGIA)) != 0 || cabecera.version != VERSION_BINARIO ||
+        cabecera.hashFuente != hash || cabecera.hashDriver != hashDriver() ||
+        contenido.size() < sizeof(cabecera) + cabecera.tamano) {
+        return 0;
+    }
+
+    GLuint programa = glCreateProgram();
+    glProgramBinary(programa, cabecera.formato, contenido.data() + sizeof(cabecera), cabecera.tamano);
+    GLint enlazado = 0;
+    glGetProgramiv(programa, GL_LINK_STATUS, &enlazado);
+    if (!enlazado) {
+        // El driver puede rechazar el binario aunque el hash coincida; se compila de nuevo
+        glDeleteProgram(programa);
+        return 0;
+    }
+    return programa;
+}
+
+void CacheShaders::guardarBinario(uint64_t hash, GLuint programa)
+{
+    GLint formatos = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatos);
+    if (formatos == 0) return;
+
+    GLint tamano = 0;
+    glGetProgramiv(programa, GL_PROGRAM_BINARY_LENGTH, &tamano);
+    if (tamano <= 0) return;
+
+    std::vector<char> binario(tamano);
+    GLenum formato = 0;
+    GLsizei escritos = 0;
+    glGetProgramBinary(programa, tamano, &escritos, &formato, binario.data());
+    if (escritos <= 0) return;
+
+    CabeceraBinario cabecera;
+    memcpy(cabecera.magia, MAGIA, sizeof(MAGIA));
+    cabecera.version = VERSION_BINARIO;
+    cabecera.hashFuente = hash;
+    cabecera.hashDriver = hashDriver();
+    cabecera.formato = formato;
+    cabecera.tamano = static_cast<uint32_t>(escritos);
+
+#ifdef _WIN32
+    _mkdir(CacheModelo::CARPETA);
+#else
+    mkdir(CacheModelo::CARPETA, 0755);
+#endif
+    std::ofstream salida(rutaBinario(hash).c_str(), std::ios::binary | std::ios::trunc);
+    if (!salida.is_open()) return;
+    salida.write(reinterpret_cast<const char*>(&cabecera), sizeof(cabecera));
+    salida.write(binario.data(), escritos);
+}
+
+void CacheShaders::revisarCambios(double ahora)
+{
+    if (!recargaEnCaliente || ahora - ultimaRevision < INTERVALO_REVISION) return;
+    ultimaRevision = ahora;
+
+    for (auto& entrada : entradas) {
+        int64_t fechaVertice = fechaModificacion(entrada->rutaVertice);
+        int64_t fechaFragmento = fechaModificacion(entrada->rutaFragmento);
+        if (fechaVertice == entrada->fechaVertice && fechaFragmento == entrada->fechaFragmento) continue;
+        entrada->fechaVertice = fechaVertice;
+        entrada->fechaFragmento = fechaFragmento;
+
+        std::string codigoVertice = leerArchivo(entrada->rutaVertice);
+        std::string codigoFragmento = leerArchivo(entrada->rutaFragmento);
+        uint64_t hash = calcularHash(codigoVertice, codigoFragmento);
+        if (hash == entrada->hash) continue;
+
+        GLuint nuevo = Shader::EnlazarPrograma(codigoVertice.c_str(), codigoFragmento.c_str(), true);
+        if (nuevo == 0) {
+            printf("[CacheShaders] %s + %s no compila, se conserva el programa anterior\n",
+                entrada->rutaVertice.c_str(), entrada->rutaFragmento.c_str());
+            continue;
+        }
+
+        // Los Shader ven el cambio de version y vuelven a leer sus uniforms
+        glDeleteProgram(entrada->programa.id);
+        entrada->programa.id = nuevo;
+        entrada->programa.version++;
+        entrada->hash = hash;
+        guardarBinario(hash, nuevo);
+        printf("[CacheShaders] Recargado %s + %s\n", entrada->rutaVertice.c_str(), entrada->rutaFragmento.c_str());
+    }
+}
+
+void CacheShaders::imprimirReporte() const
+{
+    printf("[CacheShaders] Programas: %u desde binario, %u compilados, %u reutilizados (%.2f ms)\n",
+        desdeBinario, compilados, reutilizados, msCarga);
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <glew.h>
+
+// Programa enlazado que comparten los Shader con el mismo codigo fuente
+struct ProgramaShader {
+    GLuint id;
+    unsigned int version;       // Sube cada vez que el programa se recarga en caliente
+
+    ProgramaShader() : id(0), version(0) {}
+};
+
+// Cache de programas de shaders compartido por todos los Shader
+// Los programas se identifican por el hash de su codigo, asi que dos Shader que cargan los
+// mismos archivos (por ejemplo cada Skybox) usan un solo programa. Los binarios enlazados se
+// guardan en Cache/ con glGetProgramBinary y en los arranques siguientes se cargan con
+// glProgramBinary; si el driver cambio o el binario no sirve se compila desde el codigo.
+// Todo se llama desde el hilo de OpenGL.
+class CacheShaders {
+public:
+    static CacheShaders& instancia();
+
+    // Programa de un par de archivos; cuenta una referencia. nullptr si no compila
+    ProgramaShader* adquirir(const std::string& rutaVertice, const std::string& rutaFragmento);
+
+    // Soltar una referencia; el programa se borra al llegar a cero
+    void liberar(ProgramaShader* programa);
+
+    // Con la recarga activa se revisan las fechas de los archivos cada medio segundo y se
+    // recompilan los programas que cambiaron (si no compilan se conserva el anterior)
+    void setRecargaEnCaliente(bool activa) { recargaEnCaliente = activa; }
+    void revisarCambios(double ahora);
+
+    // Cuantos programas salieron del binario guardado, cuantos se compilaron y cuantos se reutilizaron
+    void imprimirReporte() const;
+
+    // Lee el archivo completo ("" si no existe)
+    static std::string leerArchivo(const std::string& ruta);
+
+private:
+    CacheShaders();
+    CacheShaders(const CacheShaders&) = delete;
+    CacheShaders& operator=(const CacheShaders&) = delete;
+
+    struct Entrada {
+        ProgramaShader programa;
+        uint64_t hash;
+        std::string rutaVertice;
+        std::string rutaFragmento;
+        int64_t fechaVertice;
+        int64_t fechaFragmento;
+        unsigned int referencias;
+    };
+
+    std::vector<std::unique_ptr<Entrada>> entradas;
+    bool recargaEnCaliente;
+    double ultimaRevision;
+    unsigned int desdeBinario;
+    unsigned int compilados;
+    unsigned int reutilizados;
+    double msCarga;
+
+    // Crear el programa desde el binario guardado o compilandolo
+    GLuint crearPrograma(uint64_t hash, const std::string& codigoVertice, const std::string& codigoFragmento);
+    GLuint cargarBinario(uint64_t hash);
+    void guardarBinario(uint64_t hash, GLuint programa);
+    std::string rutaBinario(uint64_t hash) const;
+
+    static uint64_t calcularHash(const std::string& codigoVertice, const std::string& codigoFragmento);
+    // Hash del fabricante, GPU y version del driver: un binario solo sirve en el mismo driver
+    static uint64_t hashDriver();
+    static int64_t fechaModificacion(const std::string& ruta);
+};
@@ -0,0 +1,128 @@
+#include "CacheTexturas.h"
+#include "ReporteCarga.h"
+#include <cctype>
+#include <cstdio>
+
+CacheTexturas& CacheTexturas::instancia()
+{
+    static CacheTexturas cache;
+    return cache;
+}
+
+std::string CacheTexturas::normalizarRuta(const std::string& ruta)
+{
+    std::string normalizada;
+    normalizada.reserve(ruta.size());
+    for (size_t i = 0; i < ruta.size(); i++) {
+        char c = ruta[i] == '\\' ? '/' : ruta[i];
+        if (c == '/') {
+            // Se quitan las barras repetidas y los segmentos "./"
+            if (!normalizada.empty() && normalizada.back() == '/') continue;
+            if (normalizada == "." || (normalizada.size() >= 2 && normalizada.compare(normalizada.size() - 2, 2, "/.") == 0)) {
+                normalizada.pop_back();
+                continue;
+            }
+        }
+        normalizada.push_back(static_cast<char>(tolower(static_cast<unsigned char>(c))));
+    }
+    return normalizada;
+}
+
+Texture* CacheTexturas::adquirir(const std::string& ruta, bool alfa)
+{
+    // La misma imagen con y sin alfa son texturas distintas en la GPU
+    std::string clave = normalizarRuta(ruta) + (alfa ? "#rgba" : "#rgb");
+
+    Entrada* entrada;
+    {
+        std::lock_guard<std::mutex> lock(mutexEntradas);
+        auto it = entradas.find(clave);
+        if (it == entradas.end()) {
+            std::unique_ptr<Entrada> nueva(new Entrada());
+            nueva->textura.reset(new Texture(ruta.c_str()));
+            clavesPorTextura[nueva->textura.get()] = clave;
+            it = entradas.emplace(clave, std::move(nueva)).first;
+        }
+        else {
+            it->second->aciertos++;
+        }
+        entrada = it->second.get();
+        entrada->referencias++;
+    }
+
+    // La referencia mantiene viva la entrada mientras se decodifica
+    std::call_once(entrada->decodificacion, [entrada, alfa]() {
+        auto inicio = std::chrono::steady_clock::now();
+        entrada->valida = entrada->textura->DecodificarTextura(alfa);
+        entrada->msDecodificar = ReporteCarga::msDesde(inicio);
+    });
+
+    if (!entrada->valida) {
+        soltarReferencia(clave);
+        return nullptr;
+    }
+    return entrada->textura.get();
+}
+
+void CacheTexturas::subir(Texture* textura)
+{
+    if (textura == nullptr) return;
+
+    std::lock_guard<std::mutex> lock(mutexEntradas);
+    auto it = clavesPorTextura.find(textura);
+    if (it == clavesPorTextura.end()) return;
+
+    Entrada& entrada = *entradas[it->second];
+    if (entrada.subida) return;
+    textura->SubirTextura();
+    entrada.subida = true;
+    entrada.bytesVideo = textura->GetBytesVideo();
+}
+
+void CacheTexturas::liberar(Texture* textura)
+{
+    if (textura == nullptr) return;
+
+    std::string clave;
+    {
+        std::lock_guard<std::mutex> lock(mutexEntradas);
+        auto it = clavesPorTextura.find(textura);
+        if (it == clavesPorTextura.end()) return;
+        clave = it->second;
+    }
+    soltarReferencia(clave);
+}
+
+void CacheTexturas::soltarReferencia(const std::string& clave)
+{
+    std::unique_ptr<Entrada> descartada;
+    {
+        std::lock_guard<std::mutex> lock(mutexEntradas);
+        auto it = entradas.find(clave);
+        if (it == entradas.end()) return;
+        if (--it->second->referencias > 0) return;
+        clavesPorTextura.erase(it->second->textura.get());
+        descartada = std::move(it->second);
+        entradas.erase(it);
+    }
+    // El destructor de la textura llama a OpenGL, fuera del candado
+}
+
+void CacheTexturas::imprimirReporte() const
+{
+    std::lock_guard<std::mutex> lock(mutexEntradas);
+    unsigned int aciertos = 0;
+    size_t bytesUnicos = 0;
+    size_t bytesAhorrados = 0;
+    double msAhorrados = 0.0;
+    for (const auto& par : entradas) {
+        const Entrada& entrada = *par.second;
+        aciertos += entrada.aciertos;
+        bytesUnicos += entrada.bytesVideo;
+        bytesAhorrados += entrada.bytesVideo * entrada.aciertos;
+        msAhorrados += entrada.msDecodificar * entrada.aciertos;
+    }
+    printf("[CacheTexturas] %u texturas unicas (%.2f MB de video), %u reutilizadas: ahorro de %.2f MB y %.2f ms de decodificacion\n",
+           static_cast<unsigned int>(entradas.size()), bytesUnicos / (1024.0 * 1024.0), aciertos,
+           bytesAhorrados / (1024.0 * 1024.0), msAhorrados);
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <string>
+#include <map>
+#include <mutex>
+#include <memory>
+#include "Texture.h"
+
+// Cache de texturas compartido por el TextureManager y todos los modelos
+// Cada archivo se decodifica y se sube a la GPU una sola vez; las texturas llevan
+// cuenta de referencias y se liberan cuando nadie las usa
+class CacheTexturas {
+public:
+    static CacheTexturas& instancia();
+
+    // Obtener la textura de una ruta decodificada (se puede llamar desde hilos de carga)
+    // Cuenta una referencia; nullptr si no se pudo decodificar (sin referencia)
+    Texture* adquirir(const std::string& ruta, bool alfa);
+
+    // Subir la textura a la GPU si aun no se subio (solo en el hilo de OpenGL)
+    void subir(Texture* textura);
+
+    // Soltar una referencia; la textura se borra al llegar a cero (hilo de OpenGL)
+    void liberar(Texture* textura);
+
+    // Imprimir cuantas decodificaciones y cuanta memoria de video se ahorraron
+    void imprimirReporte() const;
+
+    // Clave del cache: separadores unificados, sin "./" ni "//" y en minusculas
+    static std::string normalizarRuta(const std::string& ruta);
+
+private:
+    CacheTexturas() {}
+    CacheTexturas(const CacheTexturas&) = delete;
+    CacheTexturas& operator=(const CacheTexturas&) = delete;
+
+    struct Entrada {
+        std::unique_ptr<Texture> textura;
+        std::once_flag decodificacion;  // El primer hilo decodifica, los demas esperan
+        bool valida;
+        bool subida;
+        unsigned int referencias;
+        unsigned int aciertos;          // Veces que se reutilizo en vez de cargarse otra vez
+        double msDecodificar;
+        size_t bytesVideo;              // Incluye los mipmaps
+
+        Entrada() : valida(false), subida(false), referencias(0), aciertos(0), msDecodificar(0.0), bytesVideo(0) {}
+    };
+
+    void soltarReferencia(const std::string& clave);
+
+    std::map<std::string, std::unique_ptr<Entrada>> entradas;
+    std::map<Texture*, std::string> clavesPorTextura;
+    mutable std::mutex mutexEntradas;
+};
@@ -432,6 +432,22 @@ glm::mat4 Camera::calculateViewMatrix()
 	return glm::lookAt(position, position + front, up);
 }
 
+void Camera::interpolateFrom(const Camera& previous, GLfloat alpha)
+{
+	position = glm::mix(previous.position, position, alpha);
+
+	// Si la dirección se invirtió de golpe la mezcla casi se anula y se usa la actual
+	glm::vec3 mezcla = glm::mix(previous.front, front, alpha);
+	if (glm::length(mezcla) > 0.001f) {
+		front = glm::normalize(mezcla);
+	}
+	right = glm::normalize(glm::cross(front, worldUp));
+	up = glm::normalize(glm::cross(right, front));
+
+	thirdPersonMode = false;
+	aerialViewMode = false;
+}
+
 glm::vec3 Camera::getCameraPosition()
 {
 	return position;
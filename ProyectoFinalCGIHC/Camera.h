@@ -24,6 +24,10 @@ public:
 	glm::vec3 getCameraDirection();
 	glm::mat4 calculateViewMatrix();
 
+	// Mezclar con la cmara del tick anterior para dibujar entre dos ticks (alpha en [0, 1])
+	// La copia queda en modo libre para que calculateViewMatrix no la vuelva a colocar
+	void interpolateFrom(const Camera& previous, GLfloat alpha);
+
 	// Mtodos para tercera persona
 	void setThirdPersonMode(bool enable);
 	void setThirdPersonTarget(Entidad* target);
@@ -42,6 +46,9 @@ public:
 	void setFreeCameraMode(bool enable);
 	bool isFreeCameraMode() const;
 
+	// Colocar la cmara libre en una posicin y orientacin (teclas H/J/K/L y benchmark)
+	void teleportToLocation(glm::vec3 position, GLfloat yaw, GLfloat pitch);
+
 	~Camera();
 
 private:
@@ -106,6 +113,5 @@ private:
 	void saveCurrentState();
 	void restoreState();
 	void moveThirdPersonTarget(bool* keys, GLfloat deltaTime);
-	void teleportToLocation(glm::vec3 position, GLfloat yaw, GLfloat pitch);
 };
 
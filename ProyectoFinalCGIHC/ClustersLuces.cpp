@@ -0,0 +1,225 @@
+#include "ClustersLuces.h"
+#include <cmath>
+#include <algorithm>
+
+ClustersLuces::ClustersLuces()
+    : bufferParametros(0), bufferLuces(0), bufferClusters(0), bufferIndices(0),
+      capacidadLuces(0), capacidadIndices(0), proyeccionCajas(0.0f),
+      cerca(0.1f), lejos(1000.0f), maxLucesEnCluster(0)
+{
+}
+
+ClustersLuces::~ClustersLuces()
+{
+    if (bufferParametros != 0) glDeleteBuffers(1, &bufferParametros);
+    if (bufferLuces != 0) glDeleteBuffers(1, &bufferLuces);
+    if (bufferClusters != 0) glDeleteBuffers(1, &bufferClusters);
+    if (bufferIndices != 0) glDeleteBuffers(1, &bufferIndices);
+}
+
+void ClustersLuces::inicializar()
+{
+    glGenBuffers(1, &bufferParametros);
+    glGenBuffers(1, &bufferLuces);
+    glGenBuffers(1, &bufferClusters);
+    glGenBuffers(1, &bufferIndices);
+
+    // La tabla de clusters siempre tiene el mismo tamano
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, bufferClusters);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(glm::uvec2) * CLUSTERS_X * CLUSTERS_Y * CLUSTERS_Z, nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    glBindBuffer(GL_UNIFORM_BUFFER, bufferParametros);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(ParametrosClusters), nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    rangos.resize(CLUSTERS_X * CLUSTERS_Y * CLUSTERS_Z);
+}
+
+void ClustersLuces::construirCajas(const glm::mat4& projection)
+{
+    // Planos cercano y lejano a partir de la matriz de perspectiva
+    cerca = projection[3][2] / (projection[2][2] - 1.0f);
+    lejos = projection[3][2] / (projection[2][2] + 1.0f);
+
+    glm::mat4 inversa = glm::inverse(projection);
+    cajasClusters.assign(CLUSTERS_X * CLUSTERS_Y * CLUSTERS_Z, AABB());
+
+    for (unsigned int z = 0; z < CLUSTERS_Z; z++) {
+        // Rebanadas exponenciales: cerca de la camara son delgadas, a lo lejos gruesas
+        float zCerca = cerca * powf(lejos / cerca, (float)z / CLUSTERS_Z);
+        float zLejos = cerca * powf(lejos / cerca, (float)(z + 1) / CLUSTERS_Z);
+
+        for (unsigned int y = 0; y < CLUSTERS_Y; y++) {
+            for (unsigned int x = 0; x < CLUSTERS_X; x++) {
+                AABB& caja = cajasClusters[(z * CLUSTERS_Y + y) * CLUSTERS_X + x];
+
+                // Esquinas del tile en NDC proyectadas al plano cercano y llevadas a cada rebanada
+                for (int esquina = 0; esquina < 4; esquina++) {
+                    float ndcX = -1.0f + 2.0f * (float)(x + (esquina & 1)) / CLUSTERS_X;
+                    float ndcY = -1.0f + 2.0f * (float)(y + (esquina >> 1)) / CLUSTERS_Y;
+                    glm::vec4 punto = inversa * glm::vec4(ndcX, ndcY, -1.0f, 1.0f);
+                    glm::vec3 rayo = glm::vec3(punto) / punto.w;
+
+                    caja.expandir(rayo * (zCerca / -rayo.z));
+                    caja.expandir(rayo * (zLejos / -rayo.z));
+                }
+            }
+        }
+    }
+
+    proyeccionCajas = projection;
+}
+
+void ClustersLuces::agregarLuz(const PointLight& luz, const glm::vec3& direccion, float borde)
+{
+    // Radio donde la luz ya aporta menos que el umbral: exp*d^2 + lin*d + con = intensidad / umbral
+    float intensidad = (luz.GetAmbientIntensity() + luz.GetDiffuseIntensity()) *
+                       glm::max(luz.GetColor().r, glm::max(luz.GetColor().g, luz.GetColor().b));
+    float objetivo = intensidad / UMBRAL_INTENSIDAD - luz.GetConstant();
+    float radio = lejos;
+    if (objetivo <= 0.0f) {
+        return;
+    }
+    if (luz.GetExponent() > 0.0f) {
+        float a = luz.GetExponent(), b = luz.GetLinear();
+        radio = (-b + sqrtf(b * b + 4.0f * a * objetivo)) / (2.0f * a);
+    }
+    else if (luz.GetLinear() > 0.0f) {
+        radio = objetivo / luz.GetLinear();
+    }
+    radio = glm::min(radio, lejos);
+
+    LuzGPU datos;
+    datos.colorAmbiente = glm::vec4(luz.GetColor(), luz.GetAmbientIntensity());
+    datos.posicionDifusa = glm::vec4(luz.GetPosition(), luz.GetDiffuseIntensity());
+    datos.atenuacion = glm::vec4(luz.GetConstant(), luz.GetLinear(), luz.GetExponent(), radio);
+    datos.direccionBorde = glm::vec4(direccion, borde);
+    luces.push_back(datos);
+}
+
+void ClustersLuces::actualizar(const glm::mat4& view, const glm::mat4& projection,
+                               const PointLight* pointLights, unsigned int pointLightCount,
+                               const SpotLight* spotLights, unsigned int spotLightCount)
+{
+    if (projection != proyeccionCajas) {
+        construirCajas(projection);
+    }
+
+    luces.clear();
+    for (unsigned int i = 0; pointLights != nullptr && i < pointLightCount; i++) {
+        agregarLuz(pointLights[i], glm::vec3(0.0f), -2.0f);
+    }
+    for (unsigned int i = 0; spotLights != nullptr && i < spotLightCount; i++) {
+        agregarLuz(spotLights[i], spotLights[i].GetDirection(), spotLights[i].GetProcEdge());
+    }
+
+    // Las luces cercanas primero para que el limite por cluster descarte las lejanas
+    glm::vec3 posicionCamara = glm::vec3(glm::inverse(view)[3]);
+    std::sort(luces.begin(), luces.end(), [&posicionCamara](const LuzGPU& a, const LuzGPU& b) {
+        glm::vec3 da = glm::vec3(a.posicionDifusa) - posicionCamara;
+        glm::vec3 db = glm::vec3(b.posicionDifusa) - posicionCamara;
+        return glm::dot(da, da) < glm::dot(db, db);
+    });
+
+    esferasVista.resize(luces.size());
+    for (size_t i = 0; i < luces.size(); i++) {
+        glm::vec3 centro = glm::vec3(view * glm::vec4(glm::vec3(luces[i].posicionDifusa), 1.0f));
+        esferasVista[i] = glm::vec4(centro, luces[i].atenuacion.w);
+    }
+
+    asignarLuces();
+
+    // Subir los datos del frame
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    float logProfundidad = logf(lejos / cerca);
+
+    ParametrosClusters parametros;
+    parametros.dimensiones = glm::uvec4(CLUSTERS_X, CLUSTERS_Y, CLUSTERS_Z, 0);
+    parametros.tamanoTile = glm::vec4((float)viewport[2] / CLUSTERS_X, (float)viewport[3] / CLUSTERS_Y,
+                                      CLUSTERS_Z / logProfundidad, CLUSTERS_Z * logf(cerca) / logProfundidad);
+    parametros.planos = glm::vec4(cerca, lejos, 0.0f, 0.0f);
+
+    glBindBuffer(GL_UNIFORM_BUFFER, bufferParametros);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(ParametrosClusters), &parametros);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, bufferClusters);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(glm::uvec2) * rangos.size(), rangos.data());
+
+    subirBuffer(GL_SHADER_STORAGE_BUFFER, bufferLuces, sizeof(LuzGPU) * luces.size(), luces.data(), &capacidadLuces);
+    subirBuffer(GL_SHADER_STORAGE_BUFFER, bufferIndices, sizeof(uint32_t) * indices.size(), indices.data(), &capacidadIndices);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    glBindBufferBase(GL_UNIFORM_BUFFER, BINDING_PARAMETROS, bufferParametros);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, BINDING_LUCES, bufferLuces);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, BINDING_CLUSTERS, bufferClusters);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, BINDING_INDICES, bufferIndices);
+}
+
+void ClustersLuces::asignarLuces()
+{
+    parClusterLuz.clear();
+
+    for (size_t l = 0; l < esferasVista.size(); l++) {
+        glm::vec3 centro(esferasVista[l]);
+        float radio = esferasVista[l].w;
+
+        // Profundidad en vista (positiva hacia adelante); las luces detras de la camara se saltan
+        float zMin = -centro.z - radio;
+        float zMax = -centro.z + radio;
+        if (zMax < cerca || zMin > lejos) continue;
+
+        // Solo se recorren las rebanadas que cubre la esfera
+        float logProfundidad = logf(lejos / cerca);
+        int rebanadaMin = zMin <= cerca ? 0 : (int)(logf(zMin / cerca) / logProfundidad * CLUSTERS_Z);
+        int rebanadaMax = zMax >= lejos ? (int)CLUSTERS_Z - 1 : (int)(logf(zMax / cerca) / logProfundidad * CLUSTERS_Z);
+        rebanadaMin = glm::clamp(rebanadaMin, 0, (int)CLUSTERS_Z - 1);
+        rebanadaMax = glm::clamp(rebanadaMax, 0, (int)CLUSTERS_Z - 1);
+
+        for (int z = rebanadaMin; z <= rebanadaMax; z++) {
+            for (unsigned int c = 0; c < CLUSTERS_X * CLUSTERS_Y; c++) {
+                unsigned int cluster = z * CLUSTERS_X * CLUSTERS_Y + c;
+                const AABB& caja = cajasClusters[cluster];
+
+                // Distancia de la esfera al punto mas cercano de la caja
+                glm::vec3 cercano = glm::clamp(centro, caja.minimo, caja.maximo);
+                glm::vec3 d = cercano - centro;
+                if (glm::dot(d, d) <= radio * radio) {
+                    parClusterLuz.push_back((cluster << 16) | (uint32_t)l);
+                }
+            }
+        }
+    }
+
+    // Ordenar por cluster conserva el orden por distancia dentro de cada cluster
+    std::sort(parClusterLuz.begin(), parClusterLuz.end());
+
+    std::fill(rangos.begin(), rangos.end(), glm::uvec2(0));
+    indices.clear();
+    maxLucesEnCluster = 0;
+    for (uint32_t par : parClusterLuz) {
+        uint32_t cluster = par >> 16;
+        glm::uvec2& rango = rangos[cluster];
+        if (rango.y == 0) rango.x = (uint32_t)indices.size();
+        if (rango.y >= MAX_LUCES_POR_CLUSTER) continue;
+        indices.push_back(par & 0xFFFF);
+        rango.y++;
+        maxLucesEnCluster = glm::max(maxLucesEnCluster, rango.y);
+    }
+}
+
+void ClustersLuces::subirBuffer(GLenum objetivo, GLuint buffer, GLsizeiptr tamano, const void* datos, GLsizeiptr* capacidad)
+{
+    glBindBuffer(objetivo, buffer);
+    // Un SSBO sin almacenamiento no se puede ligar, por eso la capacidad minima no es cero
+    if (tamano > *capacidad || *capacidad == 0) {
+        *capacidad = glm::max(tamano * 2, (GLsizeiptr)sizeof(LuzGPU));
+    }
+    // Se descarta el contenido anterior para no esperar a que la GPU termine de leerlo
+    glBufferData(objetivo, *capacidad, nullptr, GL_STREAM_DRAW);
+    if (tamano > 0) {
+        glBufferSubData(objetivo, 0, tamano, datos);
+    }
+}
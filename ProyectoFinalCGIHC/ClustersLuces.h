@@ -0,0 +1,91 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <glew.h>
+#include <glm.hpp>
+#include "PointLight.h"
+#include "SpotLight.h"
+#include "VolumenEnvolvente.h"
+
+// Luz puntual o spot tal como la lee shader_light.frag (std430, 4 vec4)
+struct LuzGPU {
+    glm::vec4 colorAmbiente;    // rgb = color, a = intensidad ambiental
+    glm::vec4 posicionDifusa;   // xyz = posicion, w = intensidad difusa
+    glm::vec4 atenuacion;       // constante, lineal, exponencial, radio de influencia
+    glm::vec4 direccionBorde;   // xyz = direccion del spot, w = coseno del borde (< -1 = luz puntual)
+};
+
+// Iluminacion forward por clusters: el volumen de vision se divide en celdas (tiles en pantalla
+// por rebanadas exponenciales de profundidad) y cada frame se asignan en CPU las luces que tocan
+// cada celda. El fragment shader solo recorre la lista de su cluster
+class ClustersLuces {
+public:
+    ClustersLuces();
+    ~ClustersLuces();
+
+    // Dimensiones de la rejilla de clusters
+    static const unsigned int CLUSTERS_X = 16;
+    static const unsigned int CLUSTERS_Y = 9;
+    static const unsigned int CLUSTERS_Z = 24;
+
+    // Limite de luces por cluster (se conservan las mas cercanas a la camara)
+    static const unsigned int MAX_LUCES_POR_CLUSTER = 64;
+
+    // Intensidad a partir de la cual una luz ya no se considera en un cluster
+    static constexpr float UMBRAL_INTENSIDAD = 0.01f;
+
+    // Bindings fijos que declara shader_light.frag
+    static const GLuint BINDING_PARAMETROS = 0;     // UBO
+    static const GLuint BINDING_LUCES = 1;          // SSBO
+    static const GLuint BINDING_CLUSTERS = 2;       // SSBO
+    static const GLuint BINDING_INDICES = 3;        // SSBO
+
+    // Crear los buffers (requiere contexto de OpenGL)
+    void inicializar();
+
+    // Asignar las luces a los clusters del frame, subir los buffers y ligarlos
+    void actualizar(const glm::mat4& view, const glm::mat4& projection,
+                    const PointLight* pointLights, unsigned int pointLightCount,
+                    const SpotLight* spotLights, unsigned int spotLightCount);
+
+    // Estadisticas del ultimo frame
+    unsigned int getNumLuces() const { return static_cast<unsigned int>(luces.size()); }
+    unsigned int getMaxLucesEnCluster() const { return maxLucesEnCluster; }
+    unsigned int getAsignaciones() const { return static_cast<unsigned int>(indices.size()); }
+
+private:
+    // Parametros de la rejilla (std140)
+    struct ParametrosClusters {
+        glm::uvec4 dimensiones;     // clusters en x, y, z
+        glm::vec4 tamanoTile;       // ancho y alto del tile en pixeles, escala y sesgo de la rebanada
+        glm::vec4 planos;           // cerca, lejos
+    };
+
+    GLuint bufferParametros;
+    GLuint bufferLuces;
+    GLuint bufferClusters;
+    GLuint bufferIndices;
+    GLsizeiptr capacidadLuces;
+    GLsizeiptr capacidadIndices;
+
+    // Cajas de los clusters en espacio de vista; solo cambian con la proyeccion
+    std::vector<AABB> cajasClusters;
+    glm::mat4 proyeccionCajas;
+    float cerca;
+    float lejos;
+
+    std::vector<LuzGPU> luces;
+    std::vector<glm::vec4> esferasVista;        // Centro en espacio de vista y radio
+    std::vector<uint32_t> parClusterLuz;        // (cluster << 16) | luz, antes de ordenar
+    std::vector<glm::uvec2> rangos;             // Inicio y numero de luces de cada cluster
+    std::vector<uint32_t> indices;
+    unsigned int maxLucesEnCluster;
+
+    void construirCajas(const glm::mat4& projection);
+    void agregarLuz(const PointLight& luz, const glm::vec3& direccion, float borde);
+    void asignarLuces();
+
+    // Subir datos a un buffer reasignandolo si no cabe
+    static void subirBuffer(GLenum objetivo, GLuint buffer, GLsizeiptr tamano, const void* datos, GLsizeiptr* capacidad);
+};
@@ -0,0 +1,59 @@
+#include "ColaRender.h"
+#include <algorithm>
+#include <cstring>
+
+ColaRender::ColaRender()
+{
+}
+
+ColaRender::~ColaRender()
+{
+}
+
+void ColaRender::limpiar()
+{
+    elementos.clear();
+}
+
+unsigned int ColaRender::obtenerIdMaterial(Material* material)
+{
+    auto it = idsMateriales.find(material);
+    if (it != idsMateriales.end()) {
+        return it->second;
+    }
+    unsigned int id = static_cast<unsigned int>(idsMateriales.size()) + 1;
+    idsMateriales[material] = id;
+    return id;
+}
+
+void ColaRender::agregar(Mesh* mesh, Texture* textura, Material* material, int nodo, float profundidad)
+{
+    if (mesh == nullptr) return;
+
+    ElementoRender elemento;
+    if (textura != nullptr && textura->TieneTransparencia()) {
+        // Los bits de un float positivo crecen con su valor; invertidos, lo mas lejano queda primero
+        float distancia = profundidad > 0.0f ? profundidad : 0.0f;
+        uint32_t bits;
+        memcpy(&bits, &distancia, sizeof(bits));
+        elemento.clave = BIT_TRANSLUCIDO | static_cast<uint64_t>(~bits);
+    }
+    else {
+        uint64_t idTextura = textura != nullptr ? textura->GetTextureID() : 0;
+        uint64_t idMesh = mesh->GetVAO();
+        uint64_t idMaterial = obtenerIdMaterial(material);
+        elemento.clave = ((idTextura & 0x7FFFFF) << 40) | ((idMesh & 0xFFFFFF) << 16) | (idMaterial & 0xFFFF);
+    }
+    elemento.mesh = mesh;
+    elemento.textura = textura;
+    elemento.material = material;
+    elemento.nodo = nodo;
+    elementos.push_back(elemento);
+}
+
+void ColaRender::ordenar()
+{
+    // Orden estable para que los elementos con el mismo estado respeten el orden de la escena
+    std::stable_sort(elementos.begin(), elementos.end(),
+        [](const ElementoRender& a, const ElementoRender& b) { return a.clave < b.clave; });
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+#include <map>
+#include <cstdint>
+#include "Mesh.h"
+#include "Texture.h"
+#include "Material.h"
+
+// Una llamada de dibujo pendiente: un mesh con su estado y la matriz del nodo
+struct ElementoRender {
+    uint64_t clave;         // Estado empaquetado para ordenar
+    Mesh* mesh;
+    Texture* textura;       // nullptr = se conserva la textura que este ligada
+    Material* material;
+    int nodo;               // Handle del nodo en el SceneGraph (matriz mundial), -1 = lote estatico
+};
+
+// Contadores por frame de la cola de render
+struct EstadisticasRender {
+    unsigned int llamadasDibujo;
+    unsigned int cambiosTextura;
+    unsigned int cambiosMesh;
+    unsigned int cambiosMatriz;         // Matrices de nodo distintas escritas en el buffer de dibujos
+    unsigned int lotesInstanciados;     // Llamadas que dibujan mas de un elemento
+    unsigned int instanciasDibujadas;   // Elementos de la cola dibujados en esas llamadas
+    unsigned int triangulos;            // Triangulos enviados, contando cada instancia
+};
+
+// Cola de llamadas de dibujo que se ordena por estado antes de enviarse a la GPU
+// Clave de lo opaco (de mas a menos costoso de cambiar):
+//   0 | textura (23 bits) | mesh (24 bits) | material (16 bits)
+// Lo que tiene textura con transparencia va despues de todo lo opaco, de atras hacia adelante,
+// porque el blending depende del orden:
+//   1 | 0 (31 bits) | profundidad en la vista invertida (32 bits)
+class ColaRender {
+public:
+    static const uint64_t BIT_TRANSLUCIDO = 1ull << 63;
+
+    ColaRender();
+    ~ColaRender();
+
+    // Vaciar la cola al inicio del frame
+    void limpiar();
+
+    // profundidad es la distancia del elemento al plano de la camara; solo se usa para
+    // ordenar los elementos con transparencia
+    void agregar(Mesh* mesh, Texture* textura, Material* material, int nodo, float profundidad);
+
+    static bool esTranslucido(const ElementoRender& elemento) { return (elemento.clave & BIT_TRANSLUCIDO) != 0; }
+
+    // Ordenar por clave para agrupar los cambios de estado
+    void ordenar();
+
+    const std::vector<ElementoRender>& getElementos() const { return elementos; }
+
+private:
+    std::vector<ElementoRender> elementos;
+
+    // Ids pequenos para los materiales (no tienen id de OpenGL)
+    std::map<Material*, unsigned int> idsMateriales;
+    unsigned int obtenerIdMaterial(Material* material);
+};
@@ -2,10 +2,38 @@
 #define COMMONVALS
 #include "stb_image.h"
 
-const int MAX_POINT_LIGHTS = 5;
-const int MAX_SPOT_LIGHTS = 2;
+// Las luces se asignan a clusters en ClustersLuces, por lo que el costo por fragmento
+// depende de las luces cercanas y no del total
+const int MAX_POINT_LIGHTS = 128;
+const int MAX_SPOT_LIGHTS = 32;
 
 // Esta conbstante define el lmite de FPS para la aplicacin (Se usa en SceneInformation.cpp y Main.cpp)
 const double LIMIT_FPS = 1.0 / 60.0;  
 
+// Ticks por segundo de la simulacin (fsica, animaciones y audio); el render va aparte
+const double TICKS_POR_SEGUNDO = 60.0;
+
+// true: el render espera la sincrona vertical; false: se dibuja sin lmite de fps
+const bool SINCRONIA_VERTICAL = true;
+
+// true: el tick del frame siguiente se simula en otro hilo mientras se dibuja el actual
+// false: se simula y se dibuja en orden (un frame menos de latencia)
+const bool SIMULACION_EN_PARALELO = true;
+
+// Recompilar los shaders al guardar cambios en shaders/ sin reiniciar (solo en Debug)
+#ifdef _DEBUG
+const bool RECARGAR_SHADERS = true;
+#else
+const bool RECARGAR_SHADERS = false;
+#endif
+
+// Imprimir cada 5 segundos los contadores del render (culling, draw calls, LOD, luces, streaming)
+// y la configuracion del buffer de dibujos al crearlo. Solo en Debug; --benchmark guarda los
+// contadores principales de cada frame en su propio reporte
+#ifdef _DEBUG
+const bool REPORTE_ESTADISTICAS = true;
+#else
+const bool REPORTE_ESTADISTICAS = false;
+#endif
+
 #endif
\ No newline at end of file
@@ -129,8 +129,10 @@ namespace {
     glm::vec3 primoRotacionInicial(0.0f);                  // Rotacin inicial del primo
 }
 
-ComponenteAnimacion::ComponenteAnimacion(Entidad* entidad)
-    : entidad(entidad),
+ComponenteAnimacion::ComponenteAnimacion(Entidad* entidad, TipoAnimacion tipo)
+    : tipo(tipo),
+    objetivo(nullptr),
+    entidad(entidad),
     banderasAnimacion(0),
     numeroAnimaciones(0),
     rotacionPreSaltoQuat(1.0f, 0.0f, 0.0f, 0.0f)  // Inicializar quaternion de identidad
@@ -175,20 +177,21 @@ void ComponenteAnimacion::actualizarAnimacion(int indiceAnimacion, float deltaTi
         return;
     }
     
-    // Dependiendo de entidad llamar a su funcion de animacion
-    if (entidad->nombreObjeto == "isaac_cuerpo") {
+    // Dependiendo del tipo de animacion llamar a su funcion
+    switch (tipo) {
+    case TipoAnimacion::ISAAC:
         animarIsaac(indiceAnimacion, deltaTime, velocidadMovimiento);
-    }
-    else if (entidad->nombreObjeto == "hollow") {
+        break;
+    case TipoAnimacion::HOLLOW:
         animarHollow(indiceAnimacion, deltaTime);
-    }
-    else if (entidad->nombreObjeto == "comida_perro") {
+        break;
+    case TipoAnimacion::COMIDA_PERRO:
 		animarComidaPerro(indiceAnimacion, deltaTime);
-    }
-    else if(entidad->nombreObjeto == "puerta_secret_room") {
+        break;
+    case TipoAnimacion::PUERTA:
         animarPuerta(indiceAnimacion, deltaTime);
-	}
-    else if (entidad->nombreObjeto == "cuphead_torso") {
+        break;
+    case TipoAnimacion::CUPHEAD:
         // ndice 0: Animacin de caminata
         // ndice 1: Animacin de salto
         if (indiceAnimacion == 0) {
@@ -197,7 +200,15 @@ void ComponenteAnimacion::actualizarAnimacion(int indiceAnimacion, float deltaTi
         else if (indiceAnimacion == 1) {
             animarCupheadSalto(indiceAnimacion, deltaTime);
         }
-
+        break;
+    case TipoAnimacion::CANOA:
+        animarCanoa(indiceAnimacion, deltaTime);
+        break;
+    case TipoAnimacion::LUCHADOR:
+        animarLuchador(indiceAnimacion, deltaTime, objetivo);
+        break;
+    default:
+        break;
     }
 }
 
@@ -804,7 +815,11 @@ void ComponenteAnimacion::animarPuerta(int indiceAnimacion, float deltaTime) {
     }
     
     animacionActiva = estaActiva(indiceAnimacion);
-    
+
+    // La puerta solo se mueve mientras la animacion este activa
+    if (!animacionActiva) {
+        return;
+    }
     
     // Calcular el desplazamiento hacia abajo
     if (puertaBajando) {
@@ -12,10 +12,22 @@
 
 class Entidad;
 
+// Tipo de animacion que ejecuta el componente (se decide al crear la entidad)
+enum class TipoAnimacion {
+    NINGUNA,
+    ISAAC,
+    CUPHEAD,
+    HOLLOW,
+    COMIDA_PERRO,
+    PUERTA,
+    CANOA,
+    LUCHADOR
+};
+
 // Componente de animacion para entidades
 class ComponenteAnimacion {
 public:
-    ComponenteAnimacion(Entidad* owner);
+    ComponenteAnimacion(Entidad* owner, TipoAnimacion tipo = TipoAnimacion::NINGUNA);
     
     // Actualizar animacion numero 1
     void actualizarAnimacion(int indiceAnimacion, float deltaTime, float velocidadMovimiento);
@@ -24,6 +36,15 @@ public:
     void activarAnimacion(int indiceAnimacion);
     void desactivarAnimacion(int indiceAnimacion);
     bool estaActiva(int indiceAnimacion) const;
+
+    // Indica si la animacion principal o los keyframes se estan reproduciendo
+    bool enCurso() const { return estaActiva(0) || play; }
+
+    // Tipo de animacion que se llama desde actualizarAnimacion
+    TipoAnimacion tipo;
+
+    // Entidad con la que interactua la animacion (el luchador usa al primo)
+    Entidad* objetivo;
     
     // Propiedades de las animacion
 	unsigned short banderasAnimacion;  // Short para banderas de animacion (cada bit representa una animacion) (si bit x esta prendido, la animacion x esta activa)
@@ -0,0 +1,61 @@
+#include "ContadorGL.h"
+
+unsigned int ContadorGL::llamadas = 0;
+unsigned int ContadorGL::llamadasUltimoFrame = 0;
+
+// Envoltura por funcion: Id distingue funciones con la misma firma (glUseProgram y glBindVertexArray)
+template <int Id, typename R, typename... Args>
+struct EnvolturaGL {
+    static R (GLAPIENTRY *original)(Args...);
+
+    static R GLAPIENTRY llamar(Args... args)
+    {
+        ContadorGL::llamadas++;
+        return original(args...);
+    }
+};
+
+template <int Id, typename R, typename... Args>
+R (GLAPIENTRY *EnvolturaGL<Id, R, Args...>::original)(Args...) = nullptr;
+
+template <int Id, typename R, typename... Args>
+static void envolver(R (GLAPIENTRY *&puntero)(Args...))
+{
+    if (puntero == nullptr) return;
+    EnvolturaGL<Id, R, Args...>::original = puntero;
+    puntero = &EnvolturaGL<Id, R, Args...>::llamar;
+}
+
+#define ENVOLVER_GL(funcion) envolver<__LINE__>(__glew##funcion)
+
+void ContadorGL::instalar()
+{
+    ENVOLVER_GL(UseProgram);
+    ENVOLVER_GL(Uniform1i);
+    ENVOLVER_GL(Uniform1f);
+    ENVOLVER_GL(Uniform3f);
+    ENVOLVER_GL(UniformMatrix4fv);
+    ENVOLVER_GL(BindVertexArray);
+    ENVOLVER_GL(BindBuffer);
+    ENVOLVER_GL(BindBufferBase);
+    ENVOLVER_GL(BufferData);
+    ENVOLVER_GL(BufferSubData);
+    ENVOLVER_GL(ActiveTexture);
+    ENVOLVER_GL(VertexAttribPointer);
+    ENVOLVER_GL(EnableVertexAttribArray);
+    ENVOLVER_GL(DisableVertexAttribArray);
+    ENVOLVER_GL(VertexAttribDivisor);
+    ENVOLVER_GL(DrawElementsInstanced);
+    ENVOLVER_GL(DrawElementsInstancedBaseInstance);
+    ENVOLVER_GL(BindBufferRange);
+    ENVOLVER_GL(VertexAttribIPointer);
+    ENVOLVER_GL(FenceSync);
+    ENVOLVER_GL(ClientWaitSync);
+    ENVOLVER_GL(DeleteSync);
+}
+
+void ContadorGL::nuevoFrame()
+{
+    llamadasUltimoFrame = llamadas;
+    llamadas = 0;
+}
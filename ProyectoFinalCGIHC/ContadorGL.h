@@ -0,0 +1,24 @@
+#pragma once
+
+#include <glew.h>
+
+// Cuenta las llamadas a OpenGL de cada frame reemplazando los punteros de GLEW por envolturas.
+// Solo se cuentan las funciones que GLEW carga como punteros (uniforms, buffers, VAOs,
+// programas, atributos y dibujo instanciado); las de OpenGL 1.1 como glDrawElements o
+// glBindTexture se llaman directo y no pasan por aqui
+class ContadorGL {
+public:
+    // Envolver las funciones (despues de glewInit)
+    static void instalar();
+
+    // Cerrar el conteo del frame anterior y empezar uno nuevo
+    static void nuevoFrame();
+
+    static unsigned int getLlamadasUltimoFrame() { return llamadasUltimoFrame; }
+
+    // Lo incrementan las envolturas
+    static unsigned int llamadas;
+
+private:
+    static unsigned int llamadasUltimoFrame;
+};
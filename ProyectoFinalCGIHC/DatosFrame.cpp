@@ -0,0 +1,48 @@
+#include "DatosFrame.h"
+
+DatosFrame::DatosFrame()
+    : buffer(0)
+{
+    datos.projection = glm::mat4(1.0f);
+    datos.view = glm::mat4(1.0f);
+    datos.posicionCamara = glm::vec4(0.0f);
+    datos.luzDireccionalColor = glm::vec4(0.0f);
+    datos.luzDireccionalDireccion = glm::vec4(0.0f, -1.0f, 0.0f, 0.0f);
+}
+
+DatosFrame::~DatosFrame()
+{
+    if (buffer != 0) glDeleteBuffers(1, &buffer);
+}
+
+void DatosFrame::inicializar()
+{
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(DatosFrameGPU), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    // El binding no cambia, los programas lo toman de su layout
+    glBindBufferBase(GL_UNIFORM_BUFFER, BINDING_DATOS_FRAME, buffer);
+}
+
+void DatosFrame::setCamara(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& posicionCamara)
+{
+    datos.view = view;
+    datos.projection = projection;
+    datos.posicionCamara = glm::vec4(posicionCamara, 1.0f);
+}
+
+void DatosFrame::setLuzDireccional(const DirectionalLight& luz)
+{
+    datos.luzDireccionalColor = glm::vec4(luz.GetColor(), luz.GetAmbientIntensity());
+    datos.luzDireccionalDireccion = glm::vec4(luz.GetDirection(), luz.GetDiffuseIntensity());
+}
+
+void DatosFrame::subir()
+{
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(DatosFrameGPU), &datos);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, BINDING_DATOS_FRAME, buffer);
+}
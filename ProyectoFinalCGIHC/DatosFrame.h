@@ -0,0 +1,38 @@
+#pragma once
+
+#include <glew.h>
+#include <glm.hpp>
+#include "DirectionalLight.h"
+
+// Datos de la camara y de la luz direccional que leen todos los programas del frame
+// (shader_light_dibujos, shader_light.frag y los skyboxes) desde un UBO std140
+class DatosFrame {
+public:
+    DatosFrame();
+    ~DatosFrame();
+
+    // Binding del bloque DatosFrame en los shaders (ParametrosClusters usa el 0)
+    static const GLuint BINDING_DATOS_FRAME = 1;
+
+    // Crear el buffer (requiere contexto de OpenGL)
+    void inicializar();
+
+    void setCamara(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& posicionCamara);
+    void setLuzDireccional(const DirectionalLight& luz);
+
+    // Subir todo el bloque en una sola llamada y ligarlo
+    void subir();
+
+private:
+    // Misma disposicion que el bloque DatosFrame de los shaders
+    struct DatosFrameGPU {
+        glm::mat4 projection;
+        glm::mat4 view;
+        glm::vec4 posicionCamara;           // xyz
+        glm::vec4 luzDireccionalColor;      // rgb = color, a = intensidad ambiental
+        glm::vec4 luzDireccionalDireccion;  // xyz = direccion, w = intensidad difusa
+    };
+
+    DatosFrameGPU datos;
+    GLuint buffer;
+};
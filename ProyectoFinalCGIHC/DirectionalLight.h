@@ -16,6 +16,7 @@ public:
 		GLfloat diffuseIntensityLocation, GLfloat directionLocation);
 
 	void SetDirection(GLfloat xDir, GLfloat yDir, GLfloat zDir);
+	glm::vec3 GetDirection() const { return direction; }
 
 	~DirectionalLight();
 
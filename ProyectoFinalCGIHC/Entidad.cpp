@@ -7,10 +7,11 @@ Entidad::Entidad(const std::string& nombreObj,
                  glm::vec3 escala)
     : nombreObjeto(nombreObj), nombreModelo(""), nombreMesh(""), nombreTextura(""), nombreMaterial(""),
       posicionLocal(pos), rotacionLocal(glm::vec3(0.0f)), 
-      escalaLocal(escala), transformacionLocal(glm::mat4(1.0f)),
+      escalaLocal(escala), transformacionLocal(glm::mat4(1.0f)), transformacionMundial(glm::mat4(1.0f)),
       posicionInicial(pos), rotacionInicial(rot), escalaInicial(escala),
       TipoObjeto(TipoObjeto::MODELO), modelo(nullptr), mesh(nullptr), 
-      texture(nullptr), material(nullptr), fisica(nullptr), animacion(nullptr)
+      texture(nullptr), material(nullptr), fisica(nullptr), animacion(nullptr), estatica(false),
+      transformacionSucia(true), mundialSucia(true), indiceNodo(-1), horneada(false)
 {
     rotacionLocalQuat = glm::angleAxis(glm::radians(rot.z), glm::vec3(0.0f, 0.0f, 1.0f)) * 
                         glm::angleAxis(glm::radians(rot.y), glm::vec3(0.0f, 1.0f, 0.0f)) * 
@@ -36,6 +37,43 @@ void Entidad::actualizarTransformacion()
     transformacionLocal *= glm::mat4_cast(rotacionLocalQuat);
 	// Se escala adecuadamente
     transformacionLocal = glm::scale(transformacionLocal, escalaLocal);
+
+    // Se guardan los valores usados para detectar cambios posteriores
+    posicionCache = posicionLocal;
+    rotacionCache = rotacionLocalQuat;
+    escalaCache = escalaLocal;
+    transformacionSucia = false;
+    mundialSucia = true;
+}
+
+bool Entidad::actualizarTransformacionSiEsNecesario()
+{
+    // Las animaciones modifican directamente los campos publicos, por eso se compara contra la cache
+    if (transformacionSucia ||
+        rotacionLocal != glm::vec3(0.0f) ||
+        posicionLocal != posicionCache ||
+        rotacionLocalQuat != rotacionCache ||
+        escalaLocal != escalaCache) {
+        actualizarTransformacion();
+        return true;
+    }
+    return false;
+}
+
+void Entidad::actualizarTransformacionMundial(const glm::mat4& transformacionPadre, bool padreCambio)
+{
+    actualizarTransformacionSiEsNecesario();
+
+    // Solo se multiplica si cambio la matriz local o la del padre
+    bool cambio = mundialSucia || padreCambio;
+    if (cambio) {
+        transformacionMundial = transformacionPadre * transformacionLocal;
+        mundialSucia = false;
+    }
+
+    for (auto* hijo : hijos) {
+        hijo->actualizarTransformacionMundial(transformacionMundial, cambio);
+    }
 }
 
 
@@ -50,6 +88,8 @@ void Entidad::agregarHijo(Entidad* hijo)
 {
     if (hijo != nullptr) {
         hijos.push_back(hijo);
+        // El hijo debe recalcular su matriz mundial con el nuevo padre
+        hijo->mundialSucia = true;
     }
 }
 
@@ -15,6 +15,7 @@
 class SceneRenderer;
 class ComponenteFisico;
 class ComponenteAnimacion;
+class SceneGraph;
 
 // Enum para el tipo de geometra de la entidad
 enum class TipoObjeto {
@@ -36,6 +37,15 @@ public:
     
     // Actualiza la matriz de transformacin local
     void actualizarTransformacion();
+
+    // Recalcula la matriz local solo si cambio la posicion, rotacion o escala
+    bool actualizarTransformacionSiEsNecesario();
+
+    // Recalcula la matriz mundial de la entidad y sus hijos solo si cambio la local o la del padre
+    // La escena ya no la usa (las matrices mundiales salen de SceneGraph::actualizarTransformaciones);
+    // se conserva solo como el recorrido por apuntadores contra el que compara
+    // benchmarks/BenchmarkGrafoEscena.cpp
+    void actualizarTransformacionMundial(const glm::mat4& transformacionPadre, bool padreCambio = false);
     
     // Agregar una entidad hija
     void agregarHijo(Entidad* hijo);
@@ -61,6 +71,10 @@ public:
     
     // Obtener tipo de geometra
     TipoObjeto getTipoObjeto() const { return TipoObjeto; }
+    Model* getModelo() const { return modelo; }
+
+    // Handle del nodo en el SceneGraph (-1 si no esta en la escena)
+    int getIndiceNodo() const { return indiceNodo; }
     
     // Propiedades bsicas
     std::string nombreObjeto;          // Nombre de la entidad
@@ -75,6 +89,7 @@ public:
     glm::quat rotacionLocalQuat;       // Rotacin como quaternion
     glm::vec3 escalaLocal;             // Escala local
     glm::mat4 transformacionLocal;     // Matriz de transformacin local
+    glm::mat4 transformacionMundial;   // Matriz acumulada con la de los padres
     
     // Transformaciones iniciales
     glm::vec3 posicionInicial;         // Posicin inicial
@@ -88,9 +103,16 @@ public:
     // Componentes de animacion y fisica (no todas las entdades los tienes)
     ComponenteFisico* fisica;         // Componente de fsica
     ComponenteAnimacion* animacion;     // Componente de animacin
+
+    // La entidad no se movera despues de crearse; su geometria se puede hornear en un lote estatico
+    bool estatica;
+
+    // Indica si la geometria ya esta dentro de un lote estatico (el renderer la salta)
+    bool estaHorneada() const { return horneada; }
     
-    friend class SceneRenderer;
     friend class ComponenteAnimacion;
+    friend class SceneGraph;
+    friend class LotesEstaticos;
     
 private:
     // Tipo de geometra que usa esta entidad
@@ -101,6 +123,21 @@ private:
     Mesh* mesh;
     Texture* texture;
     Material* material;
+
+    // Banderas para evitar recalcular matrices de entidades estaticas
+    bool transformacionSucia;
+    bool mundialSucia;
+
+    // Valores con los que se calculo la ultima matriz local
+    glm::vec3 posicionCache;
+    glm::quat rotacionCache;
+    glm::vec3 escalaCache;
+
+    // Indice en los arreglos del SceneGraph
+    int indiceNodo;
+
+    // Asignado por LotesEstaticos al copiar la geometria a un lote
+    bool horneada;
     
     // Sincronizar rotacion con el quaternion
     void sincronizarRotacion();
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+
+// Estructuras del contenedor KTX2 compartidas por el cargador y la herramienta
+// herramientas/CocinarTexturas.cpp (no depende de OpenGL)
+namespace FormatoKTX2 {
+
+const uint8_t IDENTIFICADOR[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+// Formatos de Vulkan que se aceptan (KTX2 usa VkFormat)
+const uint32_t VK_FORMAT_BC1_RGB_UNORM_BLOCK = 131;
+const uint32_t VK_FORMAT_BC1_RGBA_UNORM_BLOCK = 133;
+const uint32_t VK_FORMAT_BC3_UNORM_BLOCK = 137;
+const uint32_t VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK = 147;
+const uint32_t VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK = 151;
+
+// Los formatos soportados usan bloques de 4x4 texeles
+inline uint32_t bytesPorBloque(uint32_t vkFormat)
+{
+    switch (vkFormat) {
+    case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+    case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+    case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
+        return 8;
+    case VK_FORMAT_BC3_UNORM_BLOCK:
+    case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
+        return 16;
+    default:
+        return 0;
+    }
+}
+
+inline uint64_t bytesNivel(uint32_t vkFormat, uint32_t ancho, uint32_t alto)
+{
+    return static_cast<uint64_t>((ancho + 3) / 4) * ((alto + 3) / 4) * bytesPorBloque(vkFormat);
+}
+
+struct Cabecera {
+    uint8_t identificador[12];
+    uint32_t vkFormat;
+    uint32_t typeSize;
+    uint32_t pixelWidth;
+    uint32_t pixelHeight;
+    uint32_t pixelDepth;
+    uint32_t layerCount;
+    uint32_t faceCount;
+    uint32_t levelCount;
+    uint32_t supercompressionScheme;
+    uint32_t dfdByteOffset;
+    uint32_t dfdByteLength;
+    uint32_t kvdByteOffset;
+    uint32_t kvdByteLength;
+    uint64_t sgdByteOffset;
+    uint64_t sgdByteLength;
+};
+
+// Entrada del indice de niveles (el nivel 0 es el mas grande)
+struct Nivel {
+    uint64_t byteOffset;
+    uint64_t byteLength;
+    uint64_t uncompressedByteLength;
+};
+
+static_assert(sizeof(Cabecera) == 80, "La cabecera KTX2 mide 80 bytes");
+static_assert(sizeof(Nivel) == 24, "Cada nivel del indice KTX2 mide 24 bytes");
+
+} // namespace FormatoKTX2
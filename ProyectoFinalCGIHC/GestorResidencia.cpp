@@ -0,0 +1,159 @@
+#include "GestorResidencia.h"
+#include "ModelManager.h"
+#include <cstdio>
+
+GestorResidencia::GestorResidencia()
+    : pool(2), zonasFijas(false)
+{
+}
+
+void GestorResidencia::declararZona(const std::string& nombre, const glm::vec3& centro,
+                                    float radioCarga, float radioDescarga,
+                                    const std::vector<std::string>& modelos)
+{
+    zonas.push_back({ nombre, centro, radioCarga, glm::max(radioCarga, radioDescarga), modelos, false });
+}
+
+std::set<std::string> GestorResidencia::getModelosBajoDemanda() const
+{
+    std::set<std::string> modelos;
+    for (const auto& zona : zonas) {
+        modelos.insert(zona.modelos.begin(), zona.modelos.end());
+    }
+    return modelos;
+}
+
+void GestorResidencia::inicializar(ModelManager& modelManager)
+{
+    for (const auto& nombre : getModelosBajoDemanda()) {
+        Model* modelo = modelManager.getModel(nombre);
+        if (modelo == nullptr) {
+            printf("[GestorResidencia] Modelo sin registrar: %s\n", nombre.c_str());
+            continue;
+        }
+        Asset asset;
+        asset.modelo = modelo;
+        asset.ruta = modelManager.getRutaModelo(nombre);
+        asset.estado = EstadoAsset::DESCARGADO;
+        asset.referencias = 0;
+        assets.emplace(nombre, std::move(asset));
+    }
+}
+
+void GestorResidencia::solicitar(const std::string& nombre)
+{
+    auto it = assets.find(nombre);
+    if (it == assets.end()) return;
+    Asset& asset = it->second;
+    asset.referencias++;
+    if (asset.estado != EstadoAsset::DESCARGADO) return;
+
+    // El modelo no se toca en el hilo principal hasta que termina la importacion
+    Model* modelo = asset.modelo;
+    std::string ruta = asset.ruta;
+    auto tarea = std::make_shared<std::packaged_task<bool()>>([modelo, ruta]() {
+        return modelo->ImportarModelo(ruta);
+    });
+    asset.importacion = tarea->get_future();
+    pool.encolar([tarea]() { (*tarea)(); });
+    asset.estado = EstadoAsset::IMPORTANDO;
+}
+
+void GestorResidencia::soltar(const std::string& nombre)
+{
+    auto it = assets.find(nombre);
+    if (it == assets.end() || it->second.referencias == 0) return;
+    // La descarga ocurre en actualizar, cuando el modelo no se esta importando
+    it->second.referencias--;
+}
+
+void GestorResidencia::cargarTodas(std::vector<const Model*>& cambiados)
+{
+    for (auto& zona : zonas) {
+        if (zona.activa) continue;
+        zona.activa = true;
+        for (const auto& nombre : zona.modelos) solicitar(nombre);
+    }
+    zonasFijas = true;
+
+    // Se suben todos juntos, sin el limite por frame
+    for (auto& par : assets) {
+        Asset& asset = par.second;
+        if (asset.estado != EstadoAsset::IMPORTANDO) continue;
+        if (asset.importacion.get()) {
+            asset.modelo->SubirModelo();
+            asset.estado = EstadoAsset::RESIDENTE;
+            cambiados.push_back(asset.modelo);
+        }
+        else {
+            asset.modelo->DescargarModelo();
+            asset.estado = EstadoAsset::DESCARGADO;
+        }
+    }
+    printf("[GestorResidencia] %u modelos de %u zonas residentes\n",
+           getNumResidentes(), static_cast<unsigned int>(zonas.size()));
+}
+
+void GestorResidencia::actualizar(const glm::vec3& posicionCamara, std::vector<const Model*>& cambiados)
+{
+    for (auto& zona : zonas) {
+        if (zonasFijas) break;
+        float distancia = glm::distance(posicionCamara, zona.centro);
+        if (!zona.activa && distancia < zona.radioCarga) {
+            zona.activa = true;
+            for (const auto& nombre : zona.modelos) solicitar(nombre);
+            printf("[GestorResidencia] Cargando zona %s\n", zona.nombre.c_str());
+        }
+        else if (zona.activa && distancia > zona.radioDescarga) {
+            zona.activa = false;
+            for (const auto& nombre : zona.modelos) soltar(nombre);
+            printf("[GestorResidencia] Descargando zona %s\n", zona.nombre.c_str());
+        }
+    }
+
+    int subidas = 0;
+    for (auto& par : assets) {
+        Asset& asset = par.second;
+
+        if (asset.estado == EstadoAsset::IMPORTANDO) {
+            if (subidas >= SUBIDAS_POR_FRAME) continue;
+            if (asset.importacion.wait_for(std::chrono::seconds(0)) != std::future_status::ready) continue;
+
+            bool importado = asset.importacion.get();
+            if (importado && asset.referencias > 0) {
+                asset.modelo->SubirModelo();
+                asset.estado = EstadoAsset::RESIDENTE;
+                subidas++;
+                cambiados.push_back(asset.modelo);
+            }
+            else {
+                // Ya nadie lo necesita (o fallo): se sueltan los datos decodificados
+                asset.modelo->DescargarModelo();
+                asset.estado = EstadoAsset::DESCARGADO;
+            }
+        }
+        else if (asset.estado == EstadoAsset::RESIDENTE && asset.referencias == 0) {
+            asset.modelo->DescargarModelo();
+            asset.estado = EstadoAsset::DESCARGADO;
+            cambiados.push_back(asset.modelo);
+        }
+    }
+}
+
+unsigned int GestorResidencia::getNumResidentes() const
+{
+    unsigned int residentes = 0;
+    for (const auto& par : assets) {
+        if (par.second.estado == EstadoAsset::RESIDENTE) residentes++;
+    }
+    return residentes;
+}
+
+unsigned int GestorResidencia::getNumCargando() const
+{
+    unsigned int cargando = 0;
+    for (const auto& par : assets) {
+        if (par.second.estado == EstadoAsset::IMPORTANDO) cargando++;
+    }
+    return cargando;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <future>
+#include <glm.hpp>
+#include "Model.h"
+#include "PoolHilos.h"
+
+class ModelManager;
+
+// Zona del mundo con los modelos que solo se usan dentro de ella
+struct ZonaResidencia {
+    std::string nombre;
+    glm::vec3 centro;
+    float radioCarga;       // La zona se carga cuando la camara entra a este radio
+    float radioDescarga;    // y se descarga al salir de este (mayor, para no oscilar en el borde)
+    std::vector<std::string> modelos;
+    bool activa;
+};
+
+// Carga y descarga los modelos de cada zona segun la distancia de la camara
+// Assimp y stb corren en hilos de trabajo; la subida a la GPU se reparte entre frames.
+// Las texturas de los modelos se liberan con ellos a traves del CacheTexturas.
+class GestorResidencia {
+public:
+    GestorResidencia();
+
+    void declararZona(const std::string& nombre, const glm::vec3& centro,
+                      float radioCarga, float radioDescarga,
+                      const std::vector<std::string>& modelos);
+
+    // Modelos que no se cargan al arrancar porque alguna zona los trae bajo demanda
+    std::set<std::string> getModelosBajoDemanda() const;
+
+    // Resolver los modelos de las zonas (ya registrados en el ModelManager)
+    void inicializar(ModelManager& modelManager);
+
+    // Revisar las zonas y avanzar las cargas pendientes (hilo de OpenGL, una vez por frame)
+    // Los modelos que entraron o salieron de memoria se agregan a cambiados
+    void actualizar(const glm::vec3& posicionCamara, std::vector<const Model*>& cambiados);
+
+    // Activar todas las zonas, esperar sus importaciones y subirlas en esta llamada
+    // Desde ese momento las zonas ya no se cargan ni descargan con la camara (benchmark)
+    void cargarTodas(std::vector<const Model*>& cambiados);
+
+    // Modelos que se suben a la GPU como maximo en un frame
+    static constexpr int SUBIDAS_POR_FRAME = 2;
+
+    unsigned int getNumResidentes() const;
+    unsigned int getNumCargando() const;
+
+private:
+    enum class EstadoAsset {
+        DESCARGADO,
+        IMPORTANDO,     // Assimp/stb en un hilo de trabajo
+        RESIDENTE
+    };
+
+    struct Asset {
+        Model* modelo;
+        std::string ruta;
+        EstadoAsset estado;
+        unsigned int referencias;   // Zonas activas que lo usan
+        std::future<bool> importacion;
+    };
+
+    void solicitar(const std::string& nombre);
+    void soltar(const std::string& nombre);
+
+    std::vector<ZonaResidencia> zonas;
+    std::map<std::string, Asset> assets;
+    PoolHilos pool;
+    bool zonasFijas;
+};
@@ -0,0 +1,133 @@
+#include "ImagenKTX2.h"
+#include "FormatoKTX2.h"
+#include <cstring>
+#include <sys/stat.h>
+
+namespace {
+
+// Formato de OpenGL equivalente; 0 si no se soporta
+GLenum formatoOpenGL(uint32_t vkFormat)
+{
+    switch (vkFormat) {
+    case FormatoKTX2::VK_FORMAT_BC1_RGB_UNORM_BLOCK:        return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    case FormatoKTX2::VK_FORMAT_BC1_RGBA_UNORM_BLOCK:       return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+    case FormatoKTX2::VK_FORMAT_BC3_UNORM_BLOCK:            return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    case FormatoKTX2::VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:    return GL_COMPRESSED_RGB8_ETC2;
+    case FormatoKTX2::VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:  return GL_COMPRESSED_RGBA8_ETC2_EAC;
+    default:                                                return 0;
+    }
+}
+
+bool fechaModificacion(const std::string& ruta, int64_t& fecha)
+{
+#ifdef _WIN32
+    struct _stat64 info;
+    if (_stat64(ruta.c_str(), &info) != 0) return false;
+#else
+    struct stat info;
+    if (stat(ruta.c_str(), &info) != 0) return false;
+#endif
+    fecha = static_cast<int64_t>(info.st_mtime);
+    return true;
+}
+
+} // namespace
+
+ImagenKTX2::ImagenKTX2()
+    : vkFormat(0), formatoGL(0), ancho(0), alto(0)
+{
+}
+
+std::string ImagenKTX2::rutaCocinada(const std::string& rutaFuente)
+{
+    // Se agrega la extension para que foo.png y foo.jpg no compartan archivo
+    return rutaFuente + ".ktx2";
+}
+
+bool ImagenKTX2::hayVersionCocinada(const std::string& rutaFuente)
+{
+    int64_t fechaCocinada, fechaFuente;
+    if (!fechaModificacion(rutaCocinada(rutaFuente), fechaCocinada)) return false;
+    // Si la imagen original ya no esta se usa la cocinada tal cual
+    if (!fechaModificacion(rutaFuente, fechaFuente)) return true;
+    return fechaCocinada >= fechaFuente;
+}
+
+bool ImagenKTX2::abrir(const std::string& ruta)
+{
+    cerrar();
+    if (!archivo.abrir(ruta)) return false;
+
+    const unsigned char* datos = archivo.getDatos();
+    size_t tamano = archivo.getTamano();
+
+    FormatoKTX2::Cabecera cabecera;
+    if (tamano < sizeof(cabecera)) {
+        cerrar();
+        return false;
+    }
+    memcpy(&cabecera, datos, sizeof(cabecera));
+
+    // Solo texturas 2D simples sin supercompresion
+    formatoGL = formatoOpenGL(cabecera.vkFormat);
+    if (memcmp(cabecera.identificador, FormatoKTX2::IDENTIFICADOR, sizeof(FormatoKTX2::IDENTIFICADOR)) != 0 ||
+        formatoGL == 0 || cabecera.supercompressionScheme != 0 || cabecera.pixelDepth != 0 ||
+        cabecera.layerCount > 1 || cabecera.faceCount != 1 || cabecera.pixelWidth == 0 || cabecera.pixelHeight == 0) {
+        cerrar();
+        return false;
+    }
+
+    vkFormat = cabecera.vkFormat;
+    ancho = static_cast<int>(cabecera.pixelWidth);
+    alto = static_cast<int>(cabecera.pixelHeight);
+    uint32_t numNiveles = cabecera.levelCount > 0 ? cabecera.levelCount : 1;
+    if (sizeof(cabecera) + sizeof(FormatoKTX2::Nivel) * static_cast<size_t>(numNiveles) > tamano) {
+        cerrar();
+        return false;
+    }
+
+    for (uint32_t i = 0; i < numNiveles; i++) {
+        FormatoKTX2::Nivel nivel;
+        memcpy(&nivel, datos + sizeof(cabecera) + i * sizeof(nivel), sizeof(nivel));
+        uint32_t anchoNivel = cabecera.pixelWidth >> i ? cabecera.pixelWidth >> i : 1;
+        uint32_t altoNivel = cabecera.pixelHeight >> i ? cabecera.pixelHeight >> i : 1;
+        if (nivel.byteOffset + nivel.byteLength > tamano ||
+            nivel.byteLength != FormatoKTX2::bytesNivel(vkFormat, anchoNivel, altoNivel)) {
+            cerrar();
+            return false;
+        }
+        niveles.push_back({ datos + nivel.byteOffset, static_cast<GLsizei>(nivel.byteLength) });
+    }
+    return true;
+}
+
+void ImagenKTX2::cerrar()
+{
+    niveles.clear();
+    archivo.cerrar();
+}
+
+bool ImagenKTX2::tieneAlfa() const
+{
+    return vkFormat != FormatoKTX2::VK_FORMAT_BC1_RGB_UNORM_BLOCK &&
+           vkFormat != FormatoKTX2::VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK;
+}
+
+size_t ImagenKTX2::subir()
+{
+    size_t bytes = 0;
+    for (size_t i = 0; i < niveles.size(); i++) {
+        GLsizei anchoNivel = ancho >> i ? ancho >> i : 1;
+        GLsizei altoNivel = alto >> i ? alto >> i : 1;
+        glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), formatoGL, anchoNivel, altoNivel, 0,
+                               niveles[i].tamano, niveles[i].datos);
+        bytes += static_cast<size_t>(niveles[i].tamano);
+    }
+    // Los mipmaps ya vienen hechos: no se llama a glGenerateMipmap. Con GL_LINEAR (lo que deja
+    // Texture) solo se leeria el nivel 0, asi que con cadena se filtra entre niveles
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(niveles.size()) - 1);
+    if (niveles.size() > 1) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    }
+    return bytes;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <glew.h>
+#include "ArchivoMapeado.h"
+
+// Textura comprimida por bloques (BC1/BC3/ETC2) en un archivo KTX2 con sus mipmaps
+// La lectura solo mapea y valida el archivo (se puede hacer en un hilo de carga);
+// la subida manda cada nivel directo de la mapping con glCompressedTexImage2D
+class ImagenKTX2 {
+public:
+    ImagenKTX2();
+
+    // Ruta de la version cocinada de una imagen (la genera herramientas/CocinarTexturas.cpp)
+    static std::string rutaCocinada(const std::string& rutaFuente);
+
+    // true si existe la version cocinada y no es mas vieja que la imagen original
+    static bool hayVersionCocinada(const std::string& rutaFuente);
+
+    bool abrir(const std::string& ruta);
+    void cerrar();
+
+    // Subir todos los niveles a la textura ligada en GL_TEXTURE_2D y muestrear con mipmaps si hay
+    // mas de uno. Regresa los bytes que ocupa en la memoria de video
+    size_t subir();
+
+    int getAncho() const { return ancho; }
+    int getAlto() const { return alto; }
+    bool tieneAlfa() const;
+
+private:
+    struct Nivel {
+        const unsigned char* datos;
+        GLsizei tamano;
+    };
+
+    ArchivoMapeado archivo;
+    std::vector<Nivel> niveles;
+    unsigned int vkFormat;
+    GLenum formatoGL;
+    int ancho, alto;
+};
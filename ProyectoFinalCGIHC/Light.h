@@ -10,6 +10,10 @@ public:
 	Light(GLfloat red, GLfloat green, GLfloat blue, 
 			GLfloat aIntensity, GLfloat dIntensity);
 
+	glm::vec3 GetColor() const { return color; }
+	GLfloat GetAmbientIntensity() const { return ambientIntensity; }
+	GLfloat GetDiffuseIntensity() const { return diffuseIntensity; }
+
 	~Light();
 
 protected:
@@ -0,0 +1,195 @@
+#include "LotesEstaticos.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <gtc/matrix_inverse.hpp>
+
+LotesEstaticos::LotesEstaticos()
+{
+}
+
+LotesEstaticos::~LotesEstaticos()
+{
+    limpiar();
+}
+
+void LotesEstaticos::limpiar()
+{
+    for (auto& lote : lotes) {
+        delete lote.mesh;
+    }
+    lotes.clear();
+
+    for (auto& horneada : horneadas) {
+        horneada.entidad->horneada = false;
+    }
+    horneadas.clear();
+}
+
+std::vector<char> LotesEstaticos::calcularEstaticos(const SceneGraph& grafo)
+{
+    int numNodos = static_cast<int>(grafo.getNumNodos());
+
+    // Un nodo solo es estatico si el y todos sus padres lo son (preorden: el padre ya se evaluo)
+    std::vector<char> estaticos(numNodos, 0);
+    for (int i = 0; i < numNodos; i++) {
+        Entidad* entidad = grafo.getEntidad(i);
+        int padre = grafo.getPadre(i);
+        estaticos[i] = (entidad->estatica && (padre < 0 || estaticos[padre])) ? 1 : 0;
+        // Las entidades con componentes se mueven aunque esten marcadas
+        if (entidad->animacion != nullptr || entidad->fisica != nullptr) estaticos[i] = 0;
+    }
+    return estaticos;
+}
+
+LotesEstaticos::Celda LotesEstaticos::calcularCelda(const SceneGraph& grafo, int nodo)
+{
+    const EsferaEnvolvente& esfera = grafo.getEsferaMundial(nodo);
+    glm::vec3 centro = esfera.valido ? esfera.centro : glm::vec3(grafo.getTransformacionMundial(nodo)[3]);
+    return Celda(static_cast<int>(std::floor(centro.x / TAMANO_CELDA)),
+                 static_cast<int>(std::floor(centro.z / TAMANO_CELDA)));
+}
+
+void LotesEstaticos::construir(const SceneGraph& grafo)
+{
+    limpiar();
+    hornear(grafo, nullptr);
+
+    printf("[LotesEstaticos] %u entidades horneadas en %u lotes\n",
+           getNumEntidadesHorneadas(), static_cast<unsigned int>(lotes.size()));
+}
+
+bool LotesEstaticos::reconstruir(const SceneGraph& grafo, const std::vector<const Model*>& modelos)
+{
+    std::vector<char> estaticos = calcularEstaticos(grafo);
+
+    // Celdas afectadas: donde esta ahora cada nodo del modelo y donde se horneo antes
+    // (al cargarse la geometria el centro del nodo puede cambiar de celda)
+    std::set<Celda> celdas;
+    for (int i = 0; i < static_cast<int>(grafo.getNumNodos()); i++) {
+        const NodoRender& nodo = grafo.getNodoRender(i);
+        if (!estaticos[i] || nodo.tipo != TipoObjeto::MODELO ||
+            std::find(modelos.begin(), modelos.end(), nodo.modelo) == modelos.end()) continue;
+
+        celdas.insert(calcularCelda(grafo, i));
+        Entidad* entidad = grafo.getEntidad(i);
+        for (const auto& horneada : horneadas) {
+            if (horneada.entidad == entidad) celdas.insert(horneada.celda);
+        }
+    }
+    if (celdas.empty()) return false;
+
+    // Quitar los lotes de esas celdas y desmarcar sus entidades
+    for (auto& lote : lotes) {
+        if (celdas.count(Celda(lote.celdaX, lote.celdaZ)) == 0) continue;
+        delete lote.mesh;
+        lote.mesh = nullptr;
+    }
+    lotes.erase(std::remove_if(lotes.begin(), lotes.end(),
+                               [](const LoteEstatico& lote) { return lote.mesh == nullptr; }),
+                lotes.end());
+    for (auto& horneada : horneadas) {
+        if (celdas.count(horneada.celda) != 0) horneada.entidad->horneada = false;
+    }
+    horneadas.erase(std::remove_if(horneadas.begin(), horneadas.end(),
+                                   [](const EntidadHorneada& horneada) { return !horneada.entidad->horneada; }),
+                    horneadas.end());
+
+    hornear(grafo, &celdas);
+
+    printf("[LotesEstaticos] %u celdas horneadas de nuevo (%u lotes en total)\n",
+           static_cast<unsigned int>(celdas.size()), static_cast<unsigned int>(lotes.size()));
+    return true;
+}
+
+void LotesEstaticos::hornear(const SceneGraph& grafo, const std::set<Celda>* celdas)
+{
+    std::map<ClaveLote, GeometriaLote> grupos;
+    std::vector<char> estaticos = calcularEstaticos(grafo);
+
+    for (int i = 0; i < static_cast<int>(grafo.getNumNodos()); i++) {
+        // Las entidades que siguen en un lote de otra celda no se copian dos veces
+        if (!estaticos[i] || grafo.getEntidad(i)->horneada) continue;
+
+        const NodoRender& nodo = grafo.getNodoRender(i);
+        Celda celda = calcularCelda(grafo, i);
+        if (celdas != nullptr && celdas->count(celda) == 0) continue;
+
+        // Solo se hornea un nodo si todos sus meshes tienen su copia en memoria; los modelos
+        // que aun no estan residentes se hornean cuando lleguen
+        std::vector<std::pair<const Mesh*, Texture*>> meshes;
+        bool completo = true;
+        if (nodo.tipo == TipoObjeto::MODELO && nodo.modelo != nullptr) {
+            for (unsigned int m = 0; m < nodo.modelo->getNumMeshes(); m++) {
+                Texture* textura = nodo.modelo->getTexturaMesh(m);
+                meshes.push_back({ nodo.modelo->getMesh(m), textura != nullptr ? textura : nodo.texture });
+            }
+        }
+        else if (nodo.tipo == TipoObjeto::MESH && nodo.mesh != nullptr) {
+            meshes.push_back({ nodo.mesh, nodo.texture });
+        }
+        for (const auto& mesh : meshes) {
+            if (mesh.first == nullptr || !mesh.first->tieneGeometria()) completo = false;
+        }
+        if (meshes.empty() || !completo) continue;
+
+        const glm::mat4& transformacion = grafo.getTransformacionMundial(i);
+        for (const auto& mesh : meshes) {
+            agregarMesh(grupos[ClaveLote(mesh.second, nodo.material, celda.first, celda.second)],
+                        mesh.first, transformacion);
+        }
+
+        Entidad* entidad = grafo.getEntidad(i);
+        entidad->horneada = true;
+        horneadas.push_back({ entidad, celda });
+    }
+
+    for (auto& grupo : grupos) {
+        GeometriaLote& geometria = grupo.second;
+        if (geometria.indices.empty()) continue;
+
+        LoteEstatico lote;
+        lote.mesh = new Mesh();
+        lote.mesh->CreateMesh(geometria.vertices.data(), geometria.indices.data(),
+                              static_cast<unsigned int>(geometria.vertices.size()),
+                              static_cast<unsigned int>(geometria.indices.size()),
+                              Mesh::elegirFormato(geometria.vertices.data(),
+                                                  static_cast<unsigned int>(geometria.vertices.size())));
+        lote.textura = std::get<0>(grupo.first);
+        lote.material = std::get<1>(grupo.first);
+        lote.numMeshes = geometria.numMeshes;
+        lote.celdaX = std::get<2>(grupo.first);
+        lote.celdaZ = std::get<3>(grupo.first);
+        lotes.push_back(lote);
+    }
+}
+
+void LotesEstaticos::agregarMesh(GeometriaLote& geometria, const Mesh* mesh, const glm::mat4& transformacion)
+{
+    if (mesh == nullptr) return;
+
+    std::vector<GLfloat> vertices;
+    std::vector<unsigned int> indices;
+    mesh->LeerGeometria(vertices, indices);
+
+    // Las normales usan la inversa transpuesta para soportar escalas no uniformes
+    glm::mat3 matrizNormal = glm::inverseTranspose(glm::mat3(transformacion));
+    unsigned int base = static_cast<unsigned int>(geometria.vertices.size() / 8);
+
+    for (size_t v = 0; v + 7 < vertices.size(); v += 8) {
+        glm::vec3 posicion = glm::vec3(transformacion * glm::vec4(vertices[v], vertices[v + 1], vertices[v + 2], 1.0f));
+        glm::vec3 normal = matrizNormal * glm::vec3(vertices[v + 5], vertices[v + 6], vertices[v + 7]);
+        float longitud = glm::length(normal);
+        if (longitud > 0.0f) normal /= longitud;
+
+        geometria.vertices.insert(geometria.vertices.end(),
+            { posicion.x, posicion.y, posicion.z,
+              vertices[v + 3], vertices[v + 4],
+              normal.x, normal.y, normal.z });
+    }
+
+    for (unsigned int indice : indices) {
+        geometria.indices.push_back(base + indice);
+    }
+    geometria.numMeshes++;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <vector>
+#include <map>
+#include <set>
+#include <tuple>
+#include <utility>
+#include <glm.hpp>
+#include "Entidad.h"
+#include "SceneGraph.h"
+
+// Geometria de varias entidades estaticas ya transformada a espacio mundial
+struct LoteEstatico {
+    Mesh* mesh;             // Mesh propio del lote (sus volumenes ya estan en espacio mundial)
+    Texture* textura;
+    Material* material;
+    unsigned int numMeshes; // Meshes originales que se copiaron al lote
+    int celdaX, celdaZ;     // Celda del mundo a la que pertenece
+};
+
+// Construye los lotes estaticos a partir de las entidades marcadas como estaticas
+// Se agrupa por textura, material y celda del mundo para que el frustum culling siga sirviendo
+// La geometria sale de la copia en memoria de cada mesh (Mesh::ConservarGeometria); los meshes
+// sin copia no se hornean y se dibujan como nodos normales
+class LotesEstaticos {
+public:
+    LotesEstaticos();
+    ~LotesEstaticos();
+
+    // Lado de las celdas en que se divide el mundo para separar los lotes
+    static constexpr float TAMANO_CELDA = 100.0f;
+
+    // Hornear los nodos estaticos del grafo (deben tener sus matrices mundiales actualizadas)
+    // Las entidades horneadas quedan marcadas; el grafo se debe reconstruir despues
+    void construir(const SceneGraph& grafo);
+
+    // Volver a hornear solo las celdas con nodos estaticos que usan alguno de los modelos
+    // (los que entraron o salieron de memoria). Regresa false si ningun lote cambio
+    bool reconstruir(const SceneGraph& grafo, const std::vector<const Model*>& modelos);
+
+    // Liberar los lotes y desmarcar las entidades
+    void limpiar();
+
+    const std::vector<LoteEstatico>& getLotes() const { return lotes; }
+    unsigned int getNumEntidadesHorneadas() const { return static_cast<unsigned int>(horneadas.size()); }
+
+private:
+    // Vertices e indices acumulados de un grupo antes de subirlo a la GPU
+    struct GeometriaLote {
+        std::vector<GLfloat> vertices;
+        std::vector<unsigned int> indices;
+        unsigned int numMeshes = 0;
+    };
+    typedef std::pair<int, int> Celda;
+    typedef std::tuple<Texture*, Material*, int, int> ClaveLote;
+
+    // Entidad horneada y la celda en cuyo lote quedo su geometria
+    struct EntidadHorneada {
+        Entidad* entidad;
+        Celda celda;
+    };
+
+    std::vector<LoteEstatico> lotes;
+    std::vector<EntidadHorneada> horneadas;
+
+    // Nodos que pueden hornearse: estaticos igual que todos sus padres y sin componentes
+    static std::vector<char> calcularEstaticos(const SceneGraph& grafo);
+    // Celda del centro del nodo, para que un objeto no se parta entre lotes
+    static Celda calcularCelda(const SceneGraph& grafo, int nodo);
+
+    // Hornear los nodos estaticos de las celdas dadas (todas si celdas es nullptr)
+    void hornear(const SceneGraph& grafo, const std::set<Celda>* celdas);
+
+    // Copia un mesh al grupo aplicando la matriz mundial a posiciones y normales
+    static void agregarMesh(GeometriaLote& geometria, const Mesh* mesh, const glm::mat4& transformacion);
+};
@@ -17,18 +17,97 @@
 #include "SceneInformation.h"
 #include "SceneRenderer.h"
 #include "CommonValues.h"
+#include "ContadorGL.h"
+#include "CacheTexturas.h"
+#include "CacheShaders.h"
+#include "Benchmark.h"
+#include "ReporteCarga.h"
+#include "PasoFijo.h"
+#include "PlanificadorTareas.h"
+#include "TuberiaFrames.h"
 
 Window mainWindow;
 
-GLfloat deltaTime = 0.0f;
-GLfloat lastTime = 0.0f;
+// Dibuja los frames del benchmark en el framebuffer fuera de pantalla con un tick de
+// simulacin por frame y escribe los tiempos de cada uno
+// Con --secuencial se simula y se dibuja en orden para comparar con la simulacin en paralelo
+int ejecutarBenchmark(const ConfiguracionBenchmark& config, SceneInformation& scene,
+	SceneRenderer& sceneRenderer, GLfloat fov)
+{
+	Benchmark benchmark(config);
+	if (!benchmark.inicializar()) {
+		return 1;
+	}
 
+	// Sin teclas ni mouse: la cmara solo sigue el recorrido
+	EntradaFrame entrada = {};
+	entrada.ticks = 1;
+	entrada.deltaTick = PasoFijo::deltaPorTick(TICKS_POR_SEGUNDO);
+	entrada.alpha = 1.0f;
+	glm::mat4 projection = glm::perspective(glm::radians(fov), (GLfloat)config.ancho / config.alto, 0.1f, 1000.0f);
 
+	// Todas las zonas y los skyboxes se cargan antes del primer frame: si se cargaran por
+	// distancia, los contadores y msActualizar dependerian de cuando termina cada importacion
+	scene.cargarTodosLosRecursos();
+	TuberiaFrames tuberia(scene, !config.secuencial);
+
+	for (unsigned int frame = 0; frame < benchmark.getFramesTotales(); frame++)
+	{
+		ContadorGL::nuevoFrame();
+		auto inicioFrame = std::chrono::steady_clock::now();
+
+		tuberia.iniciar(entrada, [&benchmark, &scene, frame]() {
+			benchmark.prepararFrame(scene.getCamara(), frame);
+		});
+		double msActualizar = ReporteCarga::msDesde(inicioFrame);
+
+		sceneRenderer.renderizarFrame(tuberia.getPaqueteListo(), projection);
+
+		auto inicioEspera = std::chrono::steady_clock::now();
+		tuberia.terminar();
+		msActualizar += ReporteCarga::msDesde(inicioEspera);
+		double msCpu = ReporteCarga::msDesde(inicioFrame);
+
+		// Sin swapBuffers nada limita la cola de la GPU; se espera para que cada frame empiece vaco
+		glFinish();
+
+		const TiemposRender& tiempos = sceneRenderer.getTiempos();
+		const EstadisticasRender& estadisticas = sceneRenderer.getEstadisticas();
+		MuestraBenchmark muestra;
+		muestra.frame = frame;
+		muestra.msActualizar = msActualizar;
+		muestra.msUniforms = tiempos.msUniforms;
+		muestra.msCulling = tiempos.msCulling;
+		muestra.msEnvio = tiempos.msEnvio;
+		muestra.msCpu = msCpu;
+		muestra.msFrame = ReporteCarga::msDesde(inicioFrame);
+		muestra.llamadasDibujo = estadisticas.llamadasDibujo;
+		muestra.triangulos = estadisticas.triangulos;
+		muestra.objetosDibujados = sceneRenderer.getObjetosDibujados();
+		muestra.objetosDescartados = sceneRenderer.getObjetosDescartados();
+		muestra.llamadasGL = ContadorGL::llamadas;
+		benchmark.registrar(muestra);
+	}
 
-int main()
+	return benchmark.escribir() ? 0 : 1;
+}
+
+int main(int argc, char** argv)
 {
-	mainWindow = Window(1366, 768); // 1280, 1024 or 1024, 768
-	mainWindow.Initialise();
+	// --benchmark dibuja sin ventana visible y sale al terminar
+	ConfiguracionBenchmark benchmark;
+	if (!Benchmark::leerArgumentos(argc, argv, benchmark)) {
+		printf("Uso: ProyectoFinalCGIHC [--benchmark] [--secuencial] [--frames N] [--calentamiento N] [--tamano ANCHOxALTO] [--salida archivo.csv|archivo.json]\n");
+		return 1;
+	}
+
+	mainWindow = benchmark.activo ? Window(benchmark.ancho, benchmark.alto) : Window(1366, 768); // 1280, 1024 or 1024, 768
+	if (mainWindow.Initialise(benchmark.activo) != 0) {
+		return 1;
+	}
+
+	// Contar las llamadas a OpenGL por frame (necesita GLEW ya inicializado)
+	ContadorGL::instalar();
 
 	// Renderizador de la escena
 	SceneRenderer sceneRenderer;
@@ -42,55 +121,102 @@ int main()
 		return 1;
 	}
 
+	// Tiempo de arranque en frio (glfwGetTime cuenta desde glfwInit)
+	printf("[Arranque] Escena lista en %.2f ms\n", glfwGetTime() * 1000.0);
+	CacheTexturas::instancia().imprimirReporte();
+	CacheShaders::instancia().imprimirReporte();
+	printf("[PlanificadorTareas] %u hilos para las tareas de cada tick\n", PlanificadorTareas::instancia().getNumHilos());
+	CacheShaders::instancia().setRecargaEnCaliente(RECARGAR_SHADERS);
+
 
 	// FOV base para cmara libre (45 grados)
 	GLfloat baseFOV = 50.0f;
 	// FOV ms amplio para tercera persona (60 grados)
 	GLfloat thirdPersonFOV = 65.0f;
+
+	if (benchmark.activo) {
+		return ejecutarBenchmark(benchmark, scene, sceneRenderer, baseFOV);
+	}
 	
 	glm::mat4 projection = glm::perspective(glm::radians(baseFOV), (GLfloat)mainWindow.getBufferWidth() / mainWindow.getBufferHeight(), 0.1f, 1000.0f);
 	
+	// Tiempo del ultimo reporte de objetos dibujados/descartados
+	double ultimoReporteCulling = 0.0;
+
+	// La simulacin avanza en ticks fijos y el render dibuja entre los dos ltimos
+	PasoFijo pasoFijo(TICKS_POR_SEGUNDO);
+	double lastTime = glfwGetTime();
+
+	// El hilo de simulacin avanza el frame siguiente mientras este hilo dibuja el actual
+	TuberiaFrames tuberia(scene, SIMULACION_EN_PARALELO);
+	EntradaFrame entrada;
+
 	// Loop mientras no se cierra la ventana
 	while (!mainWindow.getShouldClose())
 	{
-		GLfloat now = glfwGetTime();
-		deltaTime = now - lastTime;
-		deltaTime += (now - lastTime) / LIMIT_FPS;
+		ContadorGL::nuevoFrame();
+
+		// En double: con float el reloj pierde resolucion despues de unas horas y los ticks tiemblan
+		double now = glfwGetTime();
+		CacheShaders::instancia().revisarCambios(now);
+		unsigned int ticks = pasoFijo.avanzar(now - lastTime);
 		lastTime = now;
 
 		// Recibir eventos del usuario
 		glfwPollEvents();
 		
-		// Actualizar la escena con input del usuario (cmara, controles, etc.)
-		scene.actualizarFrameInput(mainWindow.getsKeys(), 
-		                           mainWindow.getXChange(), 
-		                           mainWindow.getYChange(),
-		                           mainWindow.getScrollChange(),  // Agregar scroll
-		                           deltaTime);
-
-		// Actualizar la escena (luces dinmicas, animaciones, etc.)
-		scene.actualizarFrame(deltaTime);
+		// Actualizar la escena con input del usuario (cmara, controles, etc.), luces dinmicas,
+		// animaciones y matrices, una vez por tick. La entrada se copia porque la ventana la
+		// sigue escribiendo; si en este frame no toca ningn tick el mouse se sigue acumulando
+		memcpy(entrada.teclas, mainWindow.getsKeys(), sizeof(entrada.teclas));
+		entrada.cambioX = ticks > 0 ? mainWindow.getXChange() : 0.0f;
+		entrada.cambioY = ticks > 0 ? mainWindow.getYChange() : 0.0f;
+		entrada.cambioScroll = ticks > 0 ? mainWindow.getScrollChange() : 0.0f;  // Agregar scroll
+		entrada.ticks = ticks;
+		entrada.deltaTick = pasoFijo.getDeltaTick();
+		entrada.alpha = pasoFijo.getAlpha();
+		tuberia.iniciar(entrada);
+
+		// Se dibuja el ltimo paquete terminado (sin paralelo es el que se acaba de simular)
+		const PaqueteFrame& paquete = tuberia.getPaqueteListo();
 		
 		// NUEVO: Ajustar FOV segn el modo de cmara
-		GLfloat currentFOV = scene.getCamara().isThirdPersonMode() ? thirdPersonFOV : baseFOV;
+		GLfloat currentFOV = paquete.terceraPersona ? thirdPersonFOV : baseFOV;
 		projection = glm::perspective(glm::radians(currentFOV), 
 		                             (GLfloat)mainWindow.getBufferWidth() / mainWindow.getBufferHeight(), 
 		                             0.1f, 1000.0f);
 
 		// Renderizar frame completo
-		sceneRenderer.renderizarFrame(
-			scene.getSkyboxActual(),
-			scene.getCamara(),
-			projection,
-			scene.getEntidades(),
-			scene.getLuzDireccional(),
-			scene.getPointLightsActuales(),
-			scene.getPointLightCountActual(),
-			scene.getSpotLightsActuales(),
-			scene.getSpotLightCountActual()
-		);
+		sceneRenderer.renderizarFrame(paquete, projection);
+
+		// Reportar cada 5 segundos los contadores del culling y de la cola de render
+		if (REPORTE_ESTADISTICAS && now - ultimoReporteCulling >= 5.0) {
+			const EstadisticasRender& estadisticas = sceneRenderer.getEstadisticas();
+			printf("[SceneRenderer] Objetos dibujados: %u, descartados: %u\n",
+				sceneRenderer.getObjetosDibujados(), sceneRenderer.getObjetosDescartados());
+			printf("[SceneRenderer] Draw calls: %u, cambios de textura: %u, mesh: %u, matrices de nodo: %u\n",
+				estadisticas.llamadasDibujo, estadisticas.cambiosTextura, estadisticas.cambiosMesh,
+				estadisticas.cambiosMatriz);
+			printf("[SceneRenderer] Lotes instanciados: %u, instancias: %u\n",
+				estadisticas.lotesInstanciados, estadisticas.instanciasDibujadas);
+			printf("[SceneRenderer] Frames que esperaron a la GPU para reusar el buffer de dibujos: %u\n",
+				sceneRenderer.getBufferDibujos().getEsperas());
+			printf("[SceneRenderer] Triangulos: %u, modelos por nivel de LOD: %u / %u / %u / %u\n",
+				estadisticas.triangulos, sceneRenderer.getModelosPorNivelLOD(0), sceneRenderer.getModelosPorNivelLOD(1),
+				sceneRenderer.getModelosPorNivelLOD(2), sceneRenderer.getModelosPorNivelLOD(3));
+			const ClustersLuces& clusters = sceneRenderer.getClustersLuces();
+			printf("[SceneRenderer] Luces: %u, asignaciones a clusters: %u, maximo en un cluster: %u\n",
+				clusters.getNumLuces(), clusters.getAsignaciones(), clusters.getMaxLucesEnCluster());
+			printf("[SceneRenderer] Llamadas a OpenGL en el ultimo frame: %u\n", ContadorGL::getLlamadasUltimoFrame());
+			printf("[GestorResidencia] Modelos bajo demanda residentes: %u, cargando: %u\n",
+				scene.getGestorResidencia().getNumResidentes(), scene.getGestorResidencia().getNumCargando());
+			ultimoReporteCulling = now;
+		}
 
 		mainWindow.swapBuffers();
+
+		// Subir lo que carg la simulacin y dejar su paquete para el siguiente frame
+		tuberia.terminar();
 	}
 
 	return 0;
@@ -10,6 +10,10 @@ public:
 
 	void UseMaterial(GLuint specularIntensityLocation, GLuint shininessLocation);
 
+	// Valores que se copian a los datos de cada dibujo
+	GLfloat GetSpecularIntensity() const { return specularIntensity; }
+	GLfloat GetShininess() const { return shininess; }
+
 	~Material();
 
 private: 
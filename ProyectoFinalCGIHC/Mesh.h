@@ -1,20 +1,111 @@
 #pragma once
 
+#include <vector>
 #include <glew.h>
+#include "VolumenEnvolvente.h"
+
+// Como se guarda cada atributo en el VBO. Por omision todo en float
+// (posicion, UV y normal = 8 flotantes, 32 bytes por vertice)
+struct FormatoVertice {
+	bool posicionHalf;		// 3 half + relleno (8 bytes en lugar de 12)
+	bool uvHalf;			// 2 half (4 bytes en lugar de 8)
+	bool normalEmpacada;	// 10_10_10_2 con signo normalizado (4 bytes en lugar de 12)
+
+	FormatoVertice() : posicionHalf(false), uvHalf(false), normalEmpacada(false) {}
+
+	GLsizei getStride() const;
+
+	// Banderas en un entero para guardarlo en el cache de modelos
+	unsigned int getBits() const;
+	static FormatoVertice desdeBits(unsigned int bits);
+};
+
+// Buffers de un mesh ya empacados: vertices en el formato dado e indices de 16 bits si el
+// mesh tiene 65536 vertices o menos (de 32 si tiene mas)
+struct MeshEmpacado {
+	const void* vertices;
+	const void* indices;
+	unsigned int numVertices;	// Vertices (no flotantes)
+	unsigned int numIndices;
+	FormatoVertice formato;
+	AABB aabb;					// Volumenes calculados con los vertices originales
+	EsferaEnvolvente esfera;
+
+	static bool usaIndices16(unsigned int numVertices) { return numVertices <= 65536; }
+	size_t getBytesVertices() const { return static_cast<size_t>(formato.getStride()) * numVertices; }
+	size_t getBytesIndices() const { return (usaIndices16(numVertices) ? sizeof(GLushort) : sizeof(GLuint)) * numIndices; }
+};
 
 class Mesh
 {
 public:
 	Mesh();
 
-	void CreateMesh(GLfloat *vertices, unsigned int *indices, unsigned int numOfVertices, unsigned int numOfIndices);
+	// Los vertices siempre llegan como 8 flotantes; se empacan segun el formato.
+	// Si el mesh tiene 65536 vertices o menos los indices se guardan en 16 bits
+	void CreateMesh(GLfloat *vertices, unsigned int *indices, unsigned int numOfVertices, unsigned int numOfIndices,
+		FormatoVertice formato = FormatoVertice());
+	// Crear los buffers con datos ya empacados, sin copias intermedias (cache de modelos)
+	void CreateMeshEmpacado(const MeshEmpacado& datos);
+
+	// Empacar vertices de 8 flotantes e indices de 32 bits en el formato de los buffers
+	static void Empacar(const GLfloat* vertices, unsigned int numOfVertices, const unsigned int* indices,
+		unsigned int numOfIndices, FormatoVertice formato,
+		std::vector<unsigned char>& datosVertices, std::vector<unsigned char>& datosIndices);
+	// Caja y esfera de las posiciones (8 flotantes por vertice)
+	static void CalcularVolumenes(const GLfloat* vertices, unsigned int numOfVertices, AABB& aabb, EsferaEnvolvente& esfera);
 	void RenderMesh();
+
+	// Ligar y dibujar por separado para que la cola de render evite binds repetidos
+	void BindMesh();
+	void DrawMesh();
+	static void UnbindMesh();
+
+	// Dibujar cantidad instancias con los datos de BufferDibujos a partir de primerDibujo
+	// (la base instance desplaza el atributo por instancia con el indice de dibujo)
+	void DrawMeshDibujos(GLuint primerDibujo, GLsizei cantidad);
+	// Ligar el buffer de indices de dibujo al VAO (debe estar ligado); solo se hace cuando
+	// cambia la generacion del buffer
+	void ConfigurarIndiceDibujo(GLuint bufferIndices, unsigned int generacion);
+	// Ubicacion del indice de dibujo en shader_light_dibujos.vert
+	static const GLuint ATRIBUTO_INDICE_DIBUJO = 7;
+	GLuint GetVAO() const { return VAO; }
+	GLsizei GetIndexCount() const { return indexCount; }
+
+	// Formato mas pequeno que conserva la precision de los vertices (8 flotantes por vertice)
+	static FormatoVertice elegirFormato(const GLfloat* vertices, unsigned int numOfVertices);
+
+	// Memoria de los buffers en GPU y la que ocuparian con floats e indices de 32 bits
+	size_t getBytesGPU() const { return bytesVBO + bytesIBO; }
+	size_t getBytesSinCompactar() const { return sizeof(GLfloat) * vertexCount + sizeof(unsigned int) * indexCount; }
+
+	// Conservar en memoria una copia de los buffers para hornear lotes estaticos sin leer
+	// de la GPU; se pide antes de CreateMesh
+	void ConservarGeometria() { conservarGeometria = true; }
+	bool tieneGeometria() const { return !copiaVertices.empty(); }
+	// Vertices (8 flotantes por vertice) e indices de la copia en memoria, desempacando
+	// el formato compacto
+	void LeerGeometria(std::vector<GLfloat>& vertices, std::vector<unsigned int>& indices) const;
 	void ClearMesh();
 
+	// Volumenes envolventes en espacio local, calculados al crear el mesh
+	const AABB& getAABB() const { return aabb; }
+	const EsferaEnvolvente& getEsfera() const { return esfera; }
+
 	~Mesh();
 
 private:
 	GLuint VAO, VBO, IBO;
 	GLsizei indexCount;
+	GLsizei vertexCount;	// Numero de flotantes de los vertices originales (8 por vertice)
+	FormatoVertice formato;
+	GLenum tipoIndice;		// GL_UNSIGNED_SHORT o GL_UNSIGNED_INT
+	size_t bytesVBO, bytesIBO;
+	unsigned int generacionIndiceDibujo;	// 0 = el VAO no tiene el atributo de indice
+	bool conservarGeometria;
+	std::vector<unsigned char> copiaVertices;	// Mismos bytes que el VBO y el IBO
+	std::vector<unsigned char> copiaIndices;
+	AABB aabb;
+	EsferaEnvolvente esfera;
 };
 
@@ -1,4 +1,16 @@
 #include "MeshManager.h"
+#include "OptimizadorMesh.h"
+
+namespace {
+	// Los meshes del manager son chicos y los usan entidades estaticas: se conserva su
+	// geometria en memoria para hornear los lotes
+	Mesh* nuevoMesh()
+	{
+		Mesh* mesh = new Mesh();
+		mesh->ConservarGeometria();
+		return mesh;
+	}
+}
 
 // Inicializa el MeshManager
 // Se cargan todos los meshes 
@@ -57,8 +69,11 @@ void MeshManager::createPiramideMesh()
 	// Calcular normales
 	calcAverageNormals(indices, 12, vertices, 32, 8, 5);
 
+	// Optimizar el orden de triangulos y vertices
+	OptimizadorMesh::optimizar(vertices, indices, 32, 12, "piramide");
+
 	// Crear el mesh
-	Mesh* piramideMesh = new Mesh();
+	Mesh* piramideMesh = nuevoMesh();
 	piramideMesh->CreateMesh(vertices, indices, 32, 12);
 	loadMesh(AssetConstants::MeshNames::PIRAMIDE, piramideMesh);
 }
@@ -78,8 +93,11 @@ void MeshManager::createPisoMesh()
 		10.0f, 0.0f, 10.0f,		10.0f, 10.0f,	0.0f, -1.0f, 0.0f
 	};
 
+	// Optimizar el orden de triangulos y vertices
+	OptimizadorMesh::optimizar(floorVertices, floorIndices, 32, 6, "piso");
+
 	// Crear el mesh
-	Mesh* pisoMesh = new Mesh();
+	Mesh* pisoMesh = nuevoMesh();
 	pisoMesh->CreateMesh(floorVertices, floorIndices, 32, 6);
 	loadMesh(AssetConstants::MeshNames::PISO, pisoMesh);
 }
@@ -109,8 +127,11 @@ void MeshManager::createVegetacionMesh()
 	// Calcular normales
 	calcAverageNormals(vegetacionIndices, 12, vegetacionVertices, 64, 8, 5);
 
+	// Optimizar el orden de triangulos y vertices
+	OptimizadorMesh::optimizar(vegetacionVertices, vegetacionIndices, 64, 12, "vegetacion");
+
 	// Crear el mesh
-	Mesh* vegetacionMesh = new Mesh();
+	Mesh* vegetacionMesh = nuevoMesh();
 	vegetacionMesh->CreateMesh(vegetacionVertices, vegetacionIndices, 64, 12);
 	loadMesh(AssetConstants::MeshNames::VEGETACION, vegetacionMesh);
 }
@@ -154,9 +175,11 @@ void MeshManager::createSphereMesh()
 	// Obtener los datos de la esfera en formato compatible con Mesh
 	std::vector<GLfloat> vertexData = sphere.getVertices();
 	std::vector<GLuint> indexData = sphere.getIndices();
+	// Optimizar el orden de triangulos y vertices
+	OptimizadorMesh::optimizar(vertexData, indexData, "esfera");
 	
 	// Crear el mesh usando los datos extrados
-	Mesh* sphereMesh = new Mesh();
+	Mesh* sphereMesh = nuevoMesh();
 	sphereMesh->CreateMesh(vertexData.data(), 
 	                       const_cast<unsigned int*>(indexData.data()), 
 	                       vertexData.size(), 
@@ -232,8 +255,11 @@ void MeshManager::createCaminoMesh()
 		 2.5f,  0.05f, -150.0f,   0.0f, 1.0f,    -1.0f, 0.0f, 0.0f   // 23
 	};
 
+	// Optimizar el orden de triangulos y vertices
+	OptimizadorMesh::optimizar(caminoVertices, caminoIndices, 192, 36, "camino");
+
 	// Crear el mesh
-	Mesh* caminoMesh = new Mesh();
+	Mesh* caminoMesh = nuevoMesh();
 	caminoMesh->CreateMesh(caminoVertices, caminoIndices, 192, 36);
 	loadMesh(AssetConstants::MeshNames::CAMINO, caminoMesh);
 }
@@ -303,8 +329,11 @@ void MeshManager::createPrismaAguaMesh()
 		 5.0f,  0.05f, -5.0f,   0.0f, 1.0f,   -1.0f, 0.0f, 0.0f   // 23
 	};
 
+	// Optimizar el orden de triangulos y vertices
+	OptimizadorMesh::optimizar(prismaVertices, prismaIndices, 192, 36, "prisma_agua");
+
 	// Crear el mesh
-	Mesh* prismaMesh = new Mesh();
+	Mesh* prismaMesh = nuevoMesh();
 	prismaMesh->CreateMesh(prismaVertices, prismaIndices, 192, 36);
 	loadMesh(AssetConstants::MeshNames::CHINAMPA_AGUA, prismaMesh);
 }
@@ -374,8 +403,11 @@ void MeshManager::createPrismaPequenoMesh()
 		 1.0f,  0.05f, -1.0f,   0.0f, 1.0f,   -1.0f, 0.0f, 0.0f   // 23
 	};
 
+	// Optimizar el orden de triangulos y vertices
+	OptimizadorMesh::optimizar(prismaVertices, prismaIndices, 192, 36, "prisma_pequeno");
+
 	// Crear el mesh
-	Mesh* prismaMesh = new Mesh();
+	Mesh* prismaMesh = nuevoMesh();
 	prismaMesh->CreateMesh(prismaVertices, prismaIndices, 192, 36);
 	loadMesh(AssetConstants::MeshNames::CHINAMPA_ISLA, prismaMesh);
 }
@@ -444,8 +476,11 @@ void MeshManager::createCanchaParedMesh()
 		-1.5f,  5.0f,  15.0f,   0.0f, 2.0f,   0.0f, 0.0f, -1.0f   // 23
 	};
 
+	// Optimizar el orden de triangulos y vertices
+	OptimizadorMesh::optimizar(paredVertices, paredIndices, 192, 36, "cancha_pared");
+
 	// Crear el mesh
-	Mesh* paredMesh = new Mesh();
+	Mesh* paredMesh = nuevoMesh();
 	paredMesh->CreateMesh(paredVertices, paredIndices, 192, 36);
 	loadMesh(AssetConstants::MeshNames::CANCHA_PARED, paredMesh);
 }
@@ -503,8 +538,11 @@ void MeshManager::createCanchaTechoMesh()
 		 0.0f,  8.0f,  15.0f,   0.0f, 1.0f,  0.0f, 0.0f, -1.0f   // 17
 	};
 
+	// Optimizar el orden de triangulos y vertices
+	OptimizadorMesh::optimizar(techoVertices, techoIndices, 144, 24, "cancha_techo");
+
 	// Crear el mesh
-	Mesh* techoMesh = new Mesh();
+	Mesh* techoMesh = nuevoMesh();
 	techoMesh->CreateMesh(techoVertices, techoIndices, 144, 24);
 	loadMesh(AssetConstants::MeshNames::CANCHA_TECHO, techoMesh);
 }
@@ -597,8 +635,11 @@ void MeshManager::createToroideMesh()
 		}
 	}
 	
+	// Optimizar el orden de triangulos y vertices
+	OptimizadorMesh::optimizar(vertices, indices, "toroide");
+
 	// Crear el mesh
-	Mesh* toroideMesh = new Mesh();
+	Mesh* toroideMesh = nuevoMesh();
 	toroideMesh->CreateMesh(vertices.data(), indices.data(), vertices.size(), indices.size());
 	loadMesh(AssetConstants::MeshNames::TOROIDE, toroideMesh);
 }
@@ -708,8 +749,11 @@ void MeshManager::createCilindroMesh()
 		indices.push_back(i * 2 + 1);
 	}
 	
+	// Optimizar el orden de triangulos y vertices
+	OptimizadorMesh::optimizar(vertices, indices, "cilindro");
+
 	// Crear el mesh
-	Mesh* cilindroMesh = new Mesh();
+	Mesh* cilindroMesh = nuevoMesh();
 	cilindroMesh->CreateMesh(vertices.data(), indices.data(), vertices.size(), indices.size());
 	loadMesh(AssetConstants::MeshNames::CILINDRO, cilindroMesh);
 }
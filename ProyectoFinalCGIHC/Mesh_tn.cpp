@@ -1,4 +1,6 @@
 #include "Mesh.h"
+#include <cstring>
+#include <gtc/packing.hpp>
 
 Mesh::Mesh()
 {
@@ -6,47 +8,310 @@ Mesh::Mesh()
 	VBO = 0;
 	IBO = 0;
 	indexCount = 0;
+	vertexCount = 0;
+	tipoIndice = GL_UNSIGNED_INT;
+	bytesVBO = 0;
+	bytesIBO = 0;
+	generacionIndiceDibujo = 0;
+	conservarGeometria = false;
 }
 
-void Mesh::CreateMesh(GLfloat *vertices, unsigned int *indices, unsigned int numOfVertices, unsigned int numOfIndices)
+namespace {
+	// Limites para guardar en half sin perder precision visible:
+	// cerca de 4 unidades el paso del half es ~0.002, y en UV de hasta 2 es ~1 texel en 1024
+	const float LIMITE_POSICION_HALF = 4.0f;
+	const float LIMITE_UV_HALF = 2.0f;
+
+	void escribir(std::vector<unsigned char>& destino, size_t& offset, const void* datos, size_t bytes)
+	{
+		memcpy(destino.data() + offset, datos, bytes);
+		offset += bytes;
+	}
+
+	void leer(const std::vector<unsigned char>& origen, size_t& offset, void* datos, size_t bytes)
+	{
+		memcpy(datos, origen.data() + offset, bytes);
+		offset += bytes;
+	}
+}
+
+GLsizei FormatoVertice::getStride() const
+{
+	return (posicionHalf ? 8 : 12) + (uvHalf ? 4 : 8) + (normalEmpacada ? 4 : 12);
+}
+
+FormatoVertice Mesh::elegirFormato(const GLfloat* vertices, unsigned int numOfVertices)
 {
-	indexCount = numOfIndices;
+	float maxPosicion = 0.0f;
+	float maxUV = 0.0f;
+	for (unsigned int i = 0; i + 7 < numOfVertices; i += 8)
+	{
+		for (int c = 0; c < 3; c++) maxPosicion = glm::max(maxPosicion, fabsf(vertices[i + c]));
+		for (int c = 3; c < 5; c++) maxUV = glm::max(maxUV, fabsf(vertices[i + c]));
+	}
+
+	FormatoVertice formato;
+	formato.posicionHalf = maxPosicion <= LIMITE_POSICION_HALF;
+	formato.uvHalf = maxUV <= LIMITE_UV_HALF;
+	formato.normalEmpacada = true;
+	return formato;
+}
+
+unsigned int FormatoVertice::getBits() const
+{
+	return (posicionHalf ? 1u : 0u) | (uvHalf ? 2u : 0u) | (normalEmpacada ? 4u : 0u);
+}
+
+FormatoVertice FormatoVertice::desdeBits(unsigned int bits)
+{
+	FormatoVertice formato;
+	formato.posicionHalf = (bits & 1u) != 0;
+	formato.uvHalf = (bits & 2u) != 0;
+	formato.normalEmpacada = (bits & 4u) != 0;
+	return formato;
+}
+
+void Mesh::Empacar(const GLfloat* vertices, unsigned int numOfVertices, const unsigned int* indices,
+	unsigned int numOfIndices, FormatoVertice formato,
+	std::vector<unsigned char>& datosVertices, std::vector<unsigned char>& datosIndices)
+{
+	unsigned int numVertices = numOfVertices / 8;
+	datosVertices.resize(static_cast<size_t>(formato.getStride()) * numVertices);
+	size_t offset = 0;
+	for (unsigned int v = 0; v < numVertices; v++)
+	{
+		const GLfloat* vertice = vertices + v * 8;
+		if (formato.posicionHalf) {
+			glm::uint16 posicion[4] = { glm::packHalf1x16(vertice[0]), glm::packHalf1x16(vertice[1]),
+										glm::packHalf1x16(vertice[2]), 0 };
+			escribir(datosVertices, offset, posicion, sizeof(posicion));
+		} else {
+			escribir(datosVertices, offset, vertice, sizeof(GLfloat) * 3);
+		}
+
+		if (formato.uvHalf) {
+			glm::uint32 uv = glm::packHalf2x16(glm::vec2(vertice[3], vertice[4]));
+			escribir(datosVertices, offset, &uv, sizeof(uv));
+		} else {
+			escribir(datosVertices, offset, vertice + 3, sizeof(GLfloat) * 2);
+		}
+
+		if (formato.normalEmpacada) {
+			// Se normaliza para aprovechar los 10 bits; el shader la vuelve a normalizar
+			glm::vec3 normal(vertice[5], vertice[6], vertice[7]);
+			float largo = glm::length(normal);
+			if (largo > 0.0f) normal /= largo;
+			glm::uint32 empacada = glm::packSnorm3x10_1x2(glm::vec4(normal, 0.0f));
+			escribir(datosVertices, offset, &empacada, sizeof(empacada));
+		} else {
+			escribir(datosVertices, offset, vertice + 5, sizeof(GLfloat) * 3);
+		}
+	}
+
+	// Con 65536 vertices o menos todos los indices caben en 16 bits
+	if (MeshEmpacado::usaIndices16(numVertices))
+	{
+		datosIndices.resize(sizeof(GLushort) * numOfIndices);
+		GLushort* indices16 = reinterpret_cast<GLushort*>(datosIndices.data());
+		for (unsigned int i = 0; i < numOfIndices; i++) indices16[i] = static_cast<GLushort>(indices[i]);
+	}
+	else
+	{
+		datosIndices.resize(sizeof(unsigned int) * numOfIndices);
+		if (numOfIndices > 0) memcpy(datosIndices.data(), indices, datosIndices.size());
+	}
+}
+
+void Mesh::CreateMesh(GLfloat *vertices, unsigned int *indices, unsigned int numOfVertices, unsigned int numOfIndices,
+	FormatoVertice formato)
+{
+	std::vector<unsigned char> datosVertices;
+	std::vector<unsigned char> datosIndices;
+	Empacar(vertices, numOfVertices, indices, numOfIndices, formato, datosVertices, datosIndices);
+
+	MeshEmpacado datos;
+	datos.vertices = datosVertices.data();
+	datos.indices = datosIndices.data();
+	datos.numVertices = numOfVertices / 8;
+	datos.numIndices = numOfIndices;
+	datos.formato = formato;
+	CalcularVolumenes(vertices, numOfVertices, datos.aabb, datos.esfera);
+	CreateMeshEmpacado(datos);
+}
+
+void Mesh::CreateMeshEmpacado(const MeshEmpacado& datos)
+{
+	indexCount = datos.numIndices;
+	vertexCount = datos.numVertices * 8;
+	formato = datos.formato;
+	aabb = datos.aabb;
+	esfera = datos.esfera;
+	tipoIndice = MeshEmpacado::usaIndices16(datos.numVertices) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+	bytesVBO = datos.getBytesVertices();
+	bytesIBO = datos.getBytesIndices();
+	GLsizei stride = formato.getStride();
+
+	if (conservarGeometria)
+	{
+		const unsigned char* bytesVertices = static_cast<const unsigned char*>(datos.vertices);
+		const unsigned char* bytesIndices = static_cast<const unsigned char*>(datos.indices);
+		copiaVertices.assign(bytesVertices, bytesVertices + bytesVBO);
+		copiaIndices.assign(bytesIndices, bytesIndices + bytesIBO);
+	}
 
 	glGenVertexArrays(1, &VAO);
 	glBindVertexArray(VAO);
 
 	glGenBuffers(1, &IBO);
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices[0]) * numOfIndices, indices, GL_STATIC_DRAW);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, bytesIBO, datos.indices, GL_STATIC_DRAW);
 
 	glGenBuffers(1, &VBO);
 	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices[0]) * numOfVertices, vertices, GL_STATIC_DRAW);
+	glBufferData(GL_ARRAY_BUFFER, bytesVBO, datos.vertices, GL_STATIC_DRAW);
 	//geometra
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(vertices[0]) * 8, 0);
+	GLsizei offsetUV = formato.posicionHalf ? 8 : 12;
+	GLsizei offsetNormal = offsetUV + (formato.uvHalf ? 4 : 8);
+	glVertexAttribPointer(0, 3, formato.posicionHalf ? GL_HALF_FLOAT : GL_FLOAT, GL_FALSE, stride, 0);
 	glEnableVertexAttribArray(0);
 	//ST: Texturizado
-	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(vertices[0]) * 8, (void*)(sizeof(vertices[0]) * 3));
+	glVertexAttribPointer(1, 2, formato.uvHalf ? GL_HALF_FLOAT : GL_FLOAT, GL_FALSE, stride, (void*)(intptr_t)offsetUV);
 	glEnableVertexAttribArray(1);
 	//Normales en vrtices
-	glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(vertices[0]) * 8, (void*)(sizeof(vertices[0]) * 5));
+	if (formato.normalEmpacada) {
+		glVertexAttribPointer(2, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride, (void*)(intptr_t)offsetNormal);
+	} else {
+		glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, (void*)(intptr_t)offsetNormal);
+	}
 	glEnableVertexAttribArray(2);
 
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
+	// El IBO se queda guardado en el VAO, por eso se desliga despues del VAO
 	glBindVertexArray(0);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+// Calcula la caja y la esfera a partir de las posiciones (8 flotantes por vertice)
+void Mesh::CalcularVolumenes(const GLfloat* vertices, unsigned int numOfVertices, AABB& aabb, EsferaEnvolvente& esfera)
+{
+	aabb = AABB();
+	for (unsigned int i = 0; i + 2 < numOfVertices; i += 8)
+	{
+		aabb.expandir(glm::vec3(vertices[i], vertices[i + 1], vertices[i + 2]));
+	}
+
+	esfera = EsferaEnvolvente();
+	if (!aabb.valido) return;
+
+	// La esfera se centra en la caja y su radio es la distancia al vertice mas lejano
+	esfera.centro = aabb.getCentro();
+	float radio2 = 0.0f;
+	for (unsigned int i = 0; i + 2 < numOfVertices; i += 8)
+	{
+		glm::vec3 d = glm::vec3(vertices[i], vertices[i + 1], vertices[i + 2]) - esfera.centro;
+		radio2 = glm::max(radio2, glm::dot(d, d));
+	}
+	esfera.radio = sqrtf(radio2);
+	esfera.valido = true;
 }
 
 void Mesh::RenderMesh()
+{
+	BindMesh();
+	DrawMesh();
+	UnbindMesh();
+}
+
+void Mesh::BindMesh()
 {
 	glBindVertexArray(VAO);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
-	glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+void Mesh::DrawMesh()
+{
+	glDrawElements(GL_TRIANGLES, indexCount, tipoIndice, 0);
+}
+
+void Mesh::UnbindMesh()
+{
 	glBindVertexArray(0);
 }
 
+void Mesh::DrawMeshDibujos(GLuint primerDibujo, GLsizei cantidad)
+{
+	glDrawElementsInstancedBaseInstance(GL_TRIANGLES, indexCount, tipoIndice, 0, cantidad, primerDibujo);
+}
+
+// El atributo queda guardado en el VAO; los shaders que no lo declaran lo ignoran
+void Mesh::ConfigurarIndiceDibujo(GLuint bufferIndices, unsigned int generacion)
+{
+	if (generacionIndiceDibujo == generacion) return;
+
+	glBindBuffer(GL_ARRAY_BUFFER, bufferIndices);
+	glVertexAttribIPointer(ATRIBUTO_INDICE_DIBUJO, 1, GL_UNSIGNED_INT, sizeof(GLuint), (void*)0);
+	glEnableVertexAttribArray(ATRIBUTO_INDICE_DIBUJO);
+	glVertexAttribDivisor(ATRIBUTO_INDICE_DIBUJO, 1);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	generacionIndiceDibujo = generacion;
+}
+
+void Mesh::LeerGeometria(std::vector<GLfloat>& vertices, std::vector<unsigned int>& indices) const
+{
+	if (!tieneGeometria())
+	{
+		vertices.clear();
+		indices.clear();
+		return;
+	}
+	vertices.resize(vertexCount);
+	indices.resize(indexCount);
+	const std::vector<unsigned char>& datosVertices = copiaVertices;
+	const std::vector<unsigned char>& datosIndices = copiaIndices;
+
+	// Desempacar al formato de 8 flotantes
+	size_t offset = 0;
+	for (GLsizei i = 0; i + 7 < vertexCount; i += 8)
+	{
+		GLfloat* vertice = &vertices[i];
+		if (formato.posicionHalf) {
+			glm::uint16 posicion[4];
+			leer(datosVertices, offset, posicion, sizeof(posicion));
+			for (int c = 0; c < 3; c++) vertice[c] = glm::unpackHalf1x16(posicion[c]);
+		} else {
+			leer(datosVertices, offset, vertice, sizeof(GLfloat) * 3);
+		}
+
+		if (formato.uvHalf) {
+			glm::uint32 uv;
+			leer(datosVertices, offset, &uv, sizeof(uv));
+			glm::vec2 st = glm::unpackHalf2x16(uv);
+			vertice[3] = st.x;
+			vertice[4] = st.y;
+		} else {
+			leer(datosVertices, offset, vertice + 3, sizeof(GLfloat) * 2);
+		}
+
+		if (formato.normalEmpacada) {
+			glm::uint32 empacada;
+			leer(datosVertices, offset, &empacada, sizeof(empacada));
+			glm::vec4 normal = glm::unpackSnorm3x10_1x2(empacada);
+			vertice[5] = normal.x;
+			vertice[6] = normal.y;
+			vertice[7] = normal.z;
+		} else {
+			leer(datosVertices, offset, vertice + 5, sizeof(GLfloat) * 3);
+		}
+	}
+
+	if (tipoIndice == GL_UNSIGNED_SHORT) {
+		const GLushort* indices16 = reinterpret_cast<const GLushort*>(datosIndices.data());
+		indices.assign(indices16, indices16 + indexCount);
+	} else if (indexCount > 0) {
+		memcpy(indices.data(), datosIndices.data(), bytesIBO);
+	}
+}
+
 void Mesh::ClearMesh()
 {
 	if (IBO != 0)
@@ -68,6 +333,13 @@ void Mesh::ClearMesh()
 	}
 
 	indexCount = 0;
+	vertexCount = 0;
+	bytesVBO = 0;
+	bytesIBO = 0;
+	generacionIndiceDibujo = 0;
+	// swap para devolver la memoria (clear conserva la capacidad)
+	std::vector<unsigned char>().swap(copiaVertices);
+	std::vector<unsigned char>().swap(copiaIndices);
 }
 
 
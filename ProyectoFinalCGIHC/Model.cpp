@@ -1,25 +1,202 @@
 #include "Model.h"
+#include "CacheTexturas.h"
+#include "OptimizadorMesh.h"
+#include "SimplificadorMesh.h"
 #include <iostream>
+#include <algorithm>
+#include <assimp/DefaultIOSystem.h>
 
+// Desviacion permitida en cada nivel de LOD como fraccion del radio del mesh. SceneRenderer
+// cambia de nivel cuando el modelo cubre menos pantalla, asi el error queda en pocos pixeles
+static const float ERROR_LOD[Model::NIVELES_LOD] = { 0.0f, 0.01f, 0.03f, 0.08f };
+// Los meshes mas chicos no se simplifican
+static const unsigned int MIN_TRIANGULOS_LOD = 64;
+// Un nivel que no quita al menos esta fraccion de triangulos al anterior no vale la memoria
+static const float REDUCCION_MINIMA_LOD = 0.8f;
+
+namespace {
+// Sistema de archivos de Assimp que anota cada archivo que abre el importador (el .mtl de un
+// .obj, por ejemplo) para sellar el cache con ellos
+class IORegistrado : public Assimp::DefaultIOSystem {
+public:
+	explicit IORegistrado(std::vector<std::string>& archivos) : archivos(archivos) {}
+
+	Assimp::IOStream* Open(const char* pFile, const char* pMode = "rb") override
+	{
+		archivos.push_back(pFile);
+		return Assimp::DefaultIOSystem::Open(pFile, pMode);
+	}
+
+private:
+	std::vector<std::string>& archivos;
+};
+}
 
 
 Model::Model()
 {
+	desdeCache = false;
+	conservarGeometria = false;
 }
 
 void Model::LoadModel(const std::string & fileName)
 {
+	if (ImportarModelo(fileName))
+	{
+		SubirModelo();
+	}
+}
+
+bool Model::ImportarModelo(const std::string & fileName)
+{
+	// Si el cache binario esta al dia la geometria y las texturas resueltas salen de ahi
+	desdeCache = cache.abrir(fileName);
+	if (desdeCache)
+	{
+		const std::vector<TexturaCache>& texturas = cache.getTexturas();
+		TextureList.resize(texturas.size());
+		for (unsigned int i = 0; i < texturas.size(); i++)
+		{
+			TextureList[i] = CacheTexturas::instancia().adquirir(texturas[i].ruta, texturas[i].alfa);
+		}
+		return true;
+	}
+
+	dependencias.clear();
 	Assimp::Importer importer;//					Pasa de Polygons y Quads a triangulos, modifica orden para el origen, generar normales si el  objeto no tiene, trata vrtices iguales como 1 solo
+	// El importador se queda con el sistema de archivos y lo libera al destruirse
+	importer.SetIOHandler(new IORegistrado(dependencias));
 	//const aiScene *scene=importer.ReadFile(fileName,aiProcess_Triangulate |aiProcess_FlipUVs|aiProcess_GenSmoothNormals|aiProcess_JoinIdenticalVertices);
 	const aiScene *scene = importer.ReadFile(fileName, aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_JoinIdenticalVertices);
 	if (!scene)
 	{	
 		printf("Fall en cargar el modelo: %s \n", fileName.c_str(), importer.GetErrorString());
-		return;
+		return false;
 	}
 	LoadNode(scene->mRootNode, scene);
 	LoadMaterials(scene);
+
+	// Se optimiza antes de escribir el cache para que los arranques en caliente no lo repitan
+	GenerarLODs(fileName);
+	EmpacarPendientes();
+
+	std::vector<TexturaCache> texturas;
+	for (unsigned int i = 0; i < TextureList.size(); i++)
+	{
+		if (TextureList[i])
+		{
+			texturas.push_back({ TextureList[i]->GetFileLocation(), TextureList[i]->GetAlfa() });
+		}
+		else
+		{
+			texturas.push_back({ "Textures/plain.png", true });
+		}
+	}
+	// Varios materiales pueden compartir textura y Assimp tambien abre el propio modelo
+	std::sort(dependencias.begin(), dependencias.end());
+	dependencias.erase(std::unique(dependencias.begin(), dependencias.end()), dependencias.end());
+	if (!CacheModelo::escribir(fileName, geometriaPendiente(), texturas, dependencias))
+	{
+		printf("No se pudo escribir el cache del modelo: %s\n", fileName.c_str());
+	}
+	return true;
+}
+
+std::vector<MeshCache> Model::geometriaPendiente() const
+{
+	std::vector<MeshCache> geometria;
+	geometria.reserve(meshesPendientes.size());
+	for (unsigned int i = 0; i < meshesPendientes.size(); i++)
+	{
+		const MeshPendiente& pendiente = meshesPendientes[i];
+		MeshCache mesh;
+		mesh.geometria.vertices = pendiente.datosVertices.data();
+		mesh.geometria.indices = pendiente.datosIndices.data();
+		mesh.geometria.numVertices = (unsigned int)(pendiente.datosVertices.size() / pendiente.formato.getStride());
+		mesh.geometria.numIndices = (unsigned int)(pendiente.datosIndices.size() /
+			(MeshEmpacado::usaIndices16(mesh.geometria.numVertices) ? sizeof(GLushort) : sizeof(GLuint)));
+		mesh.geometria.formato = pendiente.formato;
+		mesh.geometria.aabb = pendiente.aabb;
+		mesh.geometria.esfera = pendiente.esfera;
+		mesh.materialIndex = pendiente.materialIndex;
+		mesh.nivelLOD = pendiente.nivelLOD;
+		geometria.push_back(mesh);
+	}
+	return geometria;
+}
+
+void Model::EmpacarPendientes()
+{
+	for (MeshPendiente& pendiente : meshesPendientes)
+	{
+		unsigned int numFlotantes = (unsigned int)pendiente.vertices.size();
+		pendiente.formato = Mesh::elegirFormato(pendiente.vertices.data(), numFlotantes);
+		Mesh::CalcularVolumenes(pendiente.vertices.data(), numFlotantes, pendiente.aabb, pendiente.esfera);
+		Mesh::Empacar(pendiente.vertices.data(), numFlotantes, pendiente.indices.data(), (unsigned int)pendiente.indices.size(),
+			pendiente.formato, pendiente.datosVertices, pendiente.datosIndices);
+		std::vector<GLfloat>().swap(pendiente.vertices);
+		std::vector<unsigned int>().swap(pendiente.indices);
+	}
+}
+
+void Model::SubirModelo()
+{
+	// Desde el cache los buffers ya empacados se suben directo de la mapping, sin copias intermedias
+	std::vector<MeshCache> geometria = desdeCache ? cache.getMeshes() : geometriaPendiente();
+	for (unsigned int i = 0; i < geometria.size(); i++)
+	{
+		const MeshCache& pendiente = geometria[i];
+		Mesh* newMesh = new Mesh();
+		// Los lotes estaticos solo copian la geometria completa
+		if (conservarGeometria && pendiente.nivelLOD == 0)
+		{
+			newMesh->ConservarGeometria();
+		}
+		newMesh->CreateMeshEmpacado(pendiente.geometria);
+		// Los niveles simplificados vienen justo despues de su mesh base
+		if (pendiente.nivelLOD > 0 && !LODList.empty())
+		{
+			LODList.back().push_back(newMesh);
+			continue;
+		}
+		MeshList.push_back(newMesh);
+		LODList.push_back(std::vector<Mesh*>());
+		aabb.expandir(newMesh->getAABB());
+		meshTotex.push_back(pendiente.materialIndex);
 	}
+	meshesPendientes.clear();
+	cache.cerrar();
+
+	for (unsigned int i = 0; i < TextureList.size(); i++)
+	{
+		// Las texturas compartidas solo se suben la primera vez
+		CacheTexturas::instancia().subir(TextureList[i]);
+	}
+
+	// La esfera del modelo se centra en la caja total y envuelve las esferas de cada mesh
+	esfera = EsferaEnvolvente();
+	if (aabb.valido)
+	{
+		esfera.centro = aabb.getCentro();
+		for (unsigned int i = 0; i < MeshList.size(); i++)
+		{
+			const EsferaEnvolvente& esferaMesh = MeshList[i]->getEsfera();
+			if (esferaMesh.valido)
+			{
+				esfera.radio = glm::max(esfera.radio, glm::distance(esfera.centro, esferaMesh.centro) + esferaMesh.radio);
+			}
+		}
+		esfera.valido = true;
+	}
+	}
+
+void Model::DescargarModelo()
+{
+	ClearModel();
+	meshesPendientes.clear();
+	cache.cerrar();
+	desdeCache = false;
+}
 
 void Model::ClearModel()
 {
@@ -37,10 +214,21 @@ void Model::ClearModel()
 	{
 		if (TextureList[i])
 		{
-			delete TextureList[i];
+			CacheTexturas::instancia().liberar(TextureList[i]);
 			TextureList[i] = nullptr;
 		}
 	}
+	for (unsigned int i = 0; i < LODList.size(); i++)
+	{
+		for (Mesh* lod : LODList[i])
+		{
+			delete lod;
+		}
+	}
+	MeshList.clear();
+	LODList.clear();
+	TextureList.clear();
+	meshTotex.clear();
 
 }
 
@@ -48,10 +236,10 @@ void Model::RenderModel()
 {
 	for (unsigned int i = 0; i < MeshList.size(); i++)
 	{
-		unsigned int materialIndex = meshTotex[i];
-		if (!materialIndex< TextureList.size()&& TextureList[materialIndex])
+		Texture* textura = getTexturaMesh(i);
+		if (textura)
 		{
-			TextureList[materialIndex]->UseTexture();
+			textura->UseTexture();
 		}
 		MeshList[i]->RenderMesh();
 
@@ -60,6 +248,26 @@ void Model::RenderModel()
 
 }
 
+Texture* Model::getTexturaMesh(unsigned int i) const
+{
+	// Se conserva la condicion original con la que se decidia si ligar la textura del mesh
+	unsigned int materialIndex = meshTotex[i];
+	if (!materialIndex< TextureList.size()&& TextureList[materialIndex])
+	{
+		return TextureList[materialIndex];
+	}
+	return nullptr;
+}
+
+
+Mesh* Model::getMeshLOD(unsigned int i, unsigned int nivel) const
+{
+	if (nivel == 0 || LODList[i].empty())
+	{
+		return MeshList[i];
+	}
+	return LODList[i][glm::min<size_t>(nivel, LODList[i].size()) - 1];
+}
 
 Model::~Model()
 {
@@ -107,10 +315,59 @@ void Model::LoadMesh(aiMesh * mesh, const aiScene * scene)
 		}
 	}
 
-	Mesh* newMesh = new Mesh();
-	newMesh->CreateMesh(&vertices[0], &indices[0], vertices.size(), indices.size());
-	MeshList.push_back(newMesh);
-	meshTotex.push_back(mesh->mMaterialIndex);
+	// Los buffers se crean despues en SubirModelo, en el hilo de OpenGL
+	MeshPendiente pendiente;
+	pendiente.vertices.swap(vertices);
+	pendiente.indices.swap(indices);
+	pendiente.materialIndex = mesh->mMaterialIndex;
+	pendiente.nivelLOD = 0;
+	meshesPendientes.push_back(std::move(pendiente));
+}
+
+void Model::GenerarLODs(const std::string& fileName)
+{
+	std::vector<MeshPendiente> conLODs;
+	for (unsigned int i = 0; i < meshesPendientes.size(); i++)
+	{
+		MeshPendiente& base = meshesPendientes[i];
+		std::string nombre = fileName + "[" + std::to_string(i) + "]";
+		OptimizadorMesh::optimizar(base.vertices, base.indices, nombre.c_str());
+
+		AABB caja;
+		for (size_t v = 0; v + 2 < base.vertices.size(); v += 8)
+		{
+			caja.expandir(glm::vec3(base.vertices[v], base.vertices[v + 1], base.vertices[v + 2]));
+		}
+		float radio = glm::length(caja.getExtension());
+
+		// Cada nivel parte de la geometria completa con la mitad de triangulos que el anterior
+		std::vector<MeshPendiente> niveles;
+		size_t indicesAnterior = base.indices.size();
+		for (unsigned int nivel = 1; nivel < NIVELES_LOD; nivel++)
+		{
+			if (indicesAnterior / 3 < MIN_TRIANGULOS_LOD) break;
+
+			MeshPendiente lod;
+			lod.indices = SimplificadorMesh::simplificar(base.vertices.data(), (unsigned int)base.vertices.size(),
+				base.indices, base.indices.size() >> nivel, ERROR_LOD[nivel] * radio);
+			if (lod.indices.empty() || lod.indices.size() > indicesAnterior * REDUCCION_MINIMA_LOD) break;
+
+			lod.vertices = base.vertices;
+			lod.materialIndex = base.materialIndex;
+			lod.nivelLOD = nivel;
+			std::string nombreLOD = nombre + " LOD" + std::to_string(nivel);
+			OptimizadorMesh::optimizar(lod.vertices, lod.indices, nombreLOD.c_str());
+			indicesAnterior = lod.indices.size();
+			niveles.push_back(std::move(lod));
+		}
+
+		conLODs.push_back(std::move(base));
+		for (auto& lod : niveles)
+		{
+			conLODs.push_back(std::move(lod));
+		}
+	}
+	meshesPendientes.swap(conLODs);
 }
 
 void Model::LoadMaterials(const aiScene * scene)
@@ -150,31 +407,21 @@ void Model::LoadMaterials(const aiScene * scene)
 				std::size_t existetga = filename.find(tga);
 				std::size_t existepng= filename.find(png);
 				std::string texPath = std::string("Textures/") + filename;
-				TextureList[i] = new Texture(texPath.c_str());
-				if (existetga != std::string::npos || existepng != std::string::npos)
-				{
-					if (!TextureList[i]->LoadTextureA())
-					{
-						printf("Fall en cargar la Textura :%s\n", texPath.c_str());
-						delete TextureList[i];
-						TextureList[i] = nullptr;
-					}
-				}
-				else
+				// Se anota aunque no exista: si despues aparece, el cache con plain.png ya no sirve
+				dependencias.push_back(texPath);
+				// Los archivos que ya se cargaron para otro modelo salen del cache compartido
+				bool alfa = existetga != std::string::npos || existepng != std::string::npos;
+				TextureList[i] = CacheTexturas::instancia().adquirir(texPath, alfa);
+				if (!TextureList[i])
 				{
-					if (!TextureList[i]->LoadTexture())
-					{
-						printf("Fall en cargar la Textura :%s\n", texPath.c_str());
-						delete TextureList[i];
-						TextureList[i] = nullptr;
-					}
+					printf("Fall en cargar la Textura :%s\n", texPath.c_str());
 				}
 			}
 		}
 		if (!TextureList[i])
 		{
-			TextureList[i] = new Texture("Textures/plain.png"); //textura que se aplicar a los modelos si no tienen textura o la textura no se puede cargar
-			TextureList[i]->LoadTextureA();
+			dependencias.push_back("Textures/plain.png");
+			TextureList[i] = CacheTexturas::instancia().adquirir("Textures/plain.png", true); //textura que se aplicar a los modelos si no tienen textura o la textura no se puede cargar
 		}
 
 	}
@@ -7,24 +7,86 @@
 
 #include "Mesh.h"
 #include "Texture.h"
+#include "CacheModelo.h"
 
 class Model
 {
 public:
+	// Niveles de detalle por mesh, contando la geometria completa (nivel 0)
+	static const unsigned int NIVELES_LOD = 4;
+
 	Model();
 
 	void LoadModel(const std::string& fileName);
+	// Carga en dos fases: ImportarModelo lee el archivo con Assimp y decodifica las texturas
+	// sin tocar OpenGL (se puede llamar desde un hilo de trabajo); SubirModelo crea los
+	// buffers y las texturas en el hilo de OpenGL
+	bool ImportarModelo(const std::string& fileName);
+	void SubirModelo();
+	// Liberar los buffers y soltar las texturas; los volumenes se conservan para el culling
+	void DescargarModelo();
+	// false mientras el modelo no tenga sus meshes en la GPU (carga bajo demanda)
+	bool estaResidente() const { return !MeshList.empty(); }
 	void RenderModel();
 	void ClearModel();
 
+	// Los meshes completos guardan una copia en memoria para hornearlos en lotes estaticos
+	// (se pide antes de subir el modelo)
+	void ConservarGeometria() { conservarGeometria = true; }
+
+	// true si la geometria se leyo del cache binario en vez de importarse con Assimp
+	bool cargadoDesdeCache() const { return desdeCache; }
+
+	// Volumenes envolventes de todos los meshes del modelo
+	const AABB& getAABB() const { return aabb; }
+	const EsferaEnvolvente& getEsfera() const { return esfera; }
+
+	// Acceso a los meshes para la cola de render
+	unsigned int getNumMeshes() const { return (unsigned int)MeshList.size(); }
+	Mesh* getMesh(unsigned int i) const { return MeshList[i]; }
+	// Version simplificada del mesh; si no se genero ese nivel se devuelve el mas cercano
+	Mesh* getMeshLOD(unsigned int i, unsigned int nivel) const;
+	// Textura que RenderModel liga para el mesh (nullptr si no liga ninguna)
+	Texture* getTexturaMesh(unsigned int i) const;
+
 	~Model();
 
 private:
+	// Geometria de un mesh leida por Assimp que aun no esta en la GPU
+	struct MeshPendiente {
+		std::vector<GLfloat> vertices;
+		std::vector<unsigned int> indices;
+		unsigned int materialIndex;
+		unsigned int nivelLOD;
+		// Buffers ya empacados (EmpacarPendientes libera los vertices e indices originales)
+		std::vector<unsigned char> datosVertices;
+		std::vector<unsigned char> datosIndices;
+		FormatoVertice formato;
+		AABB aabb;
+		EsferaEnvolvente esfera;
+	};
+
 	void LoadNode(aiNode* node, const aiScene* scene); //assimp
 	void LoadMesh(aiMesh* mesh, const aiScene* scene);
 	void LoadMaterials(const aiScene* scene);
+	// Optimiza los meshes importados y agrega despues de cada uno sus niveles simplificados
+	void GenerarLODs(const std::string& fileName);
+	// Empacar cada mesh en el formato compacto que admita su geometria, fuera del hilo de OpenGL
+	void EmpacarPendientes();
+	// Geometria importada por Assimp vista como los meshes del cache
+	std::vector<MeshCache> geometriaPendiente() const;
 	std::vector<Mesh*>MeshList;
+	std::vector<std::vector<Mesh*>>LODList;	// LODList[i][n - 1] = nivel n del mesh i
 	std::vector<Texture*>TextureList;
+	// Archivos que leyo o busco la importacion ademas del modelo (.mtl, texturas); sellan el cache
+	std::vector<std::string> dependencias;
 	std::vector<unsigned int>meshTotex;
+	std::vector<MeshPendiente> meshesPendientes;
+	// Cache mapeado del que se suben los buffers cuando el modelo no paso por Assimp
+	CacheModelo cache;
+	bool desdeCache;
+	bool conservarGeometria;
+	AABB aabb;
+	EsferaEnvolvente esfera;
 };
 
@@ -1,4 +1,8 @@
 #include "ModelManager.h"
+#include "PoolHilos.h"
+#include "ReporteCarga.h"
+#include <algorithm>
+#include <cstdio>
 
 // Carga todos los modelos al inicializar el ModelManager
 ModelManager::ModelManager()
@@ -103,12 +107,69 @@ ModelManager::ModelManager()
 	loadModel(AssetConstants::ModelNames::PEZ, AssetConstants::ModelPaths::PEZ);
 }
 
-// Carga un modelo en el manager
+// Registra un modelo para cargarlo con los demas
+// El apuntador ya es valido aunque la geometria se cargue despues
 void ModelManager::loadModel(const std::string& modelName, const std::string& modelPath)
 {
 	Model* model = new Model();
-	model->LoadModel(modelPath);
 	models[modelName] = model;
+	rutas[modelName] = modelPath;
+	pendientes.push_back({ modelName, modelPath, model, false, 0.0 });
+}
+
+// Importa los modelos registrados en hilos de trabajo y los sube a la GPU en orden
+void ModelManager::cargarModelos(const std::set<std::string>& bajoDemanda)
+{
+	auto inicio = std::chrono::steady_clock::now();
+	ReporteCarga reporte("ModelManager");
+	PoolHilos pool;
+
+	pendientes.erase(std::remove_if(pendientes.begin(), pendientes.end(),
+		[&bajoDemanda](const CargaPendiente& carga) { return bajoDemanda.count(carga.nombre) > 0; }),
+		pendientes.end());
+
+	// Assimp y stb no usan OpenGL, asi que cada modelo se importa en su propio hilo
+	std::vector<std::future<void>> importaciones;
+	importaciones.reserve(pendientes.size());
+	for (auto& carga : pendientes) {
+		CargaPendiente* pendiente = &carga;
+		importaciones.push_back(pool.encolar([pendiente]() {
+			auto inicioCpu = std::chrono::steady_clock::now();
+			pendiente->importado = pendiente->modelo->ImportarModelo(pendiente->ruta);
+			pendiente->msCpu = ReporteCarga::msDesde(inicioCpu);
+		}));
+	}
+
+	// Mientras se sube un modelo los hilos siguen importando los siguientes
+	size_t bytesGPU = 0;
+	size_t bytesSinCompactar = 0;
+	for (size_t i = 0; i < pendientes.size(); i++) {
+		importaciones[i].get();
+		CargaPendiente& carga = pendientes[i];
+
+		auto inicioGpu = std::chrono::steady_clock::now();
+		if (carga.importado) {
+			carga.modelo->SubirModelo();
+			for (unsigned int m = 0; m < carga.modelo->getNumMeshes(); m++) {
+				bytesGPU += carga.modelo->getMesh(m)->getBytesGPU();
+				bytesSinCompactar += carga.modelo->getMesh(m)->getBytesSinCompactar();
+			}
+		}
+		reporte.agregar(carga.modelo->cargadoDesdeCache() ? carga.nombre + " (cache)" : carga.nombre,
+			carga.msCpu, ReporteCarga::msDesde(inicioGpu));
+	}
+
+	reporte.imprimir(ReporteCarga::msDesde(inicio), pool.getNumHilos());
+	printf("[ModelManager] Geometria en GPU: %.2f MB (%.2f MB sin compactar)\n",
+		bytesGPU / (1024.0 * 1024.0), bytesSinCompactar / (1024.0 * 1024.0));
+	pendientes.clear();
+}
+
+const std::string& ModelManager::getRutaModelo(const std::string& modelName) const
+{
+	static const std::string vacia;
+	auto it = rutas.find(modelName);
+	return it != rutas.end() ? it->second : vacia;
 }
 
 // Obtiene un modelo por su nombre (retorna apuntador)
@@ -2,6 +2,8 @@
 #include "AssetConstants.h"
 #include "Model.h"
 #include <map>
+#include <vector>
+#include <set>
 
 // Clase para gestionar los modelos
 class ModelManager
@@ -12,12 +14,29 @@ public:
 
 	// Mtodo para obtener un modelo
 	Model* getModel(const std::string& modelName);
+	const std::string& getRutaModelo(const std::string& modelName) const;
+
+	// Cargar los modelos registrados, menos los que se cargan bajo demanda por zonas
+	// (esos quedan registrados sin geometria hasta que el GestorResidencia los pide)
+	void cargarModelos(const std::set<std::string>& bajoDemanda);
 	
 
 	~ModelManager();
 
 private:
 	std::map<std::string, Model*> models;
+	std::map<std::string, std::string> rutas;
+
+	// loadModel solo registra el modelo; cargarModelos importa en paralelo
+	// y sube a la GPU en el hilo principal
+	struct CargaPendiente {
+		std::string nombre;
+		std::string ruta;
+		Model* modelo;
+		bool importado;
+		double msCpu;
+	};
+	std::vector<CargaPendiente> pendientes;
 
 	void loadModel(const std::string& modelName, const std::string& modelPath);
 
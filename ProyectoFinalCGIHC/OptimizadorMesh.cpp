@@ -0,0 +1,274 @@
+#include "OptimizadorMesh.h"
+#include <glm.hpp>
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+const unsigned int FLOTANTES_POR_VERTICE = 8;
+const unsigned int SIN_ASIGNAR = 0xFFFFFFFFu;
+
+glm::vec3 posicion(const float* vertices, unsigned int indice)
+{
+    const float* v = vertices + static_cast<size_t>(indice) * FLOTANTES_POR_VERTICE;
+    return glm::vec3(v[0], v[1], v[2]);
+}
+
+// Rango de indices de un grupo de triangulos y que tanto mira hacia afuera del mesh
+struct Cluster {
+    size_t inicio;
+    size_t fin;
+    float orientacion;
+};
+
+}
+
+namespace OptimizadorMesh {
+
+float calcularACMR(const unsigned int* indices, size_t numIndices, unsigned int numVertices,
+                   unsigned int tamanoCache)
+{
+    size_t numTriangulos = numIndices / 3;
+    if (numTriangulos == 0) return 0.0f;
+
+    // Un vertice esta en el cache FIFO si entro hace menos de tamanoCache fallos
+    std::vector<unsigned int> entrada(numVertices, 0);
+    unsigned int fallos = 0;
+    unsigned int reloj = tamanoCache + 1;
+    for (size_t i = 0; i < numTriangulos * 3; i++) {
+        unsigned int v = indices[i];
+        if (reloj - entrada[v] > tamanoCache) {
+            entrada[v] = reloj++;
+            fallos++;
+        }
+    }
+    return static_cast<float>(fallos) / static_cast<float>(numTriangulos);
+}
+
+void ordenarParaCache(unsigned int* indices, size_t numIndices, unsigned int numVertices,
+                      std::vector<size_t>* clusters)
+{
+    size_t numTriangulos = numIndices / 3;
+    if (clusters != nullptr) clusters->clear();
+    if (numTriangulos == 0) return;
+
+    // Triangulos que usan cada vertice, en una sola lista con desplazamientos
+    std::vector<unsigned int> vivos(numVertices, 0);
+    for (size_t i = 0; i < numTriangulos * 3; i++) {
+        vivos[indices[i]]++;
+    }
+    std::vector<unsigned int> inicio(numVertices + 1, 0);
+    for (unsigned int v = 0; v < numVertices; v++) {
+        inicio[v + 1] = inicio[v] + vivos[v];
+    }
+    std::vector<unsigned int> adyacencia(inicio[numVertices]);
+    std::vector<unsigned int> cursor(inicio.begin(), inicio.end() - 1);
+    for (size_t t = 0; t < numTriangulos; t++) {
+        for (int k = 0; k < 3; k++) {
+            adyacencia[cursor[indices[t * 3 + k]]++] = static_cast<unsigned int>(t);
+        }
+    }
+
+    std::vector<unsigned int> tiempo(numVertices, 0);
+    std::vector<char> emitido(numTriangulos, 0);
+    std::vector<unsigned int> callejones;     // Vertices recientes para continuar sin saltar lejos
+    std::vector<unsigned int> candidatos;
+    std::vector<unsigned int> resultado;
+    resultado.reserve(numTriangulos * 3);
+    unsigned int reloj = TAMANO_CACHE + 1;
+    unsigned int secuencial = 0;
+
+    // Cuando no hay candidato se sigue con un vertice reciente o con el siguiente en orden
+    auto saltarCallejon = [&]() -> int {
+        while (!callejones.empty()) {
+            unsigned int v = callejones.back();
+            callejones.pop_back();
+            if (vivos[v] > 0) return static_cast<int>(v);
+        }
+        while (secuencial < numVertices) {
+            if (vivos[secuencial] > 0) return static_cast<int>(secuencial);
+            secuencial++;
+        }
+        return -1;
+    };
+
+    int abanico = saltarCallejon();
+    bool nuevoCluster = true;
+    while (abanico >= 0) {
+        if (nuevoCluster && clusters != nullptr) {
+            clusters->push_back(resultado.size());
+        }
+
+        // Emitir todos los triangulos pendientes alrededor del vertice
+        candidatos.clear();
+        for (unsigned int a = inicio[abanico]; a < inicio[abanico + 1]; a++) {
+            unsigned int t = adyacencia[a];
+            if (emitido[t]) continue;
+            for (int k = 0; k < 3; k++) {
+                unsigned int v = indices[t * 3 + k];
+                resultado.push_back(v);
+                callejones.push_back(v);
+                candidatos.push_back(v);
+                vivos[v]--;
+                if (reloj - tiempo[v] > TAMANO_CACHE) {
+                    tiempo[v] = reloj++;
+                }
+            }
+            emitido[t] = 1;
+        }
+
+        // Se prefiere el vertice mas viejo del cache cuyos triangulos todavia quepan en el
+        int mejor = -1;
+        int mejorPrioridad = -1;
+        for (unsigned int v : candidatos) {
+            if (vivos[v] == 0) continue;
+            int prioridad = 0;
+            if (reloj - tiempo[v] + 2 * vivos[v] <= TAMANO_CACHE) {
+                prioridad = static_cast<int>(reloj - tiempo[v]);
+            }
+            if (prioridad > mejorPrioridad) {
+                mejorPrioridad = prioridad;
+                mejor = static_cast<int>(v);
+            }
+        }
+
+        // Saltar a otro vertice equivale a vaciar el cache: ahi empieza otro cluster
+        nuevoCluster = mejor < 0;
+        abanico = nuevoCluster ? saltarCallejon() : mejor;
+    }
+
+    std::copy(resultado.begin(), resultado.end(), indices);
+}
+
+void ordenarParaOverdraw(unsigned int* indices, size_t numIndices, const float* vertices,
+                         const std::vector<size_t>& clusters)
+{
+    size_t numTriangulos = numIndices / 3;
+    if (clusters.size() < 2) return;
+
+    // Centro del mesh pesado por area
+    glm::vec3 centroMesh(0.0f);
+    float areaTotal = 0.0f;
+    for (size_t t = 0; t < numTriangulos; t++) {
+        glm::vec3 a = posicion(vertices, indices[t * 3]);
+        glm::vec3 b = posicion(vertices, indices[t * 3 + 1]);
+        glm::vec3 c = posicion(vertices, indices[t * 3 + 2]);
+        float area = glm::length(glm::cross(b - a, c - a));
+        centroMesh += (a + b + c) * area;
+        areaTotal += area;
+    }
+    if (areaTotal <= 0.0f) return;
+    centroMesh /= areaTotal * 3.0f;
+
+    // Los clusters que miran hacia afuera tapan a los de adentro, por eso se dibujan primero
+    std::vector<Cluster> grupos(clusters.size());
+    for (size_t i = 0; i < clusters.size(); i++) {
+        Cluster& grupo = grupos[i];
+        grupo.inicio = clusters[i];
+        grupo.fin = i + 1 < clusters.size() ? clusters[i + 1] : numTriangulos * 3;
+
+        glm::vec3 centro(0.0f);
+        glm::vec3 normal(0.0f);
+        float area = 0.0f;
+        for (size_t j = grupo.inicio; j < grupo.fin; j += 3) {
+            glm::vec3 a = posicion(vertices, indices[j]);
+            glm::vec3 b = posicion(vertices, indices[j + 1]);
+            glm::vec3 c = posicion(vertices, indices[j + 2]);
+            glm::vec3 cruz = glm::cross(b - a, c - a);
+            float areaTriangulo = glm::length(cruz);
+            centro += (a + b + c) * areaTriangulo;
+            normal += cruz;
+            area += areaTriangulo;
+        }
+        grupo.orientacion = area > 0.0f ? glm::dot(centro / (area * 3.0f) - centroMesh, normal) : 0.0f;
+    }
+
+    std::stable_sort(grupos.begin(), grupos.end(),
+        [](const Cluster& a, const Cluster& b) { return a.orientacion > b.orientacion; });
+
+    std::vector<unsigned int> resultado;
+    resultado.reserve(numTriangulos * 3);
+    for (const Cluster& grupo : grupos) {
+        resultado.insert(resultado.end(), indices + grupo.inicio, indices + grupo.fin);
+    }
+    std::copy(resultado.begin(), resultado.end(), indices);
+}
+
+unsigned int ordenarParaFetch(float* vertices, unsigned int* indices, size_t numIndices,
+                              unsigned int numVertices)
+{
+    std::vector<unsigned int> nuevoIndice(numVertices, SIN_ASIGNAR);
+    unsigned int usados = 0;
+    for (size_t i = 0; i < numIndices; i++) {
+        unsigned int& destino = nuevoIndice[indices[i]];
+        if (destino == SIN_ASIGNAR) {
+            destino = usados++;
+        }
+        indices[i] = destino;
+    }
+
+    // Los vertices que no se usan se conservan al final
+    unsigned int siguiente = usados;
+    std::vector<float> copia(vertices, vertices + static_cast<size_t>(numVertices) * FLOTANTES_POR_VERTICE);
+    for (unsigned int v = 0; v < numVertices; v++) {
+        unsigned int destino = nuevoIndice[v] != SIN_ASIGNAR ? nuevoIndice[v] : siguiente++;
+        std::copy(copia.begin() + static_cast<size_t>(v) * FLOTANTES_POR_VERTICE,
+                  copia.begin() + static_cast<size_t>(v + 1) * FLOTANTES_POR_VERTICE,
+                  vertices + static_cast<size_t>(destino) * FLOTANTES_POR_VERTICE);
+    }
+    return usados;
+}
+
+Estadisticas optimizar(float* vertices, unsigned int* indices, unsigned int numFlotantes,
+                       unsigned int numIndices, const char* nombre, bool overdraw)
+{
+    unsigned int numVertices = numFlotantes / FLOTANTES_POR_VERTICE;
+
+    Estadisticas estadisticas;
+    estadisticas.numTriangulos = numIndices / 3;
+    estadisticas.acmrAntes = 0.0f;
+    estadisticas.acmrDespues = 0.0f;
+    estadisticas.verticesUsados = 0;
+
+    if (numIndices % 3 != 0) {
+        printf("[OptimizadorMesh] %s: no es una lista de triangulos, se deja sin optimizar\n", nombre);
+        return estadisticas;
+    }
+
+    // Un indice fuera de rango dejaria las tablas por vertice cortas
+    for (unsigned int i = 0; i < numIndices; i++) {
+        if (indices[i] >= numVertices) {
+            printf("[OptimizadorMesh] %s: indice %u fuera de rango, se deja sin optimizar\n", nombre, indices[i]);
+            return estadisticas;
+        }
+    }
+
+    estadisticas.acmrAntes = calcularACMR(indices, numIndices, numVertices);
+
+    std::vector<size_t> clusters;
+    ordenarParaCache(indices, numIndices, numVertices, overdraw ? &clusters : nullptr);
+    if (overdraw) {
+        ordenarParaOverdraw(indices, numIndices, vertices, clusters);
+    }
+    estadisticas.verticesUsados = ordenarParaFetch(vertices, indices, numIndices, numVertices);
+
+    estadisticas.acmrDespues = calcularACMR(indices, numIndices, numVertices);
+    printf("[OptimizadorMesh] %s: %u triangulos, ACMR %.3f -> %.3f\n",
+        nombre, estadisticas.numTriangulos, estadisticas.acmrAntes, estadisticas.acmrDespues);
+    return estadisticas;
+}
+
+Estadisticas optimizar(std::vector<float>& vertices, std::vector<unsigned int>& indices,
+                       const char* nombre, bool overdraw)
+{
+    Estadisticas estadisticas = optimizar(vertices.data(), indices.data(),
+        static_cast<unsigned int>(vertices.size()), static_cast<unsigned int>(indices.size()), nombre, overdraw);
+
+    // Despues de ordenarParaFetch los vertices usados son los primeros
+    if (estadisticas.verticesUsados > 0) {
+        vertices.resize(static_cast<size_t>(estadisticas.verticesUsados) * FLOTANTES_POR_VERTICE);
+    }
+    return estadisticas;
+}
+
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+// Pasadas de optimizacion para meshes de triangulos indexados (8 flotantes por vertice)
+// que se aplican al importar, antes de crear los buffers:
+//  1. Orden de triangulos para el cache de vertices transformados (Tipsify, Sander et al. 2007)
+//  2. Orden de los grupos de triangulos de afuera hacia adentro para reducir el overdraw
+//  3. Orden de vertices por primer uso para que las lecturas del VBO sean secuenciales
+namespace OptimizadorMesh {
+
+// Cache FIFO que se simula para el ACMR y que Tipsify toma como objetivo
+const unsigned int TAMANO_CACHE = 16;
+
+struct Estadisticas {
+    unsigned int numTriangulos;
+    float acmrAntes;        // Vertices transformados por triangulo (0.5 ideal, 3 sin reuso)
+    float acmrDespues;
+    unsigned int verticesUsados;    // 0 si el mesh se dejo sin optimizar
+};
+
+// Promedio de fallos del cache de vertices por triangulo
+float calcularACMR(const unsigned int* indices, size_t numIndices, unsigned int numVertices,
+                   unsigned int tamanoCache = TAMANO_CACHE);
+
+// Reordena los triangulos; en clusters quedan los indices donde empieza cada grupo
+// de triangulos que se emitio despues de vaciar el cache
+void ordenarParaCache(unsigned int* indices, size_t numIndices, unsigned int numVertices,
+                      std::vector<size_t>* clusters = nullptr);
+
+// Ordena los clusters por que tanto miran hacia afuera del centro del mesh
+void ordenarParaOverdraw(unsigned int* indices, size_t numIndices, const float* vertices,
+                         const std::vector<size_t>& clusters);
+
+// Renumera los vertices en el orden en que se usan. Los que no usa ningun indice quedan
+// al final; devuelve cuantos vertices se usan
+unsigned int ordenarParaFetch(float* vertices, unsigned int* indices, size_t numIndices,
+                              unsigned int numVertices);
+
+// Ejecuta las tres pasadas e imprime el ACMR antes y despues. numFlotantes es el
+// tamano del arreglo de vertices, como en Mesh::CreateMesh
+Estadisticas optimizar(float* vertices, unsigned int* indices, unsigned int numFlotantes,
+                       unsigned int numIndices, const char* nombre, bool overdraw = true);
+
+// Igual, pero descarta los vertices que no se usan
+Estadisticas optimizar(std::vector<float>& vertices, std::vector<unsigned int>& indices,
+                       const char* nombre, bool overdraw = true);
+
+}
@@ -0,0 +1,23 @@
+#include "PaqueteFrame.h"
+
+PaqueteFrame::PaqueteFrame()
+    : vista(1.0f), posicionCamara(0.0f), terceraPersona(false),
+      skybox(nullptr), skyboxAnterior(nullptr), mezclaSkybox(1.0f),
+      numLucesPuntuales(0), numLucesSpot(0),
+      versionGrafo(0), lotesEstaticos(nullptr)
+{
+}
+
+void PaqueteFrame::capturarGrafo(const SceneGraph& grafo)
+{
+    // assign reutiliza la memoria del frame anterior; con el mismo numero de nodos no se reserva
+    if (versionGrafo != grafo.getVersion() || nodos.size() != grafo.getNumNodos()) {
+        nodos.assign(grafo.getNodosRender().begin(), grafo.getNodosRender().end());
+        finSubarboles.assign(grafo.getFinSubarboles().begin(), grafo.getFinSubarboles().end());
+        versionGrafo = grafo.getVersion();
+    }
+    transformaciones.assign(grafo.getTransformacionesRender().begin(), grafo.getTransformacionesRender().end());
+    aabbMundiales.assign(grafo.getAABBMundiales().begin(), grafo.getAABBMundiales().end());
+    esferasMundiales.assign(grafo.getEsferasMundiales().begin(), grafo.getEsferasMundiales().end());
+    aabbSubarboles.assign(grafo.getAABBSubarboles().begin(), grafo.getAABBSubarboles().end());
+}
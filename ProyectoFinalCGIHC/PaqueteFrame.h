@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vector>
+#include <glm.hpp>
+#include "SceneGraph.h"
+#include "LotesEstaticos.h"
+#include "VolumenEnvolvente.h"
+#include "Skybox.h"
+#include "DirectionalLight.h"
+#include "PointLight.h"
+#include "SpotLight.h"
+#include "CommonValues.h"
+
+// Todo lo que el renderer necesita para dibujar un frame, copiado del estado de la simulacion
+// Mientras el hilo principal dibuja un paquete, el hilo de simulacion llena el otro, asi que el
+// renderer nunca lee entidades, el grafo ni las luces mientras se modifican. Los recursos
+// (modelos, meshes, texturas, materiales, skyboxes y lotes) se guardan como punteros: solo
+// cambian en el hilo principal, entre frames.
+struct PaqueteFrame {
+    // Camara interpolada
+    glm::mat4 vista;
+    glm::vec3 posicionCamara;
+    bool terceraPersona;
+
+    // Cielo y transicion desde el anterior
+    const Skybox* skybox;
+    const Skybox* skyboxAnterior;
+    float mezclaSkybox;
+
+    // Luces del frame
+    DirectionalLight luzDireccional;
+    PointLight lucesPuntuales[MAX_POINT_LIGHTS];
+    unsigned int numLucesPuntuales;
+    SpotLight lucesSpot[MAX_SPOT_LIGHTS];
+    unsigned int numLucesSpot;
+
+    // Nodos del grafo de escena indexados por handle
+    std::vector<NodoRender> nodos;
+    std::vector<glm::mat4> transformaciones;    // Interpoladas entre los dos ultimos ticks
+    std::vector<AABB> aabbMundiales;
+    std::vector<EsferaEnvolvente> esferasMundiales;
+    std::vector<AABB> aabbSubarboles;
+    std::vector<int> finSubarboles;
+    unsigned int versionGrafo;                  // Version del grafo de la que salieron los nodos
+
+    const LotesEstaticos* lotesEstaticos;
+
+    PaqueteFrame();
+
+    // Copiar los nodos y sus matrices; los nodos solo se copian si el grafo se reconstruyo
+    void capturarGrafo(const SceneGraph& grafo);
+
+    size_t getNumNodos() const { return nodos.size(); }
+};
@@ -0,0 +1,46 @@
+#include "PasoFijo.h"
+#include "CommonValues.h"
+
+PasoFijo::PasoFijo(double ticksPorSegundo, unsigned int maxTicksPorFrame)
+    : acumulador(0.0), maxTicksPorFrame(maxTicksPorFrame), ticksDescartados(0)
+{
+    setTicksPorSegundo(ticksPorSegundo);
+}
+
+void PasoFijo::setTicksPorSegundo(double ticksPorSegundo)
+{
+    segundosPorTick = 1.0 / ticksPorSegundo;
+    deltaTick = deltaPorTick(ticksPorSegundo);
+}
+
+float PasoFijo::deltaPorTick(double ticksPorSegundo)
+{
+    return static_cast<float>((1.0 / ticksPorSegundo) / LIMIT_FPS);
+}
+
+unsigned int PasoFijo::avanzar(double segundos)
+{
+    if (segundos > 0.0) {
+        acumulador += segundos;
+    }
+
+    unsigned int ticks = 0;
+    while (acumulador >= segundosPorTick && ticks < maxTicksPorFrame) {
+        acumulador -= segundosPorTick;
+        ticks++;
+    }
+
+    // Si el frame tardo demasiado (carga, ventana arrastrada) la simulacion se queda atras
+    // en lugar de intentar alcanzar el tiempo real
+    if (acumulador >= segundosPorTick) {
+        unsigned int sobrantes = static_cast<unsigned int>(acumulador / segundosPorTick);
+        ticksDescartados += sobrantes;
+        acumulador -= sobrantes * segundosPorTick;
+    }
+    return ticks;
+}
+
+float PasoFijo::getAlpha() const
+{
+    return static_cast<float>(acumulador / segundosPorTick);
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+// Planificador de la simulacion con paso fijo
+// El tiempo real de cada frame se acumula y se consume en ticks de duracion fija, asi que
+// la fisica, las animaciones y el audio avanzan igual sin importar los fps del render.
+// Lo que sobra del acumulador (menos de un tick) es la fraccion con la que se interpola
+// entre los dos ultimos estados al dibujar.
+class PasoFijo {
+public:
+    // maxTicksPorFrame evita que un frame muy lento dispare cada vez mas ticks
+    explicit PasoFijo(double ticksPorSegundo, unsigned int maxTicksPorFrame = 8);
+
+    // Sumar el tiempo real transcurrido (segundos) y devolver cuantos ticks simular
+    unsigned int avanzar(double segundos);
+
+    // Fraccion del siguiente tick ya transcurrida [0, 1)
+    float getAlpha() const;
+
+    // deltaTime de un tick en las unidades de la escena (frames de LIMIT_FPS)
+    float getDeltaTick() const { return deltaTick; }
+
+    void setTicksPorSegundo(double ticksPorSegundo);
+    double getTicksPorSegundo() const { return 1.0 / segundosPorTick; }
+
+    // Ticks que se descartaron por exceder maxTicksPorFrame
+    unsigned int getTicksDescartados() const { return ticksDescartados; }
+
+    static float deltaPorTick(double ticksPorSegundo);
+
+private:
+    double segundosPorTick;
+    double acumulador;
+    float deltaTick;
+    unsigned int maxTicksPorFrame;
+    unsigned int ticksDescartados;
+};
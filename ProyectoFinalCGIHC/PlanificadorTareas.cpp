@@ -0,0 +1,191 @@
+#include "PlanificadorTareas.h"
+
+GrafoTareas::GrafoTareas()
+    : restantes(0)
+{
+}
+
+GrafoTareas::Id GrafoTareas::agregar(std::function<void()> funcion, std::initializer_list<Id> dependencias)
+{
+    Id id = static_cast<Id>(tareas.size());
+    tareas.emplace_back();
+    Tarea& tarea = tareas.back();
+    tarea.funcion = std::move(funcion);
+    tarea.numDependencias = 0;
+    tarea.pendientes = 0;
+    tarea.grafo = this;
+    for (Id dependencia : dependencias) {
+        depende(id, dependencia);
+    }
+    return id;
+}
+
+GrafoTareas::Id GrafoTareas::paraCada(unsigned int total, unsigned int tamanoBloque,
+                                      std::function<void(unsigned int inicio, unsigned int fin)> funcion,
+                                      std::initializer_list<Id> dependencias)
+{
+    if (tamanoBloque == 0) tamanoBloque = 1;
+
+    // Los bloques comparten la funcion; cada uno captura solo su rango
+    auto compartida = std::make_shared<std::function<void(unsigned int, unsigned int)>>(std::move(funcion));
+    std::vector<Id> bloques;
+    for (unsigned int inicio = 0; inicio < total; inicio += tamanoBloque) {
+        unsigned int fin = inicio + tamanoBloque < total ? inicio + tamanoBloque : total;
+        bloques.push_back(agregar([compartida, inicio, fin]() { (*compartida)(inicio, fin); }, dependencias));
+    }
+
+    Id terminados = agregar([]() {}, dependencias);
+    for (Id bloque : bloques) {
+        depende(terminados, bloque);
+    }
+    return terminados;
+}
+
+void GrafoTareas::depende(Id tarea, Id dependencia)
+{
+    tareas[dependencia].sucesores.push_back(tarea);
+    tareas[tarea].numDependencias++;
+}
+
+void GrafoTareas::limpiar()
+{
+    tareas.clear();
+}
+
+PlanificadorTareas& PlanificadorTareas::instancia()
+{
+    static PlanificadorTareas planificador;
+    return planificador;
+}
+
+PlanificadorTareas::PlanificadorTareas()
+    : tareasEnCola(0), robos(0), detener(false)
+{
+    // El hilo principal cuenta como uno de los nucleos
+    unsigned int nucleos = std::thread::hardware_concurrency();
+    unsigned int numHilos = nucleos > 1 ? nucleos - 1 : 0;
+
+    for (unsigned int i = 0; i <= numHilos; i++) {
+        colas.emplace_back(new ColaHilo());
+    }
+    hilos.reserve(numHilos);
+    for (unsigned int i = 0; i < numHilos; i++) {
+        hilos.emplace_back(&PlanificadorTareas::trabajar, this, i + 1);
+    }
+}
+
+PlanificadorTareas::~PlanificadorTareas()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutexEspera);
+        detener = true;
+    }
+    hayTareas.notify_all();
+    for (auto& hilo : hilos) {
+        hilo.join();
+    }
+}
+
+void PlanificadorTareas::encolar(unsigned int indice, GrafoTareas::Tarea* tarea)
+{
+    {
+        std::lock_guard<std::mutex> lock(colas[indice]->mutex);
+        colas[indice]->tareas.push_back(tarea);
+    }
+    // El contador se sube con mutexEspera tomado para que un hilo que esta por dormirse no
+    // pierda el aviso
+    {
+        std::lock_guard<std::mutex> lock(mutexEspera);
+        tareasEnCola++;
+    }
+    hayTareas.notify_one();
+}
+
+GrafoTareas::Tarea* PlanificadorTareas::tomar(unsigned int indice)
+{
+    GrafoTareas::Tarea* tarea = nullptr;
+    {
+        // Primero la cola propia, por el final
+        ColaHilo& propia = *colas[indice];
+        std::lock_guard<std::mutex> lock(propia.mutex);
+        if (!propia.tareas.empty()) {
+            tarea = propia.tareas.back();
+            propia.tareas.pop_back();
+        }
+    }
+
+    // Si no hay, robar del principio de las demas empezando por la siguiente
+    for (size_t i = 1; tarea == nullptr && i < colas.size(); i++) {
+        ColaHilo& otra = *colas[(indice + i) % colas.size()];
+        std::lock_guard<std::mutex> lock(otra.mutex);
+        if (!otra.tareas.empty()) {
+            tarea = otra.tareas.front();
+            otra.tareas.pop_front();
+            robos++;
+        }
+    }
+
+    if (tarea != nullptr) {
+        tareasEnCola--;
+    }
+    return tarea;
+}
+
+void PlanificadorTareas::ejecutarTarea(unsigned int indice, GrafoTareas::Tarea* tarea)
+{
+    tarea->funcion();
+
+    // Los sucesores que quedaron sin dependencias van a la cola de este hilo
+    GrafoTareas* grafo = tarea->grafo;
+    for (GrafoTareas::Id sucesor : tarea->sucesores) {
+        GrafoTareas::Tarea* siguiente = &grafo->tareas[sucesor];
+        if (--siguiente->pendientes == 0) {
+            encolar(indice, siguiente);
+        }
+    }
+
+    // Se descuenta al final: cuando llega a cero ya no queda nada que encolar
+    grafo->restantes--;
+}
+
+void PlanificadorTareas::ejecutar(GrafoTareas& grafo)
+{
+    if (grafo.tareas.empty()) return;
+
+    grafo.restantes = static_cast<unsigned int>(grafo.tareas.size());
+    for (auto& tarea : grafo.tareas) {
+        tarea.pendientes = tarea.numDependencias;
+    }
+    for (auto& tarea : grafo.tareas) {
+        if (tarea.numDependencias == 0) {
+            encolar(0, &tarea);
+        }
+    }
+
+    // El hilo que llama trabaja hasta que termina la ultima tarea
+    while (grafo.restantes > 0) {
+        GrafoTareas::Tarea* tarea = tomar(0);
+        if (tarea != nullptr) {
+            ejecutarTarea(0, tarea);
+        }
+        else {
+            // Otro hilo esta terminando una tarea de la que dependen las que faltan
+            std::this_thread::yield();
+        }
+    }
+}
+
+void PlanificadorTareas::trabajar(unsigned int indice)
+{
+    while (true) {
+        GrafoTareas::Tarea* tarea = tomar(indice);
+        if (tarea != nullptr) {
+            ejecutarTarea(indice, tarea);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mutexEspera);
+        hayTareas.wait(lock, [this] { return detener || tareasEnCola > 0; });
+        if (detener) return;
+    }
+}
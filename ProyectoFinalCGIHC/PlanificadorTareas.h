@@ -0,0 +1,102 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <memory>
+#include <initializer_list>
+
+class PlanificadorTareas;
+
+// Conjunto de tareas con dependencias explicitas que se ejecuta una vez por tick
+// Una tarea empieza cuando terminaron todas las tareas de las que depende. Las tareas no
+// deben llamar a OpenGL ni ejecutar otro grafo.
+class GrafoTareas {
+public:
+    typedef unsigned int Id;
+
+    GrafoTareas();
+
+    // Agregar una tarea que depende de las indicadas (ya agregadas)
+    Id agregar(std::function<void()> funcion, std::initializer_list<Id> dependencias = {});
+
+    // Dividir [0, total) en bloques de tamanoBloque, una tarea por bloque. Devuelve una tarea
+    // vacia que termina cuando terminaron todos los bloques (para usarla como dependencia)
+    Id paraCada(unsigned int total, unsigned int tamanoBloque,
+                std::function<void(unsigned int inicio, unsigned int fin)> funcion,
+                std::initializer_list<Id> dependencias = {});
+
+    // Agregar una dependencia a una tarea ya creada
+    void depende(Id tarea, Id dependencia);
+
+    // Quitar todas las tareas para reutilizar el grafo
+    void limpiar();
+
+    size_t getNumTareas() const { return tareas.size(); }
+
+private:
+    friend class PlanificadorTareas;
+
+    struct Tarea {
+        std::function<void()> funcion;
+        std::vector<Id> sucesores;
+        unsigned int numDependencias;
+        std::atomic<unsigned int> pendientes;   // Dependencias que faltan en esta ejecucion
+        GrafoTareas* grafo;
+    };
+
+    // deque: las tareas no se mueven al agregar mas (los atomicos no se pueden mover)
+    std::deque<Tarea> tareas;
+    std::atomic<unsigned int> restantes;
+};
+
+// Hilos de trabajo para las tareas de cada tick con robo de trabajo
+// Cada hilo tiene su propia cola: toma del final las tareas que el mismo libero (siguen
+// calientes en cache) y cuando se vacia roba del principio de las colas de los demas.
+// El hilo que ejecuta un grafo tambien trabaja mientras espera. Los hilos de carga de assets
+// estan en PoolHilos para que una carga larga no detenga el frame.
+class PlanificadorTareas {
+public:
+    static PlanificadorTareas& instancia();
+
+    // Ejecutar el grafo y regresar cuando terminaron todas sus tareas
+    // Solo un hilo a la vez: el de simulacion mientras corre un frame y el principal entre frames
+    void ejecutar(GrafoTareas& grafo);
+
+    // Hilos que ejecutan tareas, contando el que llama a ejecutar
+    unsigned int getNumHilos() const { return static_cast<unsigned int>(hilos.size()) + 1; }
+
+    // Tareas que se tomaron de la cola de otro hilo desde el inicio
+    unsigned long long getRobos() const { return robos.load(); }
+
+    ~PlanificadorTareas();
+
+private:
+    PlanificadorTareas();
+    PlanificadorTareas(const PlanificadorTareas&) = delete;
+    PlanificadorTareas& operator=(const PlanificadorTareas&) = delete;
+
+    struct ColaHilo {
+        std::mutex mutex;
+        std::deque<GrafoTareas::Tarea*> tareas;
+    };
+
+    // Cola 0 = hilo que llama a ejecutar, cola i = hilos[i - 1]
+    std::vector<std::unique_ptr<ColaHilo>> colas;
+    std::vector<std::thread> hilos;
+
+    std::mutex mutexEspera;
+    std::condition_variable hayTareas;
+    std::atomic<unsigned int> tareasEnCola;
+    std::atomic<unsigned long long> robos;
+    bool detener;
+
+    void trabajar(unsigned int indice);
+    void encolar(unsigned int indice, GrafoTareas::Tarea* tarea);
+    GrafoTareas::Tarea* tomar(unsigned int indice);
+    void ejecutarTarea(unsigned int indice, GrafoTareas::Tarea* tarea);
+};
@@ -22,6 +22,11 @@ public:
 
 	// Settear posicion de la luz
 	void setPosition(const glm::vec3& pos) { position = pos; }
+
+	// Coeficientes de atenuacion (se copian al buffer de luces)
+	GLfloat GetConstant() const { return constant; }
+	GLfloat GetLinear() const { return linear; }
+	GLfloat GetExponent() const { return exponent; }
 	~PointLight();
 
 protected:
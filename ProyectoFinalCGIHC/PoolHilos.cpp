@@ -0,0 +1,54 @@
+#include "PoolHilos.h"
+
+PoolHilos::PoolHilos(unsigned int numHilos)
+    : detener(false)
+{
+    if (numHilos == 0) {
+        unsigned int nucleos = std::thread::hardware_concurrency();
+        numHilos = nucleos > 1 ? nucleos - 1 : 1;
+    }
+    hilos.reserve(numHilos);
+    for (unsigned int i = 0; i < numHilos; i++) {
+        hilos.emplace_back(&PoolHilos::trabajar, this);
+    }
+}
+
+PoolHilos::~PoolHilos()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutexTareas);
+        detener = true;
+    }
+    hayTareas.notify_all();
+    // Los hilos terminan las tareas que queden en la cola antes de salir
+    for (auto& hilo : hilos) {
+        hilo.join();
+    }
+}
+
+std::future<void> PoolHilos::encolar(std::function<void()> tarea)
+{
+    std::packaged_task<void()> paquete(std::move(tarea));
+    std::future<void> resultado = paquete.get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutexTareas);
+        tareas.push(std::move(paquete));
+    }
+    hayTareas.notify_one();
+    return resultado;
+}
+
+void PoolHilos::trabajar()
+{
+    while (true) {
+        std::packaged_task<void()> tarea;
+        {
+            std::unique_lock<std::mutex> lock(mutexTareas);
+            hayTareas.wait(lock, [this] { return detener || !tareas.empty(); });
+            if (tareas.empty()) return;
+            tarea = std::move(tareas.front());
+            tareas.pop();
+        }
+        tarea();
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+
+// Grupo fijo de hilos que ejecuta tareas en orden de llegada
+// Las tareas no deben llamar a OpenGL: el contexto solo es valido en el hilo principal
+class PoolHilos {
+public:
+    // 0 = un hilo por nucleo, dejando libre el del hilo principal
+    explicit PoolHilos(unsigned int numHilos = 0);
+    ~PoolHilos();
+
+    PoolHilos(const PoolHilos&) = delete;
+    PoolHilos& operator=(const PoolHilos&) = delete;
+
+    // Encolar una tarea; el future se completa cuando termina (o guarda su excepcion)
+    std::future<void> encolar(std::function<void()> tarea);
+
+    unsigned int getNumHilos() const { return static_cast<unsigned int>(hilos.size()); }
+
+private:
+    void trabajar();
+
+    std::vector<std::thread> hilos;
+    std::queue<std::packaged_task<void()>> tareas;
+    std::mutex mutexTareas;
+    std::condition_variable hayTareas;
+    bool detener;
+};
@@ -0,0 +1,105 @@
+#include "RegistroEntidades.h"
+#include <algorithm>
+
+RegistroEntidades::RegistroEntidades()
+{
+}
+
+RegistroEntidades::~RegistroEntidades()
+{
+}
+
+int RegistroEntidades::obtenerId(const std::string& nombre)
+{
+    auto it = ids.find(nombre);
+    if (it != ids.end()) {
+        return it->second;
+    }
+    int id = static_cast<int>(entidadesPorId.size());
+    ids[nombre] = id;
+    entidadesPorId.emplace_back();
+    return id;
+}
+
+int RegistroEntidades::registrarGrupo(const std::string& prefijo)
+{
+    // Si el grupo ya existe se regresa el mismo id
+    for (size_t i = 0; i < prefijosGrupos.size(); i++) {
+        if (prefijosGrupos[i] == prefijo) {
+            return static_cast<int>(i);
+        }
+    }
+
+    int idGrupo = static_cast<int>(grupos.size());
+    prefijosGrupos.push_back(prefijo);
+    grupos.emplace_back();
+
+    // Agregar las entidades que ya estaban registradas
+    for (auto& lista : entidadesPorId) {
+        for (auto* entidad : lista) {
+            if (entidad->nombreObjeto.compare(0, prefijo.size(), prefijo) == 0) {
+                grupos[idGrupo].push_back(entidad);
+            }
+        }
+    }
+    return idGrupo;
+}
+
+void RegistroEntidades::registrar(Entidad* entidad)
+{
+    if (entidad == nullptr) return;
+
+    entidadesPorId[obtenerId(entidad->nombreObjeto)].push_back(entidad);
+
+    for (size_t i = 0; i < prefijosGrupos.size(); i++) {
+        if (entidad->nombreObjeto.compare(0, prefijosGrupos[i].size(), prefijosGrupos[i]) == 0) {
+            grupos[i].push_back(entidad);
+        }
+    }
+}
+
+void RegistroEntidades::remover(Entidad* entidad)
+{
+    if (entidad == nullptr) return;
+
+    // Se busca en todas las listas por si el nombre cambio despues de registrarla
+    for (auto& lista : entidadesPorId) {
+        lista.erase(std::remove(lista.begin(), lista.end(), entidad), lista.end());
+    }
+    for (auto& grupo : grupos) {
+        grupo.erase(std::remove(grupo.begin(), grupo.end(), entidad), grupo.end());
+    }
+}
+
+Entidad* RegistroEntidades::buscar(int id) const
+{
+    if (id < 0 || id >= static_cast<int>(entidadesPorId.size()) || entidadesPorId[id].empty()) {
+        return nullptr;
+    }
+    return entidadesPorId[id].front();
+}
+
+Entidad* RegistroEntidades::buscar(const std::string& nombre) const
+{
+    auto it = ids.find(nombre);
+    if (it == ids.end()) {
+        return nullptr;
+    }
+    return buscar(it->second);
+}
+
+const std::vector<Entidad*>& RegistroEntidades::getEntidades(int id) const
+{
+    if (id < 0 || id >= static_cast<int>(entidadesPorId.size())) {
+        return vacio;
+    }
+    return entidadesPorId[id];
+}
+
+const std::vector<Entidad*>& RegistroEntidades::getGrupo(int idGrupo) const
+{
+    if (idGrupo < 0 || idGrupo >= static_cast<int>(grupos.size())) {
+        return vacio;
+    }
+    return grupos[idGrupo];
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include "Entidad.h"
+
+// Indice de las entidades raiz de la escena por nombre internado y por grupos de prefijo
+// Los nombres se convierten una sola vez a un id entero, por lo que las consultas de cada frame
+// son un acceso directo a un arreglo en lugar de comparar cadenas contra todas las entidades
+class RegistroEntidades {
+public:
+    RegistroEntidades();
+    ~RegistroEntidades();
+
+    // Obtener (o crear) el id de un nombre
+    int obtenerId(const std::string& nombre);
+
+    // Definir un grupo con todas las entidades cuyo nombre empiece con el prefijo
+    int registrarGrupo(const std::string& prefijo);
+
+    // Registrar o quitar una entidad (se usa su nombreObjeto al momento de registrarla)
+    void registrar(Entidad* entidad);
+    void remover(Entidad* entidad);
+
+    // Primera entidad registrada con el nombre, o nullptr
+    Entidad* buscar(int id) const;
+    Entidad* buscar(const std::string& nombre) const;
+
+    // Todas las entidades con el mismo nombre
+    const std::vector<Entidad*>& getEntidades(int id) const;
+
+    // Todas las entidades de un grupo de prefijo
+    const std::vector<Entidad*>& getGrupo(int idGrupo) const;
+
+private:
+    std::unordered_map<std::string, int> ids;
+    std::vector<std::vector<Entidad*>> entidadesPorId;
+
+    // Grupos por prefijo
+    std::vector<std::string> prefijosGrupos;
+    std::vector<std::vector<Entidad*>> grupos;
+
+    // Lista vacia para ids invalidos
+    std::vector<Entidad*> vacio;
+};
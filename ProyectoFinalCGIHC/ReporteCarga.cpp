@@ -0,0 +1,32 @@
+#include "ReporteCarga.h"
+#include <cstdio>
+
+ReporteCarga::ReporteCarga(const std::string& titulo)
+    : titulo(titulo)
+{
+}
+
+void ReporteCarga::agregar(const std::string& nombre, double msCpu, double msGpu)
+{
+    tiempos.push_back({ nombre, msCpu, msGpu });
+}
+
+void ReporteCarga::imprimir(double msTotal, unsigned int numHilos) const
+{
+    double totalCpu = 0.0;
+    double totalGpu = 0.0;
+    for (const auto& tiempo : tiempos) {
+        printf("[%s] %-28s cpu: %8.2f ms  gpu: %7.2f ms\n",
+               titulo.c_str(), tiempo.nombre.c_str(), tiempo.msCpu, tiempo.msGpu);
+        totalCpu += tiempo.msCpu;
+        totalGpu += tiempo.msGpu;
+    }
+    // Si la carga fuera secuencial tardaria aproximadamente cpu + gpu
+    printf("[%s] %u assets en %.2f ms con %u hilos (cpu acumulado: %.2f ms, gpu: %.2f ms)\n",
+           titulo.c_str(), static_cast<unsigned int>(tiempos.size()), msTotal, numHilos, totalCpu, totalGpu);
+}
+
+double ReporteCarga::msDesde(std::chrono::steady_clock::time_point inicio)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inicio).count();
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <chrono>
+
+// Tiempos de carga de un asset: la parte en hilos de trabajo y la subida en el hilo de OpenGL
+struct TiempoCargaAsset {
+    std::string nombre;
+    double msCpu;   // Importar/decodificar (hilo de trabajo)
+    double msGpu;   // glBufferData / glTexImage2D (hilo principal)
+};
+
+// Acumula los tiempos de carga de un grupo de assets y los imprime al terminar
+class ReporteCarga {
+public:
+    explicit ReporteCarga(const std::string& titulo);
+
+    void agregar(const std::string& nombre, double msCpu, double msGpu);
+
+    // Imprimir cada asset y el resumen; msTotal es el tiempo de pared de toda la carga
+    void imprimir(double msTotal, unsigned int numHilos) const;
+
+    // Milisegundos transcurridos desde un instante
+    static double msDesde(std::chrono::steady_clock::time_point inicio);
+
+private:
+    std::string titulo;
+    std::vector<TiempoCargaAsset> tiempos;
+};
@@ -0,0 +1,206 @@
+#include "SceneGraph.h"
+#include "PlanificadorTareas.h"
+
+namespace {
+// Nodos minimos por bloque de la actualizacion en paralelo (se cortan entre raices)
+const int NODOS_POR_BLOQUE = 128;
+}
+
+SceneGraph::SceneGraph()
+    : necesitaReconstruir(true), version(0), primeraPasada(true)
+{
+}
+
+SceneGraph::~SceneGraph()
+{
+}
+
+void SceneGraph::reconstruir(const std::vector<Entidad*>& raices)
+{
+    // Las entidades que ya no esten en la escena pierden su handle
+    for (auto* entidad : entidades) {
+        entidad->indiceNodo = -1;
+    }
+
+    transformacionesLocales.clear();
+    transformacionesMundiales.clear();
+    transformacionesAnteriores.clear();
+    transformacionesRender.clear();
+    nodosMovidos.clear();
+    padres.clear();
+    cambiados.clear();
+    nodosRender.clear();
+    entidades.clear();
+    aabbLocales.clear();
+    esferasLocales.clear();
+    aabbMundiales.clear();
+    esferasMundiales.clear();
+    aabbSubarboles.clear();
+    finSubarboles.clear();
+
+    iniciosBloques.assign(1, 0);
+    for (auto* raiz : raices) {
+        if (raiz == nullptr) continue;
+        agregarNodo(raiz, -1);
+        int numNodos = static_cast<int>(entidades.size());
+        if (numNodos - iniciosBloques.back() >= NODOS_POR_BLOQUE) {
+            iniciosBloques.push_back(numNodos);
+        }
+    }
+    if (iniciosBloques.back() != static_cast<int>(entidades.size())) {
+        iniciosBloques.push_back(static_cast<int>(entidades.size()));
+    }
+    movidosPorBloque.assign(iniciosBloques.size() - 1, std::vector<int>());
+
+    necesitaReconstruir = false;
+    primeraPasada = true;
+    version++;
+}
+
+void SceneGraph::agregarNodo(Entidad* entidad, int padre)
+{
+    int indice = static_cast<int>(entidades.size());
+    entidad->indiceNodo = indice;
+
+    // Se fuerza el calculo de la mundial en la primera pasada
+    entidad->actualizarTransformacionSiEsNecesario();
+    entidad->mundialSucia = true;
+
+    transformacionesLocales.push_back(entidad->transformacionLocal);
+    transformacionesMundiales.push_back(glm::mat4(1.0f));
+    transformacionesAnteriores.push_back(glm::mat4(1.0f));
+    transformacionesRender.push_back(glm::mat4(1.0f));
+    padres.push_back(padre);
+    cambiados.push_back(1);
+    nodosRender.push_back({ entidad->TipoObjeto, entidad->modelo, entidad->mesh,
+                            entidad->texture, entidad->material, entidad->horneada });
+    entidades.push_back(entidad);
+
+    // Los volumenes vienen de la geometria que dibuja la entidad (las entidades vacias no tienen)
+    AABB aabb;
+    EsferaEnvolvente esfera;
+    if (entidad->TipoObjeto == TipoObjeto::MODELO && entidad->modelo != nullptr) {
+        aabb = entidad->modelo->getAABB();
+        esfera = entidad->modelo->getEsfera();
+    }
+    else if (entidad->TipoObjeto == TipoObjeto::MESH && entidad->mesh != nullptr) {
+        aabb = entidad->mesh->getAABB();
+        esfera = entidad->mesh->getEsfera();
+    }
+    aabbLocales.push_back(aabb);
+    esferasLocales.push_back(esfera);
+    aabbMundiales.push_back(AABB());
+    esferasMundiales.push_back(EsferaEnvolvente());
+    aabbSubarboles.push_back(AABB());
+    finSubarboles.push_back(indice + 1);
+
+    for (auto* hijo : entidad->hijos) {
+        if (hijo != nullptr) {
+            agregarNodo(hijo, indice);
+        }
+    }
+    finSubarboles[indice] = static_cast<int>(entidades.size());
+}
+
+void SceneGraph::actualizarTransformaciones()
+{
+    // Los que se movieron en el tick anterior quedan quietos salvo que vuelvan a cambiar
+    for (int nodo : nodosMovidos) {
+        transformacionesAnteriores[nodo] = transformacionesMundiales[nodo];
+        transformacionesRender[nodo] = transformacionesMundiales[nodo];
+    }
+    nodosMovidos.clear();
+
+    // Cada bloque contiene subarboles completos, asi que los bloques no comparten nodos
+    // y se procesan en paralelo
+    unsigned int numBloques = static_cast<unsigned int>(movidosPorBloque.size());
+    if (numBloques == 1) {
+        actualizarBloque(0);
+    }
+    else if (numBloques > 1) {
+        GrafoTareas tareas;
+        tareas.paraCada(numBloques, 1, [this](unsigned int inicio, unsigned int fin) {
+            for (unsigned int bloque = inicio; bloque < fin; bloque++) {
+                actualizarBloque(bloque);
+            }
+        });
+        PlanificadorTareas::instancia().ejecutar(tareas);
+    }
+
+    // Se juntan en orden de bloque para que el resultado no dependa de los hilos
+    for (const auto& movidos : movidosPorBloque) {
+        nodosMovidos.insert(nodosMovidos.end(), movidos.begin(), movidos.end());
+    }
+    primeraPasada = false;
+}
+
+void SceneGraph::actualizarBloque(unsigned int bloque)
+{
+    int inicio = iniciosBloques[bloque];
+    int fin = iniciosBloques[bloque + 1];
+    std::vector<int>& movidos = movidosPorBloque[bloque];
+    movidos.clear();
+    bool algunCambio = false;
+
+    for (int i = inicio; i < fin; i++) {
+        Entidad* entidad = entidades[i];
+        int padre = padres[i];
+
+        // Las animaciones escriben en la entidad, por lo que la local se lee de ahi
+        entidad->actualizarTransformacionSiEsNecesario();
+        bool localCambio = entidad->mundialSucia;
+        if (localCambio) {
+            transformacionesLocales[i] = entidad->transformacionLocal;
+            entidad->mundialSucia = false;
+        }
+
+        // El padre ya fue procesado porque los nodos estan en preorden
+        bool cambio = localCambio || (padre >= 0 && cambiados[padre]);
+        cambiados[i] = cambio ? 1 : 0;
+        if (!cambio) continue;
+
+        if (padre >= 0) {
+            transformacionesMundiales[i] = transformacionesMundiales[padre] * transformacionesLocales[i];
+        } else {
+            transformacionesMundiales[i] = transformacionesLocales[i];
+        }
+        if (primeraPasada) {
+            transformacionesAnteriores[i] = transformacionesMundiales[i];
+            transformacionesRender[i] = transformacionesMundiales[i];
+        } else {
+            movidos.push_back(i);
+        }
+
+        // Se deja una copia en la entidad para el codigo de gameplay
+        entidad->transformacionMundial = transformacionesMundiales[i];
+
+        aabbMundiales[i] = aabbLocales[i].transformar(transformacionesMundiales[i]);
+        esferasMundiales[i] = esferasLocales[i].transformar(transformacionesMundiales[i]);
+        algunCambio = true;
+    }
+
+    if (!algunCambio) return;
+
+    // Los hijos estan despues de su padre, asi que recorriendo al reves cada
+    // subarbol ya esta completo cuando se agrega a su padre
+    for (int i = inicio; i < fin; i++) {
+        aabbSubarboles[i] = aabbMundiales[i];
+    }
+    for (int i = fin; i-- > inicio;) {
+        if (padres[i] >= 0) {
+            aabbSubarboles[padres[i]].expandir(aabbSubarboles[i]);
+        }
+    }
+}
+
+void SceneGraph::interpolar(float alpha)
+{
+    // Entre dos ticks el giro es pequeno, asi que basta mezclar las columnas de la matriz
+    for (int nodo : nodosMovidos) {
+        const glm::mat4& anterior = transformacionesAnteriores[nodo];
+        const glm::mat4& actual = transformacionesMundiales[nodo];
+        for (int c = 0; c < 4; c++) {
+            transformacionesRender[nodo][c] = glm::mix(anterior[c], actual[c], alpha);
+        }
+    }
+}
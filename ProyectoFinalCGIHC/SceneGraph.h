@@ -0,0 +1,103 @@
+#pragma once
+
+#include <vector>
+#include <glm.hpp>
+#include "Entidad.h"
+#include "VolumenEnvolvente.h"
+
+// Recursos que necesita el renderer para dibujar un nodo
+struct NodoRender {
+    TipoObjeto tipo;
+    Model* modelo;
+    Mesh* mesh;
+    Texture* texture;
+    Material* material;
+    bool horneado;      // La geometria se dibuja desde un lote estatico
+};
+
+// Almacenamiento plano de la jerarquia de entidades (estructura de arreglos)
+// Los nodos se guardan en preorden, por lo que un padre siempre aparece antes que sus hijos
+// y las matrices mundiales se pueden calcular en un solo recorrido lineal
+class SceneGraph {
+public:
+    SceneGraph();
+    ~SceneGraph();
+
+    // Aplanar la jerarquia a partir de las entidades raiz y asignar los handles
+    void reconstruir(const std::vector<Entidad*>& raices);
+
+    // Indicar que la jerarquia o los recursos cambiaron y hay que reconstruir
+    void marcarReconstruccion() { necesitaReconstruir = true; }
+    bool necesitaReconstruccion() const { return necesitaReconstruir; }
+
+    // Copia las matrices locales que cambiaron y recalcula las mundiales en orden
+    // Se llama una vez por tick de la simulacion; la mundial anterior se conserva para interpolar
+    // Los bloques de raices se reparten entre los hilos del PlanificadorTareas
+    void actualizarTransformaciones();
+
+    // Calcular las matrices para dibujar entre el tick anterior y el actual (alpha en [0, 1])
+    // Solo se mezclan los nodos que se movieron en el ultimo tick
+    void interpolar(float alpha);
+
+    // Acceso por handle (indice del nodo)
+    size_t getNumNodos() const { return entidades.size(); }
+    const glm::mat4& getTransformacionMundial(int handle) const { return transformacionesMundiales[handle]; }
+    // Matriz interpolada con la que se dibuja el nodo
+    const glm::mat4& getTransformacionRender(int handle) const { return transformacionesRender[handle]; }
+    const NodoRender& getNodoRender(int handle) const { return nodosRender[handle]; }
+    int getPadre(int handle) const { return padres[handle]; }
+    Entidad* getEntidad(int handle) const { return entidades[handle]; }
+
+    // Volumenes en espacio mundial del nodo y de todo su subarbol
+    const AABB& getAABBMundial(int handle) const { return aabbMundiales[handle]; }
+    const EsferaEnvolvente& getEsferaMundial(int handle) const { return esferasMundiales[handle]; }
+    const AABB& getAABBSubarbol(int handle) const { return aabbSubarboles[handle]; }
+
+    // Indice siguiente al ultimo descendiente (para saltar un subarbol completo)
+    int getFinSubarbol(int handle) const { return finSubarboles[handle]; }
+
+    // Arreglos completos para copiarlos al paquete del frame
+    const std::vector<glm::mat4>& getTransformacionesRender() const { return transformacionesRender; }
+    const std::vector<NodoRender>& getNodosRender() const { return nodosRender; }
+    const std::vector<AABB>& getAABBMundiales() const { return aabbMundiales; }
+    const std::vector<EsferaEnvolvente>& getEsferasMundiales() const { return esferasMundiales; }
+    const std::vector<AABB>& getAABBSubarboles() const { return aabbSubarboles; }
+    const std::vector<int>& getFinSubarboles() const { return finSubarboles; }
+
+    // Cambia cada vez que se reconstruye (los nodos y su orden solo cambian entonces)
+    unsigned int getVersion() const { return version; }
+
+private:
+    // Arreglos contiguos indexados por handle
+    std::vector<glm::mat4> transformacionesLocales;
+    std::vector<glm::mat4> transformacionesMundiales;
+    std::vector<glm::mat4> transformacionesAnteriores;  // Mundial del tick anterior
+    std::vector<glm::mat4> transformacionesRender;
+    std::vector<int> nodosMovidos;              // Handles cuya mundial cambio en el ultimo tick
+    std::vector<int> padres;                    // -1 para las raices
+    std::vector<unsigned char> cambiados;       // La mundial cambio en esta pasada
+    std::vector<NodoRender> nodosRender;
+    std::vector<Entidad*> entidades;            // Entidad a la que pertenece cada nodo
+
+    // Volumenes envolventes de la geometria de cada nodo
+    std::vector<AABB> aabbLocales;
+    std::vector<EsferaEnvolvente> esferasLocales;
+    std::vector<AABB> aabbMundiales;
+    std::vector<EsferaEnvolvente> esferasMundiales;
+    std::vector<AABB> aabbSubarboles;           // Union del nodo y sus descendientes
+    std::vector<int> finSubarboles;
+
+    // Bloques de raices consecutivas: bloque b = nodos [iniciosBloques[b], iniciosBloques[b + 1])
+    std::vector<int> iniciosBloques;
+    std::vector<std::vector<int>> movidosPorBloque;
+
+    bool necesitaReconstruir;
+    unsigned int version;
+    bool primeraPasada;         // Despues de reconstruir no hay estado anterior que interpolar
+
+    // Agrega la entidad y sus hijos en preorden
+    void agregarNodo(Entidad* entidad, int padre);
+
+    // Matrices y volumenes de los nodos de un bloque
+    void actualizarBloque(unsigned int bloque);
+};
@@ -5,15 +5,31 @@
 #include <ctime>
 #include <algorithm>
 
+namespace {
+// Duracion del fundido entre el cielo de dia y el de noche (3 segundos)
+const float DURACION_TRANSICION_SKYBOX = static_cast<float>(3.0 / LIMIT_FPS);
+
+// Emisores de luz que calcula cada tarea
+const unsigned int EMISORES_LUZ_POR_TAREA = 16;
+}
+
 SceneInformation::SceneInformation()
-    : skyboxActual(nullptr), pointLightCountActual(0), spotLightCountActual(0)
+    : skyboxActual(nullptr), skyboxAnterior(nullptr), pointLightCountActual(0), spotLightCountActual(0)
 {
     // Llamar a las funciones de inicialización separadas
     inicializarAudio();   // Inicializar Audio (primero para que empiece la música)
     inicializarSkybox();  // Inicializar Skybox
     inicializarLuces();   // Inicializar luces 
     inicializarCamara();  // Inicializar cámara con valores por defecto
+    inicializarRegistro();   // Ids de las entidades que se consultan cada frame
+    inicializarResidencia(); // Zonas con los modelos que se cargan bajo demanda
     inicializarEntidades();  // Inicializar Enitdades
+    cargarModelos();         // Despues de las entidades para saber que modelos se hornean
+    actualizarTransformaciones();  // Matrices mundiales validas desde el primer frame (las usan las luces)
+    hornearLotesEstaticos();
+    camera.calculateViewMatrix();  // Colocar la cámara de tercera persona antes del primer tick
+    camaraAnterior = camera;
+    camaraRender = camera;
 
 }
 
@@ -27,6 +43,7 @@ SceneInformation::~SceneInformation()
 
     // Limpiar referencia al skybox
     skyboxActual = nullptr;
+    skyboxAnterior = nullptr;
 
     // Limpiar audio
     audioManager.limpiar();
@@ -46,9 +63,23 @@ void SceneInformation::inicializarCamara(glm::vec3 startPosition,
 }
 
 // Funcion para inicializar la skybox
+// Se internan los nombres y grupos que se consultan cada frame
+void SceneInformation::inicializarRegistro()
+{
+    idsPersonajes[0] = registroEntidades.obtenerId("cuphead_torso");
+    idsPersonajes[1] = registroEntidades.obtenerId("isaac_cuerpo");
+    idsPersonajes[2] = registroEntidades.obtenerId("gojo");
+    idCanoa = registroEntidades.obtenerId("canoa");
+    idPuertaSecreta = registroEntidades.obtenerId("puerta_secret_room");
+    idPelota = registroEntidades.obtenerId("pelota");
+    idPez = registroEntidades.obtenerId("pez");
+}
+
 void SceneInformation::inicializarSkybox()
 {
-    // Establecer el skybox por defecto
+    // Establecer el skybox por defecto; el inicial se sube completo y el de dia
+    // termina de cargarse en segundo plano durante los primeros frames
+    skyboxManager.completarCarga(AssetConstants::SkyboxNames::NIGHT);
     setSkyboxActual(AssetConstants::SkyboxNames::NIGHT);
 }
 
@@ -75,6 +106,42 @@ void SceneInformation::inicializarLuces()
 }
 
 // Funcion para inicializar todas las entidades
+void SceneInformation::inicializarResidencia()
+{
+    // Cada zona lista los modelos que solo se ven dentro de ella
+    // El radio de descarga es mayor para que la zona no se cargue y descargue en el borde
+    gestorResidencia.declararZona("boss_room", glm::vec3(150.0f, 5.0f, -125.0f), 140.0f, 180.0f, {
+        AssetConstants::ModelNames::BOSS_ROOM,
+        AssetConstants::ModelNames::CABEZA_HOLLOW,
+        AssetConstants::ModelNames::CUERPO1_HOLLOW,
+        AssetConstants::ModelNames::CUERPO2_HOLLOW,
+        AssetConstants::ModelNames::CUERPO3_HOLLOW });
+    gestorResidencia.declararZona("secret_room", glm::vec3(180.0f, 5.0f, 200.0f), 120.0f, 160.0f, {
+        AssetConstants::ModelNames::SECRET_ROOM,
+        AssetConstants::ModelNames::PUERTA_SECRET_ROOM,
+        AssetConstants::ModelNames::PEDESTAL_PIEDRA,
+        AssetConstants::ModelNames::COMIDA_PERRO });
+    gestorResidencia.declararZona("sala_diablo", glm::vec3(-150.0f, 5.0f, -230.0f), 140.0f, 180.0f, {
+        AssetConstants::ModelNames::SALA_DIABLO,
+        AssetConstants::ModelNames::DIABLO });
+    gestorResidencia.declararZona("mercado", glm::vec3(-50.0f, 0.0f, 75.0f), 150.0f, 190.0f, {
+        AssetConstants::ModelNames::CARPAVACIA,
+        AssetConstants::ModelNames::CARPAYMESA,
+        AssetConstants::ModelNames::CARPABUENA,
+        AssetConstants::ModelNames::PUESTOPESCADOS,
+        AssetConstants::ModelNames::PUESTOKEKAS });
+    gestorResidencia.declararZona("chinampas", glm::vec3(-150.0f, 0.0f, -150.0f), 150.0f, 190.0f, {
+        AssetConstants::ModelNames::MAIZ });
+
+}
+
+void SceneInformation::cargarModelos()
+{
+    // Los modelos de las zonas quedan registrados sin geometria hasta que la camara se acerque
+    modelManager.cargarModelos(gestorResidencia.getModelosBajoDemanda());
+    gestorResidencia.inicializar(modelManager);
+}
+
 void SceneInformation::inicializarEntidades()
 {
     crearPiso();
@@ -119,6 +186,17 @@ void SceneInformation::inicializarEntidades()
 // Funcion para actualizar cada frame with las cosas que no dependen del input del usuario
 void SceneInformation::actualizarFrame(float deltaTime)
 {
+    // Avanzar la mezcla entre el cielo anterior y el actual; no avanza hasta que
+    // el actual termina de subirse
+    if (skyboxAnterior != nullptr && skyboxActual->estaCompleto()) {
+        tiempoTransicionSkybox += deltaTime;
+        mezclaSkybox = tiempoTransicionSkybox / DURACION_TRANSICION_SKYBOX;
+        if (mezclaSkybox >= 1.0f) {
+            skyboxAnterior = nullptr;
+            mezclaSkybox = 1.0f;
+        }
+    }
+
     // Actualizar el ciclo dia/noche
     acumuladorTiempoDesdeCambio += deltaTime;
     if (acumuladorTiempoDesdeCambio >= 30.0f / LIMIT_FPS) // 30 segundos = 1 minuto
@@ -180,32 +258,6 @@ void SceneInformation::actualizarFrame(float deltaTime)
     }
 
 
-    // Actualizar animación de la canoa y su sonido
-    for (auto* entidad : entidades) {
-        if (entidad != nullptr && entidad->nombreObjeto == "canoa" && entidad->animacion != nullptr) {
-            bool animacionActiva = entidad->animacion->estaActiva(0);
-
-            // Animar la canoa
-            entidad->animacion->animarCanoa(0, deltaTime);
-
-            // Gestionar el SFX del remo
-            if (animacionActiva) {
-                // Obtener la posición actual de la canoa
-                glm::vec3 posicionCanoa = entidad->posicionLocal;
-
-                // Actualizar la posición del sonido si existe, o reproducirlo si no
-                if (!audioManager.actualizarPosicionSonidoAmbiental("remo_canoa", posicionCanoa)) {
-                    // Si no existe, reproducirlo
-                    audioManager.reproducirSonidoAmbiental("remo_canoa", posicionCanoa, 0.5f, true);
-                }
-            }
-            else {
-                // Si la animación se desactiva, detener el sonido
-                audioManager.detenerSonidoAmbiental("remo_canoa");
-            }
-        }
-    }
-
     // Actualizar posición del listener (cámara) para audio 3D
     audioManager.actualizarPosicionListener(camera.getCameraPosition(), camera.getCameraDirection());
 
@@ -213,15 +265,9 @@ void SceneInformation::actualizarFrame(float deltaTime)
     glm::vec3 posicionPersonajeActivo(0.0f);
     Entidad* personajeActivoEntidad = nullptr;
 
-    // Buscar el personaje activo por nombre según personajeActual
-    if (personajeActual == 1) {
-        personajeActivoEntidad = buscarEntidad("cuphead_torso");
-    }
-    else if (personajeActual == 2) {
-        personajeActivoEntidad = buscarEntidad("isaac_cuerpo");
-    }
-    else if (personajeActual == 3) {
-        personajeActivoEntidad = buscarEntidad("gojo");
+    // Buscar el personaje activo por id según personajeActual
+    if (personajeActual >= 1 && personajeActual <= 3) {
+        personajeActivoEntidad = registroEntidades.buscar(idsPersonajes[personajeActual - 1]);
     }
 
     if (personajeActivoEntidad != nullptr) {
@@ -258,138 +304,127 @@ void SceneInformation::actualizarFrame(float deltaTime)
     }
 
 
-    // Actualizar animaciones de las entidades que tengan componente de animacion
-    for (auto* entidad : entidades) {
-        if (entidad != nullptr) {
-            if (entidad->nombreObjeto == "hollow") {
-                entidad->animacion->actualizarAnimacion(0, deltaTime, 1.0);
-            }
-            if (entidad->nombreObjeto == "pedestal_piedra") {
-                entidad->hijos[0]->animacion->actualizarAnimacion(0, deltaTime, 1.0);
-            }
-            if (entidad->nombreObjeto == "fuego_azul" || entidad->nombreObjeto == "fuego_azul2") {
-                pointLightActual = *lightManager.getPointLight(AssetConstants::LightNames::PUNTUAL_AZUL);
-                glm::vec3 posicionLuz = entidad->posicionLocal + glm::vec3(0.0f, 1.0f, 0.0f);
-                pointLightActual.setPosition(posicionLuz);
-
-				agregarLuzPuntualActual(pointLightActual);
-            }
-            // si esta activa la animacion se llama a la funcion de actualizarala
-            if (entidad->nombreObjeto == "puerta_secret_room" && entidad->animacion->estaActiva(0)) {
-                entidad->animacion->actualizarAnimacion(0, deltaTime, 1.0);
-            }
-            if (entidad->nombreObjeto == "pelota") {
-                entidad->animacion->animateKeyframes();
-            }
-
-            // MODIFICADO: Gestionar animación y sonido del pez
-            if (entidad->nombreObjeto == "pez" && entidad->animacion != nullptr) {
-                bool animacionActivaAhora = entidad->animacion->play;
-
-                // Actualizar animación
-                entidad->animacion->animateKeyframes();
-
-                // Gestionar sonido del pez
-                if (animacionActivaAhora && !animacionPezActiva) {
-                    // La animación acaba de activarse
-                    glm::vec3 posicionPez = entidad->posicionLocal;
-                    audioManager.reproducirSonidoAmbiental("pez", posicionPez, 0.8f, true);
-                    animacionPezActiva = true;
-                    std::cout << "[SceneInformation] Sonido del pez activado" << std::endl;
-                }
-                else if (!animacionActivaAhora && animacionPezActiva) {
-                    // La animación acaba de desactivarse
-                    audioManager.detenerSonidoAmbiental("pez");
-                    animacionPezActiva = false;
-                    std::cout << "[SceneInformation] Sonido del pez desactivado" << std::endl;
-                }
-                else if (animacionActivaAhora && animacionPezActiva) {
-                    // Actualizar posición del sonido mientras la animación está activa
-                    glm::vec3 posicionPez = entidad->posicionLocal;
-                    audioManager.actualizarPosicionSonidoAmbiental("pez", posicionPez);
-                }
-            }
-
+    // Las animaciones comparten variables a nivel de archivo en ComponenteAnimacion.cpp (estado
+    // de Hollow, la canoa, el luchador y el generador aleatorio), asi que van juntas en una sola
+    // tarea. Mientras tanto los demas hilos calculan las luces de los emisores, que solo leen
+    // las matrices mundiales del tick anterior
+    const std::vector<EmisorLuz>& emisoresLuz = sistemaComportamientos.getEmisoresLuz();
+    candidatosLuz.resize(emisoresLuz.size());
+    const PointLight* fuegoAzul = lightManager.getPointLight(AssetConstants::LightNames::PUNTUAL_AZUL);
 
-            if (!esDeDia) {
-                // Procesar lámparas de calle y sus luces
-                if (entidad->nombreObjeto.find("lampara_") == 0) {
-                    // Esta es una lámpara de calle
-                    // Buscar su hijo que es la luz
-                    for (auto* hijo : entidad->hijos) {
-                        if (hijo != nullptr && hijo->nombreObjeto == "punto_luz") {
-                            // Calcular la posición mundial de la luz
-                            glm::vec3 posicionMundialLuz = glm::vec3(
-                                entidad->transformacionLocal * glm::vec4(hijo->posicionLocal, 1.0f)
-                            );
-
-                            // Crear luz puntual con color amarillo cálido
-                            pointLightActual = PointLight(
-                                1.0f, 0.9f, 0.7f,  // Color amarillo cálido
-                                0.3f, 0.8f,         // Intensidad ambiental y difusa
-                                posicionMundialLuz.x, posicionMundialLuz.y, posicionMundialLuz.z,
-                                0.3f, 0.1f, 0.005f   // Atenuación constante, lineal, exponencial
-                            );
-                            agregarLuzPuntualActual(pointLightActual);
-
-                            break; // Solo necesitamos procesar una luz por lámpara
-                        }
-                    }
-                }
-            }
-            // Procesar lámparas del ring (base_light) y sus spotlights
-            if (entidad->nombreObjeto.find("base_light_") == 0) {
-                // Solo procesar si las luces del ring están activas
-                // Buscar el lamp_ring hijo y su spotlight
-                for (auto* lampRing : entidad->hijos) {
-                    if (lampRing != nullptr && lampRing->nombreObjeto.find("lamp_ring_") == 0) {
-                        // Encontramos el lamp_ring, ahora buscar el spotlight
-                        for (auto* spotlight : lampRing->hijos) {
-                            if (spotlight != nullptr && spotlight->nombreObjeto == "spotlight_ring") {
-                                // Calcular la posición mundial del spotlight usando las matrices de transformación
-                                glm::vec3 posicionMundialSpotlight = glm::vec3(
-                                    entidad->transformacionLocal * lampRing->transformacionLocal * glm::vec4(spotlight->posicionLocal, 1.0f)
-                                );
-
-                                // La dirección es hacia abajo y hacia el ring
-                                // El ring está aproximadamente en (2.0f, 32.2f, -149.5f)
-                                glm::vec3 posicionRing(2.0f, 32.2f, -149.5f);
-                                glm::vec3 direccionSpotlight = glm::normalize(posicionRing - posicionMundialSpotlight);
-
-                                // Crear spotlight blanco apuntando al ring
-                                spotLightActual = SpotLight(
-                                    1.0f, 1.0f, 1.0f,  // Color blanco
-                                    0.3f, 1.0f,         // Intensidad ambiental y difusa
-                                    posicionMundialSpotlight.x, posicionMundialSpotlight.y, posicionMundialSpotlight.z,
-                                    direccionSpotlight.x, direccionSpotlight.y, direccionSpotlight.z,
-                                    1.0f, 0.05f, 0.01f, // Atenuación constante, lineal, exponencial
-                                    30.0f               // Ángulo de apertura (edge)
-                                );
-                                if (!spotLight2 && entidad->nombreObjeto == "base_light_1") break;
-                                if (!spotLight3 && entidad->nombreObjeto == "base_light_2") break;
-                                agregarSpotLightActual(spotLightActual);
-                                break;
-                            }
-                        }
-                        break;
-                    }
-                }
+    GrafoTareas tareas;
+    tareas.agregar([this, deltaTime]() { actualizarAnimaciones(deltaTime); });
+    tareas.paraCada(static_cast<unsigned int>(emisoresLuz.size()), EMISORES_LUZ_POR_TAREA,
+        [this, &emisoresLuz, fuegoAzul](unsigned int inicio, unsigned int fin) {
+            for (unsigned int i = inicio; i < fin; i++) {
+                calcularLuzEmisor(emisoresLuz[i], fuegoAzul, candidatosLuz[i]);
             }
+        });
+    PlanificadorTareas::instancia().ejecutar(tareas);
+
+    // Sonidos que siguen a una entidad mientras su animación está en curso (canoa, pez)
+    // El audio no entra al grafo de tareas: AudioManager solo se usa desde el hilo que corre el tick
+    for (auto& emisor : sistemaComportamientos.getEmisoresAudio()) {
+        bool animacionActivaAhora = emisor.entidad->animacion->enCurso();
+        glm::vec3 posicionSonido = emisor.entidad->posicionLocal;
+
+        if (animacionActivaAhora && !emisor.sonando) {
+            // La animación acaba de activarse
+            audioManager.reproducirSonidoAmbiental(emisor.sonido, posicionSonido, emisor.volumen, true);
+            emisor.sonando = true;
+            std::cout << "[SceneInformation] Sonido " << emisor.sonido << " activado" << std::endl;
+        }
+        else if (!animacionActivaAhora && emisor.sonando) {
+            // La animación acaba de desactivarse
+            audioManager.detenerSonidoAmbiental(emisor.sonido);
+            emisor.sonando = false;
+            std::cout << "[SceneInformation] Sonido " << emisor.sonido << " desactivado" << std::endl;
+        }
+        else if (animacionActivaAhora) {
+            // Actualizar posición del sonido mientras la animación está activa
+            audioManager.actualizarPosicionSonidoAmbiental(emisor.sonido, posicionSonido);
         }
     }
 
+    // Las luces se agregan en el orden de los emisores para que el resultado no dependa de los hilos
+    for (const CandidatoLuz& candidato : candidatosLuz) {
+        if (candidato.tipo == CandidatoLuz::PUNTUAL) {
+            agregarLuzPuntualActual(candidato.puntual);
+        }
+        else if (candidato.tipo == CandidatoLuz::SPOT) {
+            agregarSpotLightActual(candidato.spot);
+        }
+    }
+}
 
-    // Actualizar animación del luchador
-    Entidad* luchadorEntidad = nullptr;
-    Entidad* primoEntidad = nullptr;
-    for (auto* entidad : entidades) {
-        if (entidad != nullptr) {
-            if (entidad->nombreObjeto == "luchador_torso") luchadorEntidad = entidad;
-            if (entidad->nombreObjeto == "primo") primoEntidad = entidad;
+// Animaciones por componente y por keyframes; se ejecutan en orden en un solo hilo
+void SceneInformation::actualizarAnimaciones(float deltaTime)
+{
+    // Actualizar animaciones de las entidades que tengan componente de animacion
+    // Cada lista solo contiene las entidades registradas con ese comportamiento al crearse
+    for (auto* entidad : sistemaComportamientos.getAnimadas()) {
+        entidad->animacion->actualizarAnimacion(0, deltaTime, 1.0);
+    }
+    // Cada llamada a animateKeyframes es un paso de 1/60 s, asi que con otra frecuencia de
+    // ticks se llaman las veces que correspondan al tiempo simulado
+    acumuladorKeyframes += deltaTime;
+    while (acumuladorKeyframes >= 1.0f) {
+        for (auto* entidad : sistemaComportamientos.getKeyframes()) {
+            entidad->animacion->animateKeyframes();
         }
+        acumuladorKeyframes -= 1.0f;
+    }
+}
+
+// Luz de un emisor en su posicion mundial (no modifica la escena, se llama desde los hilos de trabajo)
+void SceneInformation::calcularLuzEmisor(const EmisorLuz& emisor, const PointLight* fuegoAzul, CandidatoLuz& candidato) const
+{
+    candidato.tipo = CandidatoLuz::NINGUNA;
+    if (emisor.encendida != nullptr && !*emisor.encendida) return;
+
+    // Posición mundial de la entidad fuente de la luz
+    glm::vec3 posicionMundialLuz = glm::vec3(emisor.fuente->transformacionMundial[3]) + emisor.desplazamiento;
+
+    switch (emisor.tipo) {
+    case TipoEmisorLuz::FUEGO_AZUL:
+        if (fuegoAzul == nullptr) break;
+        candidato.puntual = *fuegoAzul;
+        candidato.puntual.setPosition(posicionMundialLuz);
+        candidato.tipo = CandidatoLuz::PUNTUAL;
+        break;
+
+    case TipoEmisorLuz::LAMPARA_CALLE:
+        // Las lámparas de calle solo se prenden de noche
+        if (esDeDia) break;
+
+        // Crear luz puntual con color amarillo cálido
+        candidato.puntual = PointLight(
+            1.0f, 0.9f, 0.7f,  // Color amarillo cálido
+            0.3f, 0.8f,         // Intensidad ambiental y difusa
+            posicionMundialLuz.x, posicionMundialLuz.y, posicionMundialLuz.z,
+            0.3f, 0.1f, 0.005f   // Atenuación constante, lineal, exponencial
+        );
+        candidato.tipo = CandidatoLuz::PUNTUAL;
+        break;
+
+    case TipoEmisorLuz::SPOT_RING: {
+        // La dirección es hacia abajo y hacia el ring
+        // El ring está aproximadamente en (2.0f, 32.2f, -149.5f)
+        glm::vec3 posicionRing(2.0f, 32.2f, -149.5f);
+        glm::vec3 direccionSpotlight = glm::normalize(posicionRing - posicionMundialLuz);
+
+        // Crear spotlight blanco apuntando al ring
+        candidato.spot = SpotLight(
+            1.0f, 1.0f, 1.0f,  // Color blanco
+            0.3f, 1.0f,         // Intensidad ambiental y difusa
+            posicionMundialLuz.x, posicionMundialLuz.y, posicionMundialLuz.z,
+            direccionSpotlight.x, direccionSpotlight.y, direccionSpotlight.z,
+            1.0f, 0.05f, 0.01f, // Atenuación constante, lineal, exponencial
+            30.0f               // Ángulo de apertura (edge)
+        );
+        candidato.tipo = CandidatoLuz::SPOT;
+        break;
     }
-    if (luchadorEntidad != nullptr && primoEntidad != nullptr && luchadorEntidad->animacion != nullptr) {
-        luchadorEntidad->animacion->animarLuchador(0, deltaTime, primoEntidad);
     }
 }
 // Funcion para actualizar cada frame con el input del usuario
@@ -408,7 +443,7 @@ void SceneInformation::actualizarFrameInput(bool* keys, GLfloat mouseXChange, GL
     // Se maneja todo lo del teclado que no tenga que ver con la camara
     // 1: Cambia el modo tercera persona a cuphead
     if (keys[GLFW_KEY_1]) {
-        Entidad* cuphead = buscarEntidad("cuphead_torso");
+        Entidad* cuphead = registroEntidades.buscar(idsPersonajes[0]);
         if (cuphead != nullptr) {
             camera.setThirdPersonTarget(cuphead);
             personajeActual = 1;
@@ -416,7 +451,7 @@ void SceneInformation::actualizarFrameInput(bool* keys, GLfloat mouseXChange, GL
     }
     // 2: Cambia el modo tercera persona a Isaac
     if (keys[GLFW_KEY_2]) {
-        Entidad* isaac = buscarEntidad("isaac_cuerpo");
+        Entidad* isaac = registroEntidades.buscar(idsPersonajes[1]);
         if (isaac != nullptr) {
             camera.setThirdPersonTarget(isaac);
             personajeActual = 2;
@@ -424,30 +459,30 @@ void SceneInformation::actualizarFrameInput(bool* keys, GLfloat mouseXChange, GL
     }
     // 3: Cambia el modo tercera persona a Gojo
     if (keys[GLFW_KEY_3]) {
-        Entidad* gojo = buscarEntidad("gojo");
+        Entidad* gojo = registroEntidades.buscar(idsPersonajes[2]);
         if (gojo != nullptr) {
             camera.setThirdPersonTarget(gojo);
             personajeActual = 3;
         }
     }
-    // Se itera sobre las entidades para hacer acciones especificas
-    for (auto* entidad : entidades) {
-        if (entidad->nombreObjeto == "puerta_secret_room") {
-            // Z: Se abre o cierra la puerta secreta
-            if (keys[GLFW_KEY_Z]) {
-                entidad->animacion->activarAnimacion(0); // Activar animacion de abrir puerta
-                audioManager.reproducirSonidoAmbiental("abrir_puerta", glm::vec3(180.0f, 8.25f, 200.0f), 0.5f, false);
-            }
+    // Se consultan las entidades con acciones especificas por su id
+    // Z: Se abre o cierra la puerta secreta
+    if (keys[GLFW_KEY_Z]) {
+        for (auto* entidad : registroEntidades.getEntidades(idPuertaSecreta)) {
+            entidad->animacion->activarAnimacion(0); // Activar animacion de abrir puerta
+            audioManager.reproducirSonidoAmbiental("abrir_puerta", glm::vec3(180.0f, 8.25f, 200.0f), 0.5f, false);
         }
-        // P: Lanza la pelota del juego de pelota maya
-        if (entidad->nombreObjeto == "pelota") {
-            if (keys[GLFW_KEY_P]) {
-                entidad->animacion->play = true;
-            }
+    }
+    // P: Lanza la pelota del juego de pelota maya
+    if (keys[GLFW_KEY_P]) {
+        for (auto* entidad : registroEntidades.getEntidades(idPelota)) {
+            entidad->animacion->play = true;
         }
-        // B: Activa la animación del pez por keyframes
-        if (entidad->nombreObjeto == "pez" && entidad->animacion != nullptr) {
-            if (keys[GLFW_KEY_B]) {
+    }
+    // B: Activa la animación del pez por keyframes
+    if (keys[GLFW_KEY_B]) {
+        for (auto* entidad : registroEntidades.getEntidades(idPez)) {
+            if (entidad->animacion != nullptr) {
                 entidad->animacion->play = true;
             }
         }
@@ -457,8 +492,8 @@ void SceneInformation::actualizarFrameInput(bool* keys, GLfloat mouseXChange, GL
     static bool teclaGPresionada = false;
     if (keys[GLFW_KEY_G]) {
         if (!teclaGPresionada) {
-            for (auto* entidad : entidades) {
-                if (entidad != nullptr && entidad->nombreObjeto == "canoa" && entidad->animacion != nullptr) {
+            for (auto* entidad : registroEntidades.getEntidades(idCanoa)) {
+                if (entidad->animacion != nullptr) {
                     if (entidad->animacion->estaActiva(0)) {
                         entidad->animacion->desactivarAnimacion(0);
                     }
@@ -567,7 +602,7 @@ void SceneInformation::crearPersonajePrincipal()
     cuphead_torso->fisica->gravedad = -0.5f;
 
     // Crear y configurar componente de animación
-    cuphead_torso->animacion = new ComponenteAnimacion(cuphead_torso);
+    cuphead_torso->animacion = new ComponenteAnimacion(cuphead_torso, TipoAnimacion::CUPHEAD);
 
     // 2. Crear la cabeza (hijo del torso)
     Entidad* cuphead_cabeza = new Entidad("cuphead_cabeza",
@@ -762,7 +797,7 @@ void SceneInformation::crearIsaac()
     isaac_cuerpo->fisica->gravedad = -0.5f;
 
     // Crear y configurar componente de animación
-    isaac_cuerpo->animacion = new ComponenteAnimacion(isaac_cuerpo);
+    isaac_cuerpo->animacion = new ComponenteAnimacion(isaac_cuerpo, TipoAnimacion::ISAAC);
 
     isaac_brazo_derecho->setTipoObjeto(TipoObjeto::MODELO);
     isaac_brazo_derecho->nombreModelo = AssetConstants::ModelNames::ISAAC_BRAZO_DERECHO;
@@ -808,8 +843,10 @@ void SceneInformation::crearLuchador()
         modelManager.getModel(AssetConstants::ModelNames::LUCHADOR_TORSO));
     luchador_torso->setMaterial(AssetConstants::MaterialNames::BRILLANTE,
         materialManager.getMaterial(AssetConstants::MaterialNames::BRILLANTE));
-    luchador_torso->animacion = new ComponenteAnimacion(luchador_torso);
+    luchador_torso->animacion = new ComponenteAnimacion(luchador_torso, TipoAnimacion::LUCHADOR);
     luchador_torso->animacion->activarAnimacion(0);  // Activate luchador animation
+    luchador_torso->animacion->objetivo = buscarEntidad("primo");  // El primo se crea antes que el luchador
+    sistemaComportamientos.registrarAnimada(luchador_torso);
 
     // No necesita física ni animación ya que es estático
 
@@ -938,7 +975,8 @@ void SceneInformation::crearPuertaSecreta() {
     puerta->nombreModelo = AssetConstants::ModelNames::PUERTA_SECRET_ROOM;
     puerta->nombreMaterial = AssetConstants::MaterialNames::OPACO;
 
-    puerta->animacion = new ComponenteAnimacion(puerta);
+    puerta->animacion = new ComponenteAnimacion(puerta, TipoAnimacion::PUERTA);
+    sistemaComportamientos.registrarAnimada(puerta);
 
     agregarEntidad(puerta);
 }
@@ -1004,6 +1042,7 @@ void SceneInformation::crearFogatas() {
     fogata2->setTipoObjeto(TipoObjeto::MODELO);
     fogata2->nombreModelo = AssetConstants::ModelNames::FUEGO_AZUL;
     fogata2->nombreMaterial = AssetConstants::MaterialNames::BRILLANTE;
+    sistemaComportamientos.registrarEmisorLuz(fogata2, TipoEmisorLuz::FUEGO_AZUL, nullptr, glm::vec3(0.0f, 1.0f, 0.0f));
 
     agregarEntidad(fogata2);
 
@@ -1015,6 +1054,7 @@ void SceneInformation::crearFogatas() {
     fogata4->setTipoObjeto(TipoObjeto::MODELO);
     fogata4->nombreModelo = AssetConstants::ModelNames::FUEGO_AZUL;
     fogata4->nombreMaterial = AssetConstants::MaterialNames::BRILLANTE;
+    sistemaComportamientos.registrarEmisorLuz(fogata4, TipoEmisorLuz::FUEGO_AZUL, nullptr, glm::vec3(0.0f, 1.0f, 0.0f));
 
     agregarEntidad(fogata4);
 
@@ -1067,7 +1107,8 @@ void SceneInformation::crearComidaPerro() {
     comida->nombreModelo = AssetConstants::ModelNames::COMIDA_PERRO;
     comida->nombreMaterial = AssetConstants::MaterialNames::BRILLANTE;
 
-    comida->animacion = new ComponenteAnimacion(comida);
+    comida->animacion = new ComponenteAnimacion(comida, TipoAnimacion::COMIDA_PERRO);
+    sistemaComportamientos.registrarAnimada(comida);
 
     pedestal->agregarHijo(comida);
 
@@ -1142,6 +1183,7 @@ void SceneInformation::crearCamino()
     camino->nombreMesh = AssetConstants::MeshNames::CAMINO;
     camino->nombreTextura = AssetConstants::TextureNames::EMPEDRADO;
     camino->nombreMaterial = AssetConstants::MaterialNames::OPACO;
+    camino->estatica = true;
     camino->actualizarTransformacion();
     agregarEntidad(camino);
 }
@@ -1159,6 +1201,7 @@ void SceneInformation::crearChinampaAgua()
     chinampaAgua->nombreMesh = AssetConstants::MeshNames::CHINAMPA_AGUA;
     chinampaAgua->nombreTextura = AssetConstants::TextureNames::AGUA;
     chinampaAgua->nombreMaterial = AssetConstants::MaterialNames::BRILLANTE;
+    chinampaAgua->estatica = true;
     chinampaAgua->actualizarTransformacion();
     agregarEntidad(chinampaAgua);
 }
@@ -1216,6 +1259,7 @@ void SceneInformation::crearIslas()
                 chinampaIsla->nombreTextura = AssetConstants::TextureNames::TIERRA;
             }
             chinampaIsla->nombreMaterial = AssetConstants::MaterialNames::OPACO;
+            chinampaIsla->estatica = true;
             chinampaIsla->actualizarTransformacion();
 
             // Si es columna 1, agregar 3 maíces como hijos con posiciones aleatorias
@@ -1241,6 +1285,7 @@ void SceneInformation::crearIslas()
                     maiz->setTipoObjeto(TipoObjeto::MODELO);
                     maiz->nombreModelo = AssetConstants::ModelNames::MAIZ;
                     maiz->nombreMaterial = AssetConstants::MaterialNames::OPACO;
+                    maiz->estatica = true;
                     maiz->actualizarTransformacion();
 
                     // Agregar maíz como hijo del prisma
@@ -1493,8 +1538,10 @@ void SceneInformation::crearCanoa()
     canoa->setTipoObjeto(TipoObjeto::MODELO);
     canoa->nombreModelo = AssetConstants::ModelNames::CANOA;
     canoa->nombreMaterial = AssetConstants::MaterialNames::OPACO;
-    canoa->animacion = new ComponenteAnimacion(canoa);
+    canoa->animacion = new ComponenteAnimacion(canoa, TipoAnimacion::CANOA);
     canoa->animacion->activarAnimacion(0);  // Activar animación de la canoa
+    sistemaComportamientos.registrarAnimada(canoa);
+    sistemaComportamientos.registrarEmisorAudio(canoa, "remo_canoa", 0.5f);
     canoa->actualizarTransformacion();
 
     // Crear maya como hijo de la canoa
@@ -1536,6 +1583,7 @@ void SceneInformation::crearCanchaPelotaMaya()
     paredIzquierda->nombreMesh = AssetConstants::MeshNames::CANCHA_PARED;
     paredIzquierda->nombreTextura = AssetConstants::TextureNames::MAYAN_BRICKS;
     paredIzquierda->nombreMaterial = AssetConstants::MaterialNames::OPACO;
+    paredIzquierda->estatica = true;
     paredIzquierda->actualizarTransformacion();
 
     // Crear techo triangular izquierdo
@@ -1548,6 +1596,7 @@ void SceneInformation::crearCanchaPelotaMaya()
     techoIzquierdo->nombreMesh = AssetConstants::MeshNames::CANCHA_TECHO;
     techoIzquierdo->nombreTextura = AssetConstants::TextureNames::MAYAN_BRICKS;
     techoIzquierdo->nombreMaterial = AssetConstants::MaterialNames::OPACO;
+    techoIzquierdo->estatica = true;
     techoIzquierdo->actualizarTransformacion();
 
     // Agregar techo como hijo de la pared izquierda
@@ -1569,6 +1618,7 @@ void SceneInformation::crearCanchaPelotaMaya()
     paredDerecha->nombreMesh = AssetConstants::MeshNames::CANCHA_PARED;
     paredDerecha->nombreTextura = AssetConstants::TextureNames::MAYAN_BRICKS;
     paredDerecha->nombreMaterial = AssetConstants::MaterialNames::OPACO;
+    paredDerecha->estatica = true;
     paredDerecha->actualizarTransformacion();
 
     // Crear techo triangular derecho 
@@ -1581,6 +1631,7 @@ void SceneInformation::crearCanchaPelotaMaya()
     techoDerecho->nombreMesh = AssetConstants::MeshNames::CANCHA_TECHO;
     techoDerecho->nombreTextura = AssetConstants::TextureNames::MAYAN_BRICKS;
     techoDerecho->nombreMaterial = AssetConstants::MaterialNames::OPACO;
+    techoDerecho->estatica = true;
     techoDerecho->actualizarTransformacion();
 
     Entidad* aroCancha = new Entidad("cancha_aro",
@@ -1591,6 +1642,7 @@ void SceneInformation::crearCanchaPelotaMaya()
     aroCancha->nombreMesh = AssetConstants::MeshNames::TOROIDE;
     aroCancha->nombreTextura = AssetConstants::TextureNames::MAYAN_BRICKS;
     aroCancha->nombreMaterial = AssetConstants::MaterialNames::OPACO;
+    aroCancha->estatica = true;
     aroCancha->actualizarTransformacion();
 
     // Agregar techo y aro como hijos de la pared derecha
@@ -1612,7 +1664,8 @@ void SceneInformation::crearHollow() {
     cabeza_hollow->actualizarTransformacion();
 
     // Crear y configurar componente de animación
-    cabeza_hollow->animacion = new ComponenteAnimacion(cabeza_hollow);
+    cabeza_hollow->animacion = new ComponenteAnimacion(cabeza_hollow, TipoAnimacion::HOLLOW);
+    sistemaComportamientos.registrarAnimada(cabeza_hollow);
 
 
     Entidad* cuerpo_hollow1 = new Entidad("cuerpo_hollow1",
@@ -1824,6 +1877,8 @@ void SceneInformation::crearPez() {
 
     // Cargar keyframes para la animación del pez (similar a la pelota)
     pez->animacion->cargarKeyframes();
+    sistemaComportamientos.registrarKeyframes(pez);
+    sistemaComportamientos.registrarEmisorAudio(pez, "pez", 0.8f);
 
     agregarEntidad(pez);
 }
@@ -1912,6 +1967,7 @@ void SceneInformation::creaCarpa()
 
         entidad->setMaterial(AssetConstants::MaterialNames::BRILLANTE,
             materialManager.getMaterial(AssetConstants::MaterialNames::BRILLANTE));
+        entidad->estatica = true;
         entidad->actualizarTransformacion();
 
         return entidad;
@@ -1939,6 +1995,7 @@ void SceneInformation::crearPelotaDeJuegoDePelota() {
     // Crear y configurar componente de animación
     pelota->animacion = new ComponenteAnimacion(pelota);
     pelota->animacion->cargarKeyframes();
+    sistemaComportamientos.registrarKeyframes(pelota);
     agregarEntidad(pelota);
 
 }
@@ -2181,6 +2238,7 @@ void SceneInformation::crearLamparasCalles()
             glm::vec3(1.0f, 1.0f, 1.0f));
 
         luzIzq->nombreObjeto = "punto_luz";
+        sistemaComportamientos.registrarEmisorLuz(luzIzq, TipoEmisorLuz::LAMPARA_CALLE);
 
         lamparaIzq->agregarHijo(luzIzq);
         lamparaIzq->actualizarTransformacion();
@@ -2206,6 +2264,7 @@ void SceneInformation::crearLamparasCalles()
             glm::vec3(1.0f, 1.0f, 1.0f));
 
         luzDer->nombreObjeto = "punto_luz";
+        sistemaComportamientos.registrarEmisorLuz(luzDer, TipoEmisorLuz::LAMPARA_CALLE);
 
         lamparaDer->agregarHijo(luzDer);
         lamparaDer->actualizarTransformacion();
@@ -2269,6 +2328,7 @@ void SceneInformation::crearLamparasRing()
         glm::vec3(1.0f, 1.0f, 1.0f));
 
     spotlight1->nombreObjeto = "spotlight_ring";
+    sistemaComportamientos.registrarEmisorLuz(spotlight1, TipoEmisorLuz::SPOT_RING, &spotLight2);
 
     lampRing1->agregarHijo(spotlight1);
     baseLamp1->agregarHijo(lampRing1);
@@ -2306,6 +2366,7 @@ void SceneInformation::crearLamparasRing()
         glm::vec3(1.0f, 1.0f, 1.0f));
 
     spotlight2->nombreObjeto = "spotlight_ring";
+    sistemaComportamientos.registrarEmisorLuz(spotlight2, TipoEmisorLuz::SPOT_RING, &spotLight3);
 
     lampRing2->agregarHijo(spotlight2);
     baseLamp2->agregarHijo(lampRing2);
@@ -2318,6 +2379,9 @@ void SceneInformation::agregarEntidad(Entidad* entidad)
         // Vincular recursos (modelos, meshes y texturas) antes de agregar
         vincularRecursos(entidad);
         entidades.push_back(entidad);
+        registroEntidades.registrar(entidad);
+        grafoEscena.marcarReconstruccion();
+        if (entidad->estatica) lotesEstaticosSucios = true;
     }
 }
 
@@ -2329,28 +2393,136 @@ void SceneInformation::removerEntidad(Entidad* entidad)
     auto it = std::find(entidades.begin(), entidades.end(), entidad);
     if (it != entidades.end()) {
         entidades.erase(it);
+        registroEntidades.remover(entidad);
+        sistemaComportamientos.remover(entidad);
+        grafoEscena.marcarReconstruccion();
+        if (entidad->estatica) lotesEstaticosSucios = true;
     }
     // Nota: NO se elimina la entidad, solo se elimina del vector
 }
 
-Entidad* SceneInformation::buscarEntidad(const std::string& nombre)
+void SceneInformation::simularTick(bool* keys, GLfloat mouseXChange, GLfloat mouseYChange, GLfloat scrollChange, float deltaTick)
 {
-    // Buscar una entidad por nombre de objeto
-    for (auto* entidad : entidades) {
-        if (entidad != nullptr) {
-            // Buscar primero por nombreObjeto si existe
-            if (!entidad->nombreObjeto.empty() && entidad->nombreObjeto == nombre) {
-                return entidad;
-            }
-        }
+    camaraAnterior = camera;
+
+    actualizarFrameInput(keys, mouseXChange, mouseYChange, scrollChange, deltaTick);
+    actualizarFrame(deltaTick);
+    actualizarTransformaciones();
+
+    // En tercera persona y vista aérea la posición se calcula al pedir la vista; se fija
+    // aquí para que el estado del tick quede completo
+    camera.calculateViewMatrix();
+}
+
+void SceneInformation::prepararRender(float alpha)
+{
+    grafoEscena.interpolar(alpha);
+    camaraRender = camera;
+    camaraRender.interpolateFrom(camaraAnterior, alpha);
+}
+
+void SceneInformation::llenarPaqueteFrame(PaqueteFrame& paquete, float alpha)
+{
+    prepararRender(alpha);
+
+    paquete.vista = camaraRender.calculateViewMatrix();
+    paquete.posicionCamara = camaraRender.getCameraPosition();
+    paquete.terceraPersona = camera.isThirdPersonMode();
+
+    paquete.skybox = skyboxActual;
+    paquete.skyboxAnterior = skyboxAnterior;
+    paquete.mezclaSkybox = mezclaSkybox;
+
+    paquete.luzDireccional = luzDireccional;
+    std::copy(pointLightsActuales, pointLightsActuales + pointLightCountActual, paquete.lucesPuntuales);
+    paquete.numLucesPuntuales = pointLightCountActual;
+    std::copy(spotLightsActuales, spotLightsActuales + spotLightCountActual, paquete.lucesSpot);
+    paquete.numLucesSpot = spotLightCountActual;
+
+    paquete.capturarGrafo(grafoEscena);
+    paquete.lotesEstaticos = &lotesEstaticos;
+}
+
+bool SceneInformation::actualizarRecursosGPU()
+{
+    // Cargar/descargar las zonas cercanas; los volumenes dependen de la geometria
+    modelosCambiados.clear();
+    gestorResidencia.actualizar(camera.getCameraPosition(), modelosCambiados);
+    if (!modelosCambiados.empty()) {
+        grafoEscena.marcarReconstruccion();
+    }
+
+    // Subir las caras de los skyboxes que ya se decodificaron
+    skyboxManager.actualizar();
+
+    if (!lotesEstaticosSucios && !grafoEscena.necesitaReconstruccion()) {
+        return false;
+    }
+    actualizarTransformaciones();
+    if (lotesEstaticosSucios) {
+        hornearLotesEstaticos();
+    }
+    // Por la residencia solo se vuelven a hornear las celdas con entidades estaticas de los
+    // modelos que cambiaron
+    else if (!modelosCambiados.empty() && lotesEstaticos.reconstruir(grafoEscena, modelosCambiados)) {
+        grafoEscena.reconstruir(entidades);
+        grafoEscena.actualizarTransformaciones();
     }
-    return nullptr;
+    return true;
+}
+
+void SceneInformation::cargarTodosLosRecursos()
+{
+    modelosCambiados.clear();
+    gestorResidencia.cargarTodas(modelosCambiados);
+    skyboxManager.completarTodos();
+
+    // Con todas las zonas residentes se hornean los lotes desde cero
+    grafoEscena.marcarReconstruccion();
+    actualizarTransformaciones();
+    lotesEstaticosSucios = true;
+    hornearLotesEstaticos();
+}
+
+void SceneInformation::actualizarTransformaciones()
+{
+    // Solo se reconstruye el grafo si se agregaron o quitaron entidades
+    if (grafoEscena.necesitaReconstruccion()) {
+        grafoEscena.reconstruir(entidades);
+    }
+    grafoEscena.actualizarTransformaciones();
+}
+
+void SceneInformation::hornearLotesEstaticos()
+{
+    if (!lotesEstaticosSucios) return;
+
+    // Los lotes se hornean con las matrices mundiales ya calculadas; despues se reconstruye
+    // el grafo para que los nodos horneados queden marcados y el renderer los salte
+    lotesEstaticos.construir(grafoEscena);
+    grafoEscena.reconstruir(entidades);
+    grafoEscena.actualizarTransformaciones();
+    lotesEstaticosSucios = false;
+}
+
+Entidad* SceneInformation::buscarEntidad(const std::string& nombre)
+{
+    // Buscar una entidad por nombre de objeto en el registro
+    if (nombre.empty()) return nullptr;
+    return registroEntidades.buscar(nombre);
 }
 
 
 void SceneInformation::setSkyboxActual(const std::string& skyboxName)
 {
-    skyboxActual = skyboxManager.getSkybox(skyboxName);
+    Skybox* nuevo = skyboxManager.getSkybox(skyboxName);
+    if (nuevo == nullptr || nuevo == skyboxActual) return;
+
+    // Si ya habia un cielo se hace un fundido desde el que se estaba viendo
+    skyboxAnterior = skyboxActual;
+    tiempoTransicionSkybox = 0.0f;
+    mezclaSkybox = skyboxAnterior != nullptr ? 0.0f : 1.0f;
+    skyboxActual = nuevo;
 }
 
 void SceneInformation::setLuzDireccional(const DirectionalLight& light)
@@ -2373,12 +2545,12 @@ bool SceneInformation::agregarLuzPuntualActual(const PointLight& light)
     indiceLuzMasLejana = -1;
 
     // Buscar la luz más lejana
-    for (int i = 0; i < pointLightCountActual; i++) {
+    for (unsigned int i = 0; i < pointLightCountActual; i++) {
         distanciaLuzActual = glm::distance(camera.getCameraPosition(), pointLightsActuales[i].GetPosition());
 
         if (distanciaLuzActual > distanciaMaxima) {
             distanciaMaxima = distanciaLuzActual;
-            indiceLuzMasLejana = i;
+            indiceLuzMasLejana = static_cast<int>(i);
         }
     }
 
@@ -2411,12 +2583,12 @@ bool SceneInformation::agregarSpotLightActual(const SpotLight& light)
     indiceLuzMasLejana = -1;
 
     // Buscar la luz más lejana
-    for (int i = 0; i < spotLightCountActual; i++) {
+    for (unsigned int i = 0; i < spotLightCountActual; i++) {
         distanciaLuzActual = glm::distance(camera.getCameraPosition(), spotLightsActuales[i].GetPosition());
 
         if (distanciaLuzActual > distanciaMaxima) {
             distanciaMaxima = distanciaLuzActual;
-            indiceLuzMasLejana = i;
+            indiceLuzMasLejana = static_cast<int>(i);
         }
     }
 
@@ -2604,6 +2776,11 @@ void SceneInformation::vincularRecursos(Entidad* entidad)
         }
     }
 
+    // Los modelos de entidades estaticas conservan su geometria en memoria para los lotes
+    if (entidad->estatica && entidad->getModelo() != nullptr) {
+        entidad->getModelo()->ConservarGeometria();
+    }
+
     // Vincular mesh si la entidad usa un mesh
     if (entidad->getTipoObjeto() == TipoObjeto::MESH) {
         std::string meshName = entidad->nombreMesh;
@@ -2649,6 +2826,7 @@ void SceneInformation::crearPiso()
     piso->nombreMaterial = AssetConstants::MaterialNames::OPACO;
     piso->posicionLocal = glm::vec3(0.0f, -1.0f, 0.0f);
     piso->escalaLocal = glm::vec3(30.0f, 1.0f, 30.0f);
+    piso->estatica = true;
     piso->actualizarTransformacion();
     agregarEntidad(piso);
 }
\ No newline at end of file
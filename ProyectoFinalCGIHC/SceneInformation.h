@@ -3,8 +3,13 @@
 #include <vector>
 #include <string>
 #include "Entidad.h"
+#include "SceneGraph.h"
+#include "LotesEstaticos.h"
+#include "RegistroEntidades.h"
+#include "SistemaComportamientos.h"
 #include "ModelManager.h"
 #include "TextureManager.h"
+#include "GestorResidencia.h"
 #include "MeshManager.h"
 #include "SkyboxManager.h"
 #include "MaterialManager.h"
@@ -16,6 +21,16 @@
 #include "SpotLight.h"
 #include "CommonValues.h"
 #include "Camera.h"
+#include "PlanificadorTareas.h"
+#include "PaqueteFrame.h"
+
+// Luz que calcula un emisor en un hilo de trabajo antes de agregarse a las luces actuales
+struct CandidatoLuz {
+    enum Tipo { NINGUNA, PUNTUAL, SPOT };
+    Tipo tipo;
+    PointLight puntual;
+    SpotLight spot;
+};
 
 // Clase para gestionar la información de la escena
 // Se enfoca en gestión de recursos, entidades e iluminación
@@ -48,6 +63,31 @@ public:
     // Actualizar la escena cada frame dependiendo del input del usuario
     void actualizarFrameInput(bool* keys, GLfloat mouseXChange, GLfloat mouseYChange, GLfloat scrollChange, float deltaTime);
 
+    // Pasada que actualiza las matrices mundiales antes de renderizar
+    void actualizarTransformaciones();
+
+    // Un tick de la simulación con paso fijo: input, actualizarFrame y transformaciones
+    // Antes de avanzar se guarda la cámara del tick anterior para interpolar
+    // No llama a OpenGL, así que puede correr en el hilo de simulación
+    void simularTick(bool* keys, GLfloat mouseXChange, GLfloat mouseYChange, GLfloat scrollChange, float deltaTick);
+
+    // Preparar la cámara y las matrices con las que se dibuja entre el tick anterior y el actual
+    void prepararRender(float alpha);
+
+    // Copiar al paquete lo que se dibuja (cámara, cielo, luces y nodos) interpolado con alpha
+    // Solo lee el estado de la simulación, así que se llama desde el hilo que simula
+    void llenarPaqueteFrame(PaqueteFrame& paquete, float alpha);
+
+    // Lo que llama a OpenGL y no puede ir en un tick: subir los modelos y skyboxes que ya se
+    // cargaron y volver a hornear los lotes estáticos. Se llama en el hilo principal cuando
+    // la simulación no está corriendo; true si cambiaron los nodos del grafo
+    bool actualizarRecursosGPU();
+
+    // Cargar y subir de una vez los modelos de todas las zonas y los skyboxes, y volver a
+    // hornear los lotes, para que el benchmark mida siempre los mismos recursos
+    // (hilo principal, antes de crear la TuberiaFrames)
+    void cargarTodosLosRecursos();
+
     // Agregar una entidad a la escena
     void agregarEntidad(Entidad* entidad);
 
@@ -57,12 +97,22 @@ public:
 
     // Acceso a la cámara
     Camera& getCamara() { return camera; }
+    const GestorResidencia& getGestorResidencia() const { return gestorResidencia; }
     const Camera& getCamara() const { return camera; }
 
+    // Cámara interpolada para dibujar (válida después de prepararRender)
+    Camera& getCamaraRender() { return camaraRender; }
+
     // Acceso a las entidades
     std::vector<Entidad*>& getEntidades() { return entidades; }
     const std::vector<Entidad*>& getEntidades() const { return entidades; }
 
+    // Acceso al almacenamiento plano de la jerarquia
+    const SceneGraph& getGrafoEscena() const { return grafoEscena; }
+
+    // Geometria horneada de las entidades estaticas
+    const LotesEstaticos& getLotesEstaticos() const { return lotesEstaticos; }
+
     // Establecer el skybox actual de la escena
     void setSkyboxActual(const std::string& skyboxName);
 
@@ -100,10 +150,38 @@ public:
 private:
     // Vector con todas las entidades de la escena
     std::vector<Entidad*> entidades;
+
+    // Jerarquia aplanada que se usa para actualizar y renderizar
+    SceneGraph grafoEscena;
+
+    // Lotes con la geometria de las entidades estaticas (piso, camino, islas, cancha, mercado)
+    LotesEstaticos lotesEstaticos;
+    bool lotesEstaticosSucios = false;
+    // Modelos que entraron o salieron de memoria en el frame
+    std::vector<const Model*> modelosCambiados;
+
+    // Indice por nombre y por grupos de las entidades raiz
+    RegistroEntidades registroEntidades;
+
+    // Ids internados de las entidades que se consultan cada frame
+    int idsPersonajes[3];
+    int idCanoa;
+    int idPuertaSecreta;
+    int idPelota;
+    int idPez;
+
+    // Listas de entidades por comportamiento (animadas, luces, audio, keyframes)
+    SistemaComportamientos sistemaComportamientos;
     std::vector<glm::vec3> posicionesGrillos;
 
+    // Una entrada por emisor de luz, en el mismo orden
+    std::vector<CandidatoLuz> candidatosLuz;
+
     // Cámara de la escena
     Camera camera;
+    // Cámara al final del tick anterior y la mezcla con la que se dibuja
+    Camera camaraAnterior;
+    Camera camaraRender;
 
     // Managers de recursos
     ModelManager modelManager;
@@ -112,11 +190,21 @@ private:
     SkyboxManager skyboxManager;
     MaterialManager materialManager;
     LightManager lightManager;
+    // Se inicializa y se limpia en el hilo principal; en medio solo la usan los ticks, que con
+    // TuberiaFrames corren en el hilo de simulacion
     AudioManager audioManager;
 
+    // Modelos de las zonas que se cargan y descargan segun la distancia de la camara
+    GestorResidencia gestorResidencia;
+
     // Skybox actual de la escena
     Skybox* skyboxActual;
 
+    // Skybox que se desvanece mientras entra el actual (nullptr sin transicion)
+    Skybox* skyboxAnterior;
+    GLfloat tiempoTransicionSkybox = 0.0f;
+    GLfloat mezclaSkybox = 1.0f;
+
     // Luz direccional
     DirectionalLight luzDireccional;
 
@@ -135,11 +223,12 @@ private:
 
     // Booleano para saber si es de dia
     bool esDeDia = false;
-    bool animacionPezActiva = false;
     bool sonidoCaminataActivo = false;
     glm::vec3 posicionAnteriorPersonaje = glm::vec3(0.0f);
     // Acumulador de tiempo para cambiar entre dia y noche (a los 2 minutos se cambia)
     GLfloat acumuladorTiempoDesdeCambio = 0.0f;
+    // Tiempo pendiente para los keyframes, que avanzan un paso por cada frame de LIMIT_FPS
+    GLfloat acumuladorKeyframes = 0.0f;
 
     // Entero para saber que personaje es actualmente
     int personajeActual = 1; // 1: Cuphead, 2: Isaac, 3: Gojo
@@ -161,12 +250,28 @@ private:
     // Inicializar skybox por defecto
     void inicializarSkybox();
 
+    // Crear los lotes con las matrices ya calculadas si cambiaron las entidades estáticas
+    void hornearLotesEstaticos();
+
+    // Partes de actualizarFrame que se ejecutan como tareas
+    void actualizarAnimaciones(float deltaTime);
+    void calcularLuzEmisor(const EmisorLuz& emisor, const PointLight* fuegoAzul, CandidatoLuz& candidato) const;
+
+    // Internar los nombres y grupos del registro de entidades
+    void inicializarRegistro();
+
     // Inicializar luces de la escena
     void inicializarLuces();
 
     // Inicializar audio de la escena
     void inicializarAudio();
 
+    // Declarar las zonas con carga bajo demanda
+    void inicializarResidencia();
+
+    // Cargar los modelos que no son de ninguna zona
+    void cargarModelos();
+
     // Inicializar entidades de la escena
     void inicializarEntidades();
 
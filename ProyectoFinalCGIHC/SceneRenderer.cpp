@@ -1,10 +1,20 @@
 #include "SceneRenderer.h"
+#include "CacheTexturas.h"
+#include "ReporteCarga.h"
+
+const float SceneRenderer::UMBRALES_LOD[Model::NIVELES_LOD] = { 1.0f, 0.30f, 0.12f, 0.05f };
+const float SceneRenderer::HISTERESIS_LOD = 0.15f;
 
 SceneRenderer::SceneRenderer() 
-    : shader(nullptr), uniformModel(0), uniformProjection(0), 
-      uniformView(0), uniformEyePosition(0), uniformColor(0),
-      uniformSpecularIntensity(0), uniformShininess(0), inicializado(false)
+    : shaderDibujos(nullptr), inicializado(false),
+      objetosDibujados(0), objetosDescartados(0),
+      posicionCamara(0.0f), escalaProyeccion(1.0f), filaProfundidad(0.0f),
+      marcadorCarga(nullptr), texturaMarcador(nullptr)
 {
+    for (unsigned int n = 0; n < Model::NIVELES_LOD; n++) {
+        modelosPorNivelLOD[n] = 0;
+    }
+    tiempos.msUniforms = tiempos.msCulling = tiempos.msEnvio = 0.0;
 }
 
 SceneRenderer::~SceneRenderer() 
@@ -13,89 +23,47 @@ SceneRenderer::~SceneRenderer()
 
 bool SceneRenderer::inicializar()
 {
-    // Crear y compilar el shader
-    shader = new Shader();
-    if (shader == nullptr) {
-        return false;
-    }
-    
-    shader->CreateFromFiles(AssetConstants::ShaderPaths::VERTEX_SHADER.c_str(), 
-                           AssetConstants::ShaderPaths::FRAGMENT_SHADER.c_str());
-    
-    // Obtener las ubicaciones de los uniforms
-    uniformModel = shader->GetModelLocation();
-    uniformProjection = shader->GetProjectionLocation();
-    uniformView = shader->GetViewLocation();
-    uniformEyePosition = shader->GetEyePositionLocation();
-    uniformColor = shader->getColorLocation();
-    uniformSpecularIntensity = shader->GetSpecularIntensityLocation();
-    uniformShininess = shader->GetShininessLocation();
+    // Shader y buffer circular con la matriz y el material de cada dibujo de la cola
+    shaderDibujos = new Shader();
+    shaderDibujos->CreateFromFiles(AssetConstants::ShaderPaths::DIBUJOS_VERTEX_SHADER.c_str(),
+                                   AssetConstants::ShaderPaths::FRAGMENT_SHADER.c_str());
+    bufferDibujos.inicializar();
+
+    clustersLuces.inicializar();
+    datosFrame.inicializar();
+    crearMarcadorCarga();
     
     inicializado = true;
     return true;
 }
 
-void SceneRenderer::useShader()
-{
-    if (shader != nullptr) {
-        shader->UseShader();
-    }
-}
-
 void SceneRenderer::stopShader()
 {
     glUseProgram(0);
 }
 
-void SceneRenderer::configurarMatrices(const Camera& camera, const glm::mat4& projection)
+void SceneRenderer::configurarMatrices(const glm::mat4& view, const glm::vec3& cameraPosition, const glm::mat4& projection)
 {    
-    // Configurar matrices de proyeccin y vista
-    glUniformMatrix4fv(uniformProjection, 1, GL_FALSE, glm::value_ptr(projection));
-    
-    Camera& cam = const_cast<Camera&>(camera);
-    glm::mat4 viewMatrix = cam.calculateViewMatrix();
-    glUniformMatrix4fv(uniformView, 1, GL_FALSE, glm::value_ptr(viewMatrix));
-    
-    // Configurar posicin de la cmara
-    glm::vec3 cameraPos = cam.getCameraPosition();
-    glUniform3f(uniformEyePosition, cameraPos.x, cameraPos.y, cameraPos.z);
+    // Las matrices de proyeccin y vista y la posicin de la cmara van al bloque del frame
+    datosFrame.setCamara(view, projection, cameraPosition);
 }
 
-void SceneRenderer::configurarLuces(DirectionalLight* directionalLight,
-                                   PointLight* pointLights, unsigned int pointLightCount,
-                                   SpotLight* spotLights, unsigned int spotLightCount)
+void SceneRenderer::configurarLuces(const glm::mat4& view, const glm::mat4& projection,
+                                   const DirectionalLight* directionalLight,
+                                   const PointLight* pointLights, unsigned int pointLightCount,
+                                   const SpotLight* spotLights, unsigned int spotLightCount)
 {
-    if (shader == nullptr) return;
-    
     // Configurar luz direccional
     if (directionalLight != nullptr) {
-        shader->SetDirectionalLight(directionalLight);
-    }
-    
-    // Configurar luces puntuales
-    if (pointLights != nullptr) {
-        shader->SetPointLights(pointLights, pointLightCount);
+        datosFrame.setLuzDireccional(*directionalLight);
     }
     
-    // Configurar spotlights
-    if (spotLights != nullptr) {
-        shader->SetSpotLights(spotLights, spotLightCount);
-    }
+    // Las luces puntuales y spotlights se reparten en clusters y se suben a sus buffers
+    clustersLuces.actualizar(view, projection, pointLights, pointLightCount,
+                             spotLights, spotLightCount);
 }
 
-void SceneRenderer::configurarMaterial(const Material& material)
-{    
-    Material& mat = const_cast<Material&>(material);
-    mat.UseMaterial(uniformSpecularIntensity, uniformShininess);
-}
-
-void SceneRenderer::renderizarFrame(Skybox* skybox,
-                                   Camera& camera,
-                                   const glm::mat4& projectionMatrix,
-                                   const std::vector<Entidad*>& entidades,
-                                   DirectionalLight* directionalLight,
-                                   PointLight* pointLights, unsigned int pointLightCount,
-                                   SpotLight* spotLights, unsigned int spotLightCount)
+void SceneRenderer::renderizarFrame(const PaqueteFrame& paquete, const glm::mat4& projectionMatrix)
 {
 
     if (!inicializado) return;
@@ -104,99 +72,302 @@ void SceneRenderer::renderizarFrame(Skybox* skybox,
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     
-    // Habilitar blending para toda la escena (transparencia)
+    // Blending para el skybox; la cola lo apaga para lo opaco y lo prende para lo transparente
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     
-    // 1. Renderizar skybox primero (usa su propio shader)
-    if (skybox != nullptr) {
-        glm::mat4 viewMatrix = camera.calculateViewMatrix();
-        skybox->DrawSkybox(viewMatrix, projectionMatrix);
+    // 1. Datos del frame (cmara y luces) que comparten todos los programas, una subida por buffer
+    auto inicio = std::chrono::steady_clock::now();
+    const glm::mat4& viewMatrix = paquete.vista;
+    configurarMatrices(viewMatrix, paquete.posicionCamara, projectionMatrix);
+    configurarLuces(viewMatrix, projectionMatrix, &paquete.luzDireccional,
+                    paquete.lucesPuntuales, paquete.numLucesPuntuales,
+                    paquete.lucesSpot, paquete.numLucesSpot);
+    datosFrame.subir();
+    tiempos.msUniforms = ReporteCarga::msDesde(inicio);
+
+    // 2. Renderizar skybox primero (usa su propio shader)
+    inicio = std::chrono::steady_clock::now();
+    if (paquete.skybox != nullptr) {
+        paquete.skybox->DrawSkybox(paquete.skyboxAnterior, paquete.mezclaSkybox);
     }
+    double msSkybox = ReporteCarga::msDesde(inicio);
     
-    // 2. Reactivar el shader principal
-    useShader();
-    
-    // 3. Configurar matrices (view, projection, y eye position)
-    configurarMatrices(camera, projectionMatrix);
-    
-    glUniform3f(uniformColor, 1.0f, 1.0f, 1.0f);
-    
-    // 4. Configurar luces
-    configurarLuces(directionalLight, pointLights, pointLightCount, spotLights, spotLightCount);
-    
-    // 5. Renderizar todas las entidades 
-    renderizar(entidades);
+    // 3. Renderizar las entidades que esten dentro del frustum de la cmara
+    // (la matriz y el material de cada una van en el buffer de dibujos, sin uniforms por nodo)
+    frustum.extraer(projectionMatrix * viewMatrix);
+    posicionCamara = paquete.posicionCamara;
+    escalaProyeccion = projectionMatrix[1][1];
+    // z en la vista es negativa delante de la camara; la fila invertida da la distancia
+    filaProfundidad = -glm::vec4(viewMatrix[0][2], viewMatrix[1][2], viewMatrix[2][2], viewMatrix[3][2]);
+    renderizar(paquete);
 
 	stopShader();
+    tiempos.msEnvio += msSkybox;
 }
 
-void SceneRenderer::renderizar(const std::vector<Entidad*>& entidades)
+void SceneRenderer::renderizar(const PaqueteFrame& paquete)
 {
-    // Renderizar todas las entidades
-    for (Entidad* entidad : entidades) {
-        if (entidad != nullptr) {
-            renderizarRecursivo(entidad, glm::mat4(1.0f));
+    auto inicio = std::chrono::steady_clock::now();
+    objetosDibujados = 0;
+    objetosDescartados = 0;
+    colaRender.limpiar();
+    for (unsigned int n = 0; n < Model::NIVELES_LOD; n++) {
+        modelosPorNivelLOD[n] = 0;
+    }
+
+    // Recorrido lineal sobre los arreglos del paquete, sin saltar entre entidades
+    int numNodos = (int)paquete.getNumNodos();
+    if (nivelesLOD.size() != (size_t)numNodos) {
+        // El grafo se reconstruyo y los handles cambiaron
+        nivelesLOD.assign(numNodos, 0);
+    }
+    int i = 0;
+    while (i < numNodos) {
+        // Si todo el subarbol queda fuera se salta completo
+        const AABB& subarbol = paquete.aabbSubarboles[i];
+        if (subarbol.valido && !frustum.intersectaAABB(subarbol)) {
+            int fin = paquete.finSubarboles[i];
+            for (int j = i; j < fin; j++) {
+                if (paquete.aabbMundiales[j].valido) objetosDescartados++;
+            }
+            i = fin;
+            continue;
+        }
+
+        // Su geometria ya esta en un lote estatico
+        const NodoRender& nodo = paquete.nodos[i];
+        if (nodo.horneado) {
+            i++;
+            continue;
+        }
+
+        if (esVisible(paquete, i)) {
+            unsigned int nivel = nodo.tipo == TipoObjeto::MODELO ? elegirNivelLOD(paquete, i) : 0;
+            encolarNodo(paquete, nodo, i, nivel);
+            if (paquete.aabbMundiales[i].valido) objetosDibujados++;
+        }
+        else {
+            objetosDescartados++;
         }
+        i++;
     }
+
+    // Los lotes tienen sus volumenes en espacio mundial y se prueban directamente
+    if (paquete.lotesEstaticos != nullptr) {
+        for (const LoteEstatico& lote : paquete.lotesEstaticos->getLotes()) {
+            if (lote.mesh->getEsfera().valido &&
+                (frustum.probarEsfera(lote.mesh->getEsfera()) == ResultadoFrustum::FUERA ||
+                 !frustum.intersectaAABB(lote.mesh->getAABB()))) {
+                objetosDescartados++;
+                continue;
+            }
+            colaRender.agregar(lote.mesh, lote.textura, lote.material, -1,
+                               profundidadVista(lote.mesh->getEsfera(), glm::mat4(1.0f)));
+            objetosDibujados++;
+        }
+    }
+
+    // Se ordena por estado y se envia todo junto
+    colaRender.ordenar();
+    tiempos.msCulling = ReporteCarga::msDesde(inicio);
+
+    inicio = std::chrono::steady_clock::now();
+    enviarCola(paquete);
+    tiempos.msEnvio = ReporteCarga::msDesde(inicio);
 }
 
-void SceneRenderer::renderizarEntidad(Entidad* entidad,
-                                     const glm::mat4& transformacionInicial)
+void SceneRenderer::crearMarcadorCarga()
 {
+    // Cubo unitario en el espacio del modelo, una cara a la vez para que cada una tenga su normal
+    // (las normales van invertidas como en el resto de los meshes)
+    const glm::vec3 normales[6] = {
+        glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(-1.0f, 0.0f, 0.0f),
+        glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f),
+        glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, -1.0f)
+    };
+    std::vector<GLfloat> vertices;
+    std::vector<unsigned int> indices;
+    for (int cara = 0; cara < 6; cara++) {
+        glm::vec3 n = normales[cara];
+        glm::vec3 u = glm::abs(n.y) > 0.5f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+        glm::vec3 v = glm::cross(n, u);
+        unsigned int base = static_cast<unsigned int>(vertices.size() / 8);
+        for (int esquina = 0; esquina < 4; esquina++) {
+            float s = (esquina & 1) ? 1.0f : 0.0f;
+            float t = (esquina & 2) ? 1.0f : 0.0f;
+            glm::vec3 p = 0.5f * n + (s - 0.5f) * u + (t - 0.5f) * v;
+            vertices.insert(vertices.end(), { p.x, p.y, p.z, s, t, -n.x, -n.y, -n.z });
+        }
+        indices.insert(indices.end(), { base, base + 1, base + 2, base + 1, base + 3, base + 2 });
+    }
+    marcadorCarga = new Mesh();
+    marcadorCarga->CreateMesh(vertices.data(), indices.data(),
+                              static_cast<unsigned int>(vertices.size()), static_cast<unsigned int>(indices.size()));
 
-    if (entidad == nullptr) return;
-    
-    
-    // Renderizar la entidad y su jerarqua
-    renderizarRecursivo(entidad, transformacionInicial);
+    // Textura neutra compartida con los modelos sin textura
+    texturaMarcador = CacheTexturas::instancia().adquirir("Textures/plain.png", true);
+    CacheTexturas::instancia().subir(texturaMarcador);
 }
 
-void SceneRenderer::renderizarRecursivo(Entidad* entidad, const glm::mat4& transformacionPadre)
-{   
-
-    if (entidad == nullptr) {
-        return;
+unsigned int SceneRenderer::elegirNivelLOD(const PaqueteFrame& paquete, int handle)
+{
+    unsigned char& nivel = nivelesLOD[handle];
+    const EsferaEnvolvente& esfera = paquete.esferasMundiales[handle];
+    if (!esfera.valido) {
+        nivel = 0;
+        return nivel;
     }
-	entidad->actualizarTransformacion();
-    // Calcular la transformacin acumulada
-    glm::mat4 transformacionActual = transformacionPadre * entidad->transformacionLocal;
 
+    // Diametro proyectado entre la altura de la pantalla; dentro de la esfera es pantalla completa
+    float distancia = glm::length(esfera.centro - posicionCamara);
+    float cobertura = distancia > esfera.radio ? esfera.radio * escalaProyeccion / distancia : 1.0f;
 
-    // Se envia el model al shader
-    glUniformMatrix4fv(uniformModel, 1, GL_FALSE, glm::value_ptr(transformacionActual));
-    
-    // Configurar material si existe, o usar valores por defecto
-    if (entidad->material != nullptr) {
-        configurarMaterial(*entidad->material);
-    } else {
-		configurarMaterial(Material()); // Material por defecto
+    // Solo se cambia de nivel al pasar el umbral con margen
+    while (nivel + 1u < Model::NIVELES_LOD && cobertura < UMBRALES_LOD[nivel + 1] * (1.0f - HISTERESIS_LOD)) {
+        nivel++;
     }
-    
-    // APLICAR TEXTURA ANTES DE RENDERIZAR
-    if (entidad->texture != nullptr) {
-        entidad->texture->UseTexture();
+    while (nivel > 0 && cobertura > UMBRALES_LOD[nivel] * (1.0f + HISTERESIS_LOD)) {
+        nivel--;
     }
-    
-    // Renderizar segn el tipo de geometra
-    switch (entidad->TipoObjeto) {
+    return nivel;
+}
+
+float SceneRenderer::profundidadVista(const EsferaEnvolvente& esfera, const glm::mat4& modelo) const
+{
+    // Sin volumen se usa el origen del nodo
+    glm::vec3 centro = esfera.valido ? esfera.centro : glm::vec3(modelo[3]);
+    return glm::dot(filaProfundidad, glm::vec4(centro, 1.0f));
+}
+
+void SceneRenderer::encolarNodo(const PaqueteFrame& paquete, const NodoRender& nodo, int handle, unsigned int nivelLOD)
+{
+    float profundidad = profundidadVista(paquete.esferasMundiales[handle], paquete.transformaciones[handle]);
+    switch (nodo.tipo) {
         case TipoObjeto::MODELO:
-            // Renderizar el modelo
-            if (entidad->modelo != nullptr) {
-                entidad->modelo->RenderModel();
+            if (nodo.modelo == nullptr) break;
+            // El modelo se esta cargando bajo demanda: se dibuja el marcador en su lugar
+            if (!nodo.modelo->estaResidente()) {
+                colaRender.agregar(marcadorCarga, texturaMarcador, nodo.material, handle, profundidad);
+                break;
+            }
+            // Cada mesh usa su textura; si el modelo no liga una se usa la de la entidad
+            modelosPorNivelLOD[nivelLOD]++;
+            for (unsigned int m = 0; m < nodo.modelo->getNumMeshes(); m++) {
+                Texture* textura = nodo.modelo->getTexturaMesh(m);
+                colaRender.agregar(nodo.modelo->getMeshLOD(m, nivelLOD),
+                                   textura != nullptr ? textura : nodo.texture,
+                                   nodo.material, handle, profundidad);
             }
             break;
-            
+
         case TipoObjeto::MESH:
-            // Renderizar el mesh
-            if (entidad->mesh != nullptr) {
-                entidad->mesh->RenderMesh();
-            }
+            colaRender.agregar(nodo.mesh, nodo.texture, nodo.material, handle, profundidad);
             break;
     }
-    
-    // Renderizar recursivamente todas las entidades hijas
-    for (auto* hijo : entidad->hijos) {
-        renderizarRecursivo(hijo, transformacionActual);
+}
+
+void SceneRenderer::enviarCola(const PaqueteFrame& paquete)
+{
+    estadisticas = EstadisticasRender();
+
+    const std::vector<ElementoRender>& elementos = colaRender.getElementos();
+    if (elementos.empty()) return;
+
+    // 1. Datos de cada elemento en el buffer del frame; el indice de dibujo es su posicion en la cola
+    DatosDibujoGPU* datos = bufferDibujos.comenzarFrame((unsigned int)elementos.size());
+    int nodoActual = -2;    // -1 es el handle de los lotes estaticos
+    glm::mat4 modelo(1.0f);
+    glm::mat4 normal(1.0f);
+    for (size_t i = 0; i < elementos.size(); i++) {
+        const ElementoRender& elemento = elementos[i];
+
+        // Los meshes de un mismo modelo comparten la matriz del nodo; la normal se calcula
+        // aqui una vez en lugar de en cada vertice
+        if (elemento.nodo != nodoActual) {
+            modelo = matrizElemento(paquete, elemento.nodo);
+            normal = glm::mat4(glm::transpose(glm::inverse(glm::mat3(modelo))));
+            nodoActual = elemento.nodo;
+            estadisticas.cambiosMatriz++;
+        }
+
+        const Material* material = elemento.material != nullptr ? elemento.material : &materialPorDefecto;
+        datos[i].model = modelo;
+        datos[i].normal = normal;
+        datos[i].material = glm::vec4(material->GetSpecularIntensity(), material->GetShininess(), 0.0f, 0.0f);
     }
+    bufferDibujos.enviar();
+
+    // 2. La camara y las luces siguen ligadas en DatosFrame y en los buffers de clusters
+    shaderDibujos->UseShader();
+    glUniform3f(shaderDibujos->getColorLocation(), 1.0f, 1.0f, 1.0f);
+
+    // Lo opaco se dibuja sin blending; la cola deja lo transparente al final
+    glDisable(GL_BLEND);
+    bool blending = false;
+
+    Texture* texturaActual = nullptr;
+    Mesh* meshActual = nullptr;
+    size_t i = 0;
+    while (i < elementos.size()) {
+        // La cola esta ordenada por textura y mesh, asi que los elementos que solo cambian
+        // de matriz o de material quedan juntos y se dibujan en una sola llamada
+        size_t fin = i + 1;
+        while (fin < elementos.size() && elementos[fin].mesh == elementos[i].mesh &&
+               elementos[fin].textura == elementos[i].textura) {
+            fin++;
+        }
+
+        const ElementoRender& elemento = elementos[i];
+        if (!blending && ColaRender::esTranslucido(elemento)) {
+            glEnable(GL_BLEND);
+            blending = true;
+        }
+
+        // Solo se liga la textura si cambio
+        if (elemento.textura != nullptr && elemento.textura != texturaActual) {
+            elemento.textura->UseTexture();
+            texturaActual = elemento.textura;
+            estadisticas.cambiosTextura++;
+        }
+
+        if (elemento.mesh != meshActual) {
+            elemento.mesh->BindMesh();
+            elemento.mesh->ConfigurarIndiceDibujo(bufferDibujos.getBufferIndices(), bufferDibujos.getGeneracion());
+            meshActual = elemento.mesh;
+            estadisticas.cambiosMesh++;
+        }
+
+        GLsizei cantidad = (GLsizei)(fin - i);
+        elemento.mesh->DrawMeshDibujos((GLuint)i, cantidad);
+        estadisticas.llamadasDibujo++;
+        if (cantidad > 1) {
+            estadisticas.lotesInstanciados++;
+            estadisticas.instanciasDibujadas += cantidad;
+        }
+        estadisticas.triangulos += (elemento.mesh->GetIndexCount() / 3) * cantidad;
+        i = fin;
+    }
+
+    Mesh::UnbindMesh();
+    bufferDibujos.terminarFrame();
+}
+
+glm::mat4 SceneRenderer::matrizElemento(const PaqueteFrame& paquete, int nodo)
+{
+    // Matriz interpolada entre los dos ultimos ticks de la simulacion
+    return nodo >= 0 ? paquete.transformaciones[nodo] : glm::mat4(1.0f);
+}
+
+bool SceneRenderer::esVisible(const PaqueteFrame& paquete, int handle) const
+{
+    // Los nodos sin volumen (sin geometria o sin modelo cargado) no se descartan
+    const EsferaEnvolvente& esfera = paquete.esferasMundiales[handle];
+    if (!esfera.valido) return true;
+
+    // La esfera es la prueba barata; la caja solo se prueba si la esfera toca un plano
+    ResultadoFrustum resultado = frustum.probarEsfera(esfera);
+    if (resultado == ResultadoFrustum::FUERA) return false;
+    if (resultado == ResultadoFrustum::DENTRO) return true;
+    return frustum.intersectaAABB(paquete.aabbMundiales[handle]);
 }
@@ -5,11 +5,26 @@
 #include <gtc/matrix_transform.hpp>
 #include <gtc/type_ptr.hpp>
 #include "Entidad.h"
+#include "SceneGraph.h"
+#include "LotesEstaticos.h"
+#include "VolumenEnvolvente.h"
+#include "ColaRender.h"
+#include "ClustersLuces.h"
+#include "DatosFrame.h"
 #include "Shader_light.h"
 #include "Camera.h"
 #include "AssetConstants.h"
 #include "Material.h"
 #include "Skybox.h"
+#include "PaqueteFrame.h"
+#include "BufferDibujos.h"
+
+// Tiempo de CPU de cada fase del ultimo frame en milisegundos (sin esperar a la GPU)
+struct TiemposRender {
+    double msUniforms;  // Camara, luces en clusters y subida de los buffers del frame
+    double msCulling;   // Recorrido del grafo, frustum, LOD y ordenamiento de la cola
+    double msEnvio;     // Skybox, datos de dibujo y cola ordenada
+};
 
 // Clase para renderizar entidades de la escena
 class SceneRenderer {
@@ -21,58 +36,105 @@ public:
     bool inicializar();
     
     // Funcin principal para renderizar un frame completo
-    void renderizarFrame(Skybox* skybox,
-                        Camera& camera,
-                        const glm::mat4& projectionMatrix,
-                        const std::vector<Entidad*>& entidades,
-                        DirectionalLight* directionalLight,
-                        PointLight* pointLights, unsigned int pointLightCount,
-                        SpotLight* spotLights, unsigned int spotLightCount);
-    
-    // Renderizar una lista de entidades
-    void renderizar(const std::vector<Entidad*>& entidades);
-    
-    // Renderizar una sola entidad y su jerarqua
-    void renderizarEntidad(Entidad* entidad,
-                          const glm::mat4& transformacionInicial = glm::mat4(1.0f));
-    
-    // Configurar matrices de vista y proyeccin
-    void configurarMatrices(const Camera& camera, const glm::mat4& projection);
+    // Solo lee el paquete (y los recursos a los que apunta), nunca las entidades
+    void renderizarFrame(const PaqueteFrame& paquete, const glm::mat4& projectionMatrix);
+
+    // Renderizar todos los nodos del paquete en orden
+    // Los nodos horneados se dibujan desde los lotes estaticos
+    void renderizar(const PaqueteFrame& paquete);
     
-    // Configurar luces 
-    void configurarLuces(DirectionalLight* directionalLight,
-                        PointLight* pointLights, unsigned int pointLightCount,
-                        SpotLight* spotLights, unsigned int spotLightCount);
+    // Configurar matrices de vista y proyeccin (se suben con el bloque DatosFrame)
+    void configurarMatrices(const glm::mat4& view, const glm::vec3& cameraPosition, const glm::mat4& projection);
     
-    // Configurar material 
-    void configurarMaterial(const Material& material);
+    // Configurar luces (las puntuales y spot se asignan a los clusters de la vista)
+    void configurarLuces(const glm::mat4& view, const glm::mat4& projection,
+                        const DirectionalLight* directionalLight,
+                        const PointLight* pointLights, unsigned int pointLightCount,
+                        const SpotLight* spotLights, unsigned int spotLightCount);
     
-    // Activar shader
-    void useShader();
     // Desactivar shader
     void stopShader();
 
-    // Obtener el shader actual
-    Shader* getShader() { return shader; }
+    // Contadores del ultimo frame para medir el frustum culling
+    unsigned int getObjetosDibujados() const { return objetosDibujados; }
+    unsigned int getObjetosDescartados() const { return objetosDescartados; }
+
+    // Llamadas de dibujo y cambios de estado del ultimo frame
+    const EstadisticasRender& getEstadisticas() const { return estadisticas; }
+
+    // Tiempos de las fases del ultimo frame
+    const TiemposRender& getTiempos() const { return tiempos; }
+
+    // Modelos que se dibujaron con cada nivel de LOD en el ultimo frame
+    unsigned int getModelosPorNivelLOD(unsigned int nivel) const { return modelosPorNivelLOD[nivel]; }
+
+    // Asignacion de luces a clusters del ultimo frame
+    const ClustersLuces& getClustersLuces() const { return clustersLuces; }
+
+    // Buffer circular con los datos de cada dibujo
+    const BufferDibujos& getBufferDibujos() const { return bufferDibujos; }
+
+    // Fraccion de la altura de la pantalla que cubre el diametro del modelo por debajo de la
+    // cual se usa cada nivel de LOD (el nivel 0 no tiene umbral)
+    static const float UMBRALES_LOD[Model::NIVELES_LOD];
+    // Margen alrededor de cada umbral para que el nivel no cambie de ida y vuelta en la frontera
+    static const float HISTERESIS_LOD;
     
 
     
 private:
-    // Shader para renderizado
-    Shader* shader;
-    
-    // Uniform locations
-    GLuint uniformModel;
-    GLuint uniformProjection;
-    GLuint uniformView;
-    GLuint uniformEyePosition;
-    GLuint uniformColor;
-    GLuint uniformSpecularIntensity;
-    GLuint uniformShininess;
+    // Shader que lee la matriz y el material de cada dibujo de bufferDibujos
+    Shader* shaderDibujos;
+    BufferDibujos bufferDibujos;
     
     // Flag de inicializacin
     bool inicializado;
-    
-    // Funcin recursiva interna para renderizar jerarqua
-    void renderizarRecursivo(Entidad* entidad, const glm::mat4& transformacionPadre);
+
+    // Volumen de vision de la camara en el frame actual
+    Frustum frustum;
+    unsigned int objetosDibujados;
+    unsigned int objetosDescartados;
+
+    // Indica si el nodo es visible segun su esfera y su caja
+    bool esVisible(const PaqueteFrame& paquete, int handle) const;
+
+    // Nivel de LOD de cada nodo (por handle) y datos de la camara para calcularlo
+    std::vector<unsigned char> nivelesLOD;
+    unsigned int modelosPorNivelLOD[Model::NIVELES_LOD];
+    glm::vec3 posicionCamara;
+    float escalaProyeccion;     // 1 / tan(fov / 2)
+    unsigned int elegirNivelLOD(const PaqueteFrame& paquete, int handle);
+
+    // Luces puntuales y spot repartidas en clusters (compartidas por ambos shaders)
+    ClustersLuces clustersLuces;
+
+    // UBO con la camara y la luz direccional del frame (tambien lo usa el skybox)
+    DatosFrame datosFrame;
+
+    // Cola de dibujo ordenada por estado
+    ColaRender colaRender;
+    EstadisticasRender estadisticas;
+    TiemposRender tiempos;
+
+    // Material para las entidades sin material (evita crear uno temporal por entidad)
+    Material materialPorDefecto;
+
+    // Cubo que se dibuja en lugar de los modelos que todavia no estan en memoria
+    Mesh* marcadorCarga;
+    Texture* texturaMarcador;
+    void crearMarcadorCarga();
+
+    // Fila de la vista que da la profundidad de un punto (para ordenar lo transparente)
+    glm::vec4 filaProfundidad;
+    float profundidadVista(const EsferaEnvolvente& esfera, const glm::mat4& modelo) const;
+
+    // Agrega los meshes del nodo a la cola con el nivel de detalle que le toca
+    void encolarNodo(const PaqueteFrame& paquete, const NodoRender& nodo, int handle, unsigned int nivelLOD);
+
+    // Matriz model de un elemento de la cola (los lotes estaticos no tienen nodo y usan la identidad)
+    static glm::mat4 matrizElemento(const PaqueteFrame& paquete, int nodo);
+
+    // Escribe los datos de dibujo de la cola y la envia a la GPU; los elementos consecutivos
+    // con el mismo mesh y textura salen en una sola llamada
+    void enviarCola(const PaqueteFrame& paquete);
 };
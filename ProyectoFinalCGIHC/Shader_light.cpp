@@ -4,10 +4,11 @@ Shader::Shader()
 {
 	shaderID = 0;
 	uniformModel = 0;
-	uniformProjection = 0;
 	uniformColor = 0;
-	pointLightCount = 0;
-	spotLightCount = 0;
+	uniformSpecularIntensity = 0;
+	uniformShininess = 0;
+	programa = nullptr;
+	versionPrograma = 0;
 }
 
 void Shader::CreateFromString(const char* vertexCode, const char* fragmentCode)
@@ -17,173 +18,97 @@ void Shader::CreateFromString(const char* vertexCode, const char* fragmentCode)
 
 void Shader::CreateFromFiles(const char* vertexLocation, const char* fragmentLocation)
 {
-	std::string vertexString = ReadFile(vertexLocation);
-	std::string fragmentString = ReadFile(fragmentLocation);
-	const char* vertexCode = vertexString.c_str();
-	const char* fragmentCode = fragmentString.c_str();
-
-	CompileShader(vertexCode, fragmentCode);
+	programa = CacheShaders::instancia().adquirir(vertexLocation, fragmentLocation);
+	if (programa == nullptr)
+	{
+		return;
+	}
+	shaderID = programa->id;
+	versionPrograma = programa->version;
+	LeerUniforms();
 }
 
 std::string Shader::ReadFile(const char* fileLocation)
 {
-	std::string content;
-	std::ifstream fileStream(fileLocation, std::ios::in);
-
-	if (!fileStream.is_open()) {
+	std::string content = CacheShaders::leerArchivo(fileLocation);
+	if (content.empty()) {
 		printf("Failed to read %s! File doesn't exist.", fileLocation);
-		return "";
 	}
+	return content;
+}
 
-	std::string line = "";
-	while (!fileStream.eof())
+void Shader::CompileShader(const char* vertexCode, const char* fragmentCode)
+{
+	shaderID = EnlazarPrograma(vertexCode, fragmentCode, false);
+	if (shaderID != 0)
 	{
-		std::getline(fileStream, line);
-		content.append(line + "\n");
+		LeerUniforms();
 	}
-
-	fileStream.close();
-	return content;
 }
 
-void Shader::CompileShader(const char* vertexCode, const char* fragmentCode)
+GLuint Shader::EnlazarPrograma(const char* vertexCode, const char* fragmentCode, bool recuperable)
 {
-	shaderID = glCreateProgram();
+	GLuint program = glCreateProgram();
 
-	if (!shaderID)
+	if (!program)
 	{
 		printf("Error creating shader program!\n");
-		return;
+		return 0;
 	}
 
-	AddShader(shaderID, vertexCode, GL_VERTEX_SHADER);
-	AddShader(shaderID, fragmentCode, GL_FRAGMENT_SHADER);
+	if (!AddShader(program, vertexCode, GL_VERTEX_SHADER) || !AddShader(program, fragmentCode, GL_FRAGMENT_SHADER))
+	{
+		glDeleteProgram(program);
+		return 0;
+	}
 
 	GLint result = 0;
 	GLchar eLog[1024] = { 0 };
 
-	glLinkProgram(shaderID);
-	glGetProgramiv(shaderID, GL_LINK_STATUS, &result);
+	// Hay que pedirlo antes de enlazar para poder leer el binario con glGetProgramBinary
+	if (recuperable)
+	{
+		glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	}
+
+	glLinkProgram(program);
+	glGetProgramiv(program, GL_LINK_STATUS, &result);
 	if (!result)
 	{
-		glGetProgramInfoLog(shaderID, sizeof(eLog), NULL, eLog);
+		glGetProgramInfoLog(program, sizeof(eLog), NULL, eLog);
 		printf("Error linking program: '%s'\n", eLog);
-		return;
+		glDeleteProgram(program);
+		return 0;
 	}
 
-	glValidateProgram(shaderID);
-	glGetProgramiv(shaderID, GL_VALIDATE_STATUS, &result);
+	// La validacion depende del estado de GL en este momento (samplers sin ligar, etc.),
+	// asi que un programa correcto puede fallarla: solo se reporta y el programa se conserva
+	glValidateProgram(program);
+	glGetProgramiv(program, GL_VALIDATE_STATUS, &result);
 	if (!result)
 	{
-		glGetProgramInfoLog(shaderID, sizeof(eLog), NULL, eLog);
+		glGetProgramInfoLog(program, sizeof(eLog), NULL, eLog);
 		printf("Error validating program: '%s'\n", eLog);
-		return;
 	}
 
-	uniformProjection = glGetUniformLocation(shaderID, "projection");
+	return program;
+}
+
+void Shader::LeerUniforms()
+{
 	uniformModel = glGetUniformLocation(shaderID, "model");
-	uniformView = glGetUniformLocation(shaderID, "view");
-	uniformDirectionalLight.uniformcolor = glGetUniformLocation(shaderID, "directionalLight.base.color");
-	uniformDirectionalLight.uniformAmbientIntensity = glGetUniformLocation(shaderID, "directionalLight.base.ambientIntensity");
-	uniformDirectionalLight.uniformDirection = glGetUniformLocation(shaderID, "directionalLight.direction");
-	uniformDirectionalLight.uniformDiffuseIntensity = glGetUniformLocation(shaderID, "directionalLight.base.diffuseIntensity");
 	uniformSpecularIntensity = glGetUniformLocation(shaderID, "material.specularIntensity");
 	uniformShininess = glGetUniformLocation(shaderID, "material.shininess");
-	uniformEyePosition = glGetUniformLocation(shaderID, "eyePosition");
 	uniformColor = glGetUniformLocation(shaderID, "color");
 
-	uniformPointLightCount = glGetUniformLocation(shaderID, "pointLightCount");
-
-	for (size_t i = 0; i < MAX_POINT_LIGHTS; i++)
-	{
-		char locBuff[100] = { '\0' };
-
-		snprintf(locBuff, sizeof(locBuff), "pointLights[%d].base.color", i);
-		uniformPointLight[i].uniformcolor = glGetUniformLocation(shaderID, locBuff);
-
-		snprintf(locBuff, sizeof(locBuff), "pointLights[%d].base.ambientIntensity", i);
-		uniformPointLight[i].uniformAmbientIntensity = glGetUniformLocation(shaderID, locBuff);
-
-		snprintf(locBuff, sizeof(locBuff), "pointLights[%d].base.diffuseIntensity", i);
-		uniformPointLight[i].uniformDiffuseIntensity = glGetUniformLocation(shaderID, locBuff);
-
-		snprintf(locBuff, sizeof(locBuff), "pointLights[%d].position", i);
-		uniformPointLight[i].uniformPosition = glGetUniformLocation(shaderID, locBuff);
-
-		snprintf(locBuff, sizeof(locBuff), "pointLights[%d].constant", i);
-		uniformPointLight[i].uniformConstant = glGetUniformLocation(shaderID, locBuff);
-
-		snprintf(locBuff, sizeof(locBuff), "pointLights[%d].linear", i);
-		uniformPointLight[i].uniformLinear = glGetUniformLocation(shaderID, locBuff);
-
-		snprintf(locBuff, sizeof(locBuff), "pointLights[%d].exponent", i);
-		uniformPointLight[i].uniformExponent = glGetUniformLocation(shaderID, locBuff);
-	}
-
-	uniformSpotLightCount = glGetUniformLocation(shaderID, "spotLightCount");
-
-	for (size_t i = 0; i < MAX_SPOT_LIGHTS; i++)
-	{
-		char locBuff[100] = { '\0' };
-
-		snprintf(locBuff, sizeof(locBuff), "spotLights[%d].base.base.color", i);
-		uniformSpotLight[i].uniformColour = glGetUniformLocation(shaderID, locBuff);
-
-		snprintf(locBuff, sizeof(locBuff), "spotLights[%d].base.base.ambientIntensity", i);
-		uniformSpotLight[i].uniformAmbientIntensity = glGetUniformLocation(shaderID, locBuff);
-
-		snprintf(locBuff, sizeof(locBuff), "spotLights[%d].base.base.diffuseIntensity", i);
-		uniformSpotLight[i].uniformDiffuseIntensity = glGetUniformLocation(shaderID, locBuff);
-
-		snprintf(locBuff, sizeof(locBuff), "spotLights[%d].base.position", i);
-		uniformSpotLight[i].uniformPosition = glGetUniformLocation(shaderID, locBuff);
-
-		snprintf(locBuff, sizeof(locBuff), "spotLights[%d].base.constant", i);
-		uniformSpotLight[i].uniformConstant = glGetUniformLocation(shaderID, locBuff);
-
-		snprintf(locBuff, sizeof(locBuff), "spotLights[%d].base.linear", i);
-		uniformSpotLight[i].uniformLinear = glGetUniformLocation(shaderID, locBuff);
-
-		snprintf(locBuff, sizeof(locBuff), "spotLights[%d].base.exponent", i);
-		uniformSpotLight[i].uniformExponent = glGetUniformLocation(shaderID, locBuff);
-
-		snprintf(locBuff, sizeof(locBuff), "spotLights[%d].direction", i);
-		uniformSpotLight[i].uniformDirection = glGetUniformLocation(shaderID, locBuff);
-
-		snprintf(locBuff, sizeof(locBuff), "spotLights[%d].edge", i);
-		uniformSpotLight[i].uniformEdge = glGetUniformLocation(shaderID, locBuff);
-	}
-
+	// La camara y la luz direccional vienen del UBO DatosFrame y las luces puntuales y spot
+	// de los buffers de ClustersLuces, por eso no tienen uniforms aqui
 }
 
-GLuint Shader::GetProjectionLocation()
-{
-	return uniformProjection;
-}
 GLuint Shader::GetModelLocation()
 {
 	return uniformModel;
 }
-GLuint Shader::GetViewLocation()
-{
-	return uniformView;
-}
-GLuint Shader::GetAmbientcolorLocation()
-{
-	return uniformDirectionalLight.uniformcolor;
-}
-GLuint Shader::GetAmbientIntensityLocation()
-{
-	return uniformDirectionalLight.uniformAmbientIntensity;
-}
-GLuint Shader::GetDiffuseIntensityLocation()
-{
-	return uniformDirectionalLight.uniformDiffuseIntensity;
-}
-GLuint Shader::GetDirectionLocation()
-{
-	return uniformDirectionalLight.uniformDirection;
-}
 GLuint Shader::GetSpecularIntensityLocation()
 {
 	return uniformSpecularIntensity;
@@ -192,73 +117,43 @@ GLuint Shader::GetShininessLocation()
 {
 	return uniformShininess;
 }
-GLuint Shader::GetEyePositionLocation()
-{
-	return uniformEyePosition;
-}
-
 GLuint Shader::getColorLocation()
 {
 	return uniformColor;
 }
-void Shader::SetDirectionalLight(DirectionalLight * dLight)
-{
-	dLight->UseLight(uniformDirectionalLight.uniformAmbientIntensity, uniformDirectionalLight.uniformcolor,
-		uniformDirectionalLight.uniformDiffuseIntensity, uniformDirectionalLight.uniformDirection);
-}
-
-void Shader::SetPointLights(PointLight * pLight, unsigned int lightCount)
-{
-	if (lightCount > MAX_POINT_LIGHTS) lightCount = MAX_POINT_LIGHTS;
 
-	glUniform1i(uniformPointLightCount, lightCount);
-
-	for (size_t i = 0; i < lightCount; i++)
-	{
-		pLight[i].UseLight(uniformPointLight[i].uniformAmbientIntensity, uniformPointLight[i].uniformcolor,
-			uniformPointLight[i].uniformDiffuseIntensity, uniformPointLight[i].uniformPosition,
-			uniformPointLight[i].uniformConstant, uniformPointLight[i].uniformLinear, uniformPointLight[i].uniformExponent);
-	}
-}
-
-void Shader::SetSpotLights(SpotLight * sLight, unsigned int lightCount)
+void Shader::UseShader()
 {
-	if (lightCount > MAX_SPOT_LIGHTS) lightCount = MAX_SPOT_LIGHTS;
-
-	glUniform1i(uniformSpotLightCount, lightCount);
-
-	for (size_t i = 0; i < lightCount; i++)
+	// Si el programa se recargo en caliente cambian el id y pueden cambiar los uniforms
+	if (programa != nullptr && programa->version != versionPrograma)
 	{
-		sLight[i].UseLight(uniformSpotLight[i].uniformAmbientIntensity, uniformSpotLight[i].uniformColour,
-			uniformSpotLight[i].uniformDiffuseIntensity, uniformSpotLight[i].uniformPosition, uniformSpotLight[i].uniformDirection,
-			uniformSpotLight[i].uniformConstant, uniformSpotLight[i].uniformLinear, uniformSpotLight[i].uniformExponent,
-			uniformSpotLight[i].uniformEdge);
+		shaderID = programa->id;
+		versionPrograma = programa->version;
+		LeerUniforms();
 	}
-}
-
-
-void Shader::UseShader()
-{
 	glUseProgram(shaderID);
 }
 
 void Shader::ClearShader()
 {
-	if (shaderID != 0)
+	if (programa != nullptr)
+	{
+		CacheShaders::instancia().liberar(programa);
+		programa = nullptr;
+	}
+	else if (shaderID != 0)
 	{
 		glDeleteProgram(shaderID);
-		shaderID = 0;
 	}
+	shaderID = 0;
 
 	uniformModel = 0;
-	uniformProjection = 0;
 	uniformColor = 0;
-	uniformView = 0;
 
 }
 
 
-void Shader::AddShader(GLuint theProgram, const char* shaderCode, GLenum shaderType)
+bool Shader::AddShader(GLuint theProgram, const char* shaderCode, GLenum shaderType)
 {
 	GLuint theShader = glCreateShader(shaderType);
 
@@ -279,10 +174,14 @@ void Shader::AddShader(GLuint theProgram, const char* shaderCode, GLenum shaderT
 	{
 		glGetShaderInfoLog(theShader, sizeof(eLog), NULL, eLog);
 		printf("Error compiling the %d shader: '%s'\n", shaderType, eLog);
-		return;
+		glDeleteShader(theShader);
+		return false;
 	}
 
+	// El shader queda marcado para borrarse cuando se borre el programa
 	glAttachShader(theProgram, theShader);
+	glDeleteShader(theShader);
+	return true;
 }
 
 Shader::~Shader()
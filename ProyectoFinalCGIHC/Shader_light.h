@@ -9,6 +9,7 @@
 #include "DirectionalLight.h"
 #include "PointLight.h"
 #include "SpotLight.h"
+#include "CacheShaders.h"
 
 class Shader
 {
@@ -16,76 +17,35 @@ public:
 	Shader();
 
 	void CreateFromString(const char* vertexCode, const char* fragmentCode);
+	// El programa sale de CacheShaders: se comparte con otros Shader del mismo codigo y se
+	// recarga en caliente si sus archivos cambian
 	void CreateFromFiles(const char* vertexLocation, const char* fragmentLocation);
 
+	// Compila y enlaza un programa; 0 si falla. Con recuperable se puede pedir su binario
+	static GLuint EnlazarPrograma(const char* vertexCode, const char* fragmentCode, bool recuperable);
+
 	std::string ReadFile(const char* fileLocation);
 
-	GLuint GetProjectionLocation();
 	GLuint GetModelLocation();
-	GLuint GetViewLocation();
-	GLuint GetAmbientIntensityLocation();
-	GLuint GetAmbientcolorLocation();
-	GLuint GetDiffuseIntensityLocation();
-	GLuint GetDirectionLocation();
 	GLuint GetSpecularIntensityLocation();
 	GLuint GetShininessLocation();
-	GLuint GetEyePositionLocation();
 	GLuint getColorLocation();
 
-	void SetDirectionalLight(DirectionalLight * dLight);
-	void SetPointLights(PointLight * pLight, unsigned int lightCount);
-	void SetSpotLights(SpotLight * sLight, unsigned int lightCount);
-
 	void UseShader();
 	void ClearShader();
 
 	~Shader();
 
 private:
-	int pointLightCount;
-	int spotLightCount;
-	GLuint shaderID, uniformProjection, uniformModel, uniformColor, uniformView, uniformEyePosition,
-		uniformSpecularIntensity, uniformShininess;
-
-	struct {
-		GLuint uniformcolor;
-		GLuint uniformAmbientIntensity;
-		GLuint uniformDiffuseIntensity;
-
-		GLuint uniformDirection;
-	} uniformDirectionalLight;
-
-	GLuint uniformPointLightCount;
-
-	struct {
-		GLuint uniformcolor;
-		GLuint uniformAmbientIntensity;
-		GLuint uniformDiffuseIntensity;
-
-		GLuint uniformPosition;
-		GLuint uniformConstant;
-		GLuint uniformLinear;
-		GLuint uniformExponent;
-	} uniformPointLight[MAX_POINT_LIGHTS];
-
-	GLuint uniformSpotLightCount;
-
-	struct {
-		GLuint uniformColour;
-		GLuint uniformAmbientIntensity;
-		GLuint uniformDiffuseIntensity;
-
-		GLuint uniformPosition;
-		GLuint uniformConstant;
-		GLuint uniformLinear;
-		GLuint uniformExponent;
+	GLuint shaderID, uniformModel, uniformColor, uniformSpecularIntensity, uniformShininess;
 
-		GLuint uniformDirection;
-		GLuint uniformEdge;
-	} uniformSpotLight[MAX_SPOT_LIGHTS];
+	// Programa compartido del cache (nullptr si se creo desde strings) y su version leida
+	ProgramaShader* programa;
+	unsigned int versionPrograma;
 
+	void LeerUniforms();
 
 	void CompileShader(const char* vertexCode, const char* fragmentCode);
-	void AddShader(GLuint theProgram, const char* shaderCode, GLenum shaderType);
+	static bool AddShader(GLuint theProgram, const char* shaderCode, GLenum shaderType);
 };
 
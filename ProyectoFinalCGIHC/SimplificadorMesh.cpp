@@ -0,0 +1,373 @@
+#include "SimplificadorMesh.h"
+#include <glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <queue>
+#include <unordered_map>
+
+namespace {
+
+const unsigned int FLOTANTES_POR_VERTICE = 8;
+
+// Los bordes abiertos pesan mas para que la silueta no se encoja
+const double PESO_BORDE = 10.0;
+
+// Coseno minimo entre la normal de un triangulo antes y despues del colapso
+const float COSENO_MINIMO = 0.25f;
+
+enum class TipoVertice : unsigned char {
+    LIBRE,      // Interior, se puede colapsar sobre cualquier vecino
+    BORDE,      // En un borde abierto, solo se colapsa sobre el borde
+    FIJO        // Costura, esquina o arista no manifold
+};
+
+// Matriz simetrica 4x4 del error cuadratico y el peso acumulado de sus planos
+struct Cuadrica {
+    double a[10];
+    double peso;
+
+    Cuadrica() : peso(0.0) { memset(a, 0, sizeof(a)); }
+
+    void agregarPlano(const glm::dvec3& n, double d, double pesoPlano)
+    {
+        a[0] += pesoPlano * n.x * n.x; a[1] += pesoPlano * n.x * n.y; a[2] += pesoPlano * n.x * n.z; a[3] += pesoPlano * n.x * d;
+        a[4] += pesoPlano * n.y * n.y; a[5] += pesoPlano * n.y * n.z; a[6] += pesoPlano * n.y * d;
+        a[7] += pesoPlano * n.z * n.z; a[8] += pesoPlano * n.z * d;
+        a[9] += pesoPlano * d * d;
+        peso += pesoPlano;
+    }
+
+    void sumar(const Cuadrica& otra)
+    {
+        for (int i = 0; i < 10; i++) a[i] += otra.a[i];
+        peso += otra.peso;
+    }
+
+    // Distancia cuadrada promedio del punto a los planos acumulados
+    double evaluar(const glm::vec3& p) const
+    {
+        double x = p.x, y = p.y, z = p.z;
+        double error = a[0] * x * x + 2.0 * a[1] * x * y + 2.0 * a[2] * x * z + 2.0 * a[3] * x
+                     + a[4] * y * y + 2.0 * a[5] * y * z + 2.0 * a[6] * y
+                     + a[7] * z * z + 2.0 * a[8] * z
+                     + a[9];
+        return peso > 0.0 ? std::max(error, 0.0) / peso : 0.0;
+    }
+};
+
+struct Colapso {
+    double costo;
+    unsigned int origen;
+    unsigned int destino;
+    unsigned int version;
+
+    bool operator>(const Colapso& otro) const { return costo > otro.costo; }
+};
+
+struct HashPosicion {
+    size_t operator()(const glm::vec3& p) const
+    {
+        uint32_t bits[3];
+        memcpy(bits, &p, sizeof(bits));
+        return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+    }
+};
+
+uint64_t claveArista(unsigned int a, unsigned int b)
+{
+    if (a > b) std::swap(a, b);
+    return (static_cast<uint64_t>(a) << 32) | b;
+}
+
+class Simplificador {
+public:
+    Simplificador(const float* vertices, unsigned int numVertices, const std::vector<unsigned int>& indices)
+        : numVertices(numVertices), triangulos(indices)
+    {
+        triangulos.resize(indices.size() - indices.size() % 3);
+        numTriangulos = static_cast<unsigned int>(triangulos.size() / 3);
+        vivos = numTriangulos;
+
+        posiciones.resize(numVertices);
+        for (unsigned int v = 0; v < numVertices; v++) {
+            const float* datos = vertices + static_cast<size_t>(v) * FLOTANTES_POR_VERTICE;
+            // Se suma 0 para que -0 y 0 se suelden en la misma posicion
+            posiciones[v] = glm::vec3(datos[0] + 0.0f, datos[1] + 0.0f, datos[2] + 0.0f);
+        }
+
+        soldarPosiciones();
+        clasificarVertices();
+        calcularCuadricas();
+
+        trianguloVivo.assign(numTriangulos, 1);
+        triangulosVertice.resize(numVertices);
+        for (unsigned int t = 0; t < numTriangulos; t++) {
+            for (int k = 0; k < 3; k++) {
+                triangulosVertice[triangulos[t * 3 + k]].push_back(t);
+            }
+        }
+        colapsado.assign(numVertices, 0);
+        versiones.assign(numVertices, 0);
+    }
+
+    std::vector<unsigned int> ejecutar(size_t indicesObjetivo, float errorMaximo, float* errorResultante)
+    {
+        double costoMaximo = static_cast<double>(errorMaximo) * errorMaximo;
+        double costoAlcanzado = 0.0;
+
+        for (unsigned int v = 0; v < numVertices; v++) {
+            encolarMejorColapso(v);
+        }
+
+        while (static_cast<size_t>(vivos) * 3 > indicesObjetivo && !cola.empty()) {
+            Colapso colapso = cola.top();
+            cola.pop();
+            if (colapsado[colapso.origen] || colapso.version != versiones[colapso.origen]) continue;
+
+            // Los vecinos pudieron cambiar desde que se encolo
+            if (!esColapsoValido(colapso.origen, colapso.destino)) {
+                encolarMejorColapso(colapso.origen);
+                continue;
+            }
+            if (colapso.costo > costoMaximo) break;
+
+            colapsar(colapso.origen, colapso.destino);
+            costoAlcanzado = std::max(costoAlcanzado, colapso.costo);
+        }
+
+        if (errorResultante != nullptr) {
+            *errorResultante = static_cast<float>(sqrt(costoAlcanzado));
+        }
+
+        std::vector<unsigned int> resultado;
+        resultado.reserve(static_cast<size_t>(vivos) * 3);
+        for (unsigned int t = 0; t < numTriangulos; t++) {
+            if (!trianguloVivo[t]) continue;
+            resultado.insert(resultado.end(), triangulos.begin() + t * 3, triangulos.begin() + t * 3 + 3);
+        }
+        return resultado;
+    }
+
+private:
+    unsigned int numVertices;
+    unsigned int numTriangulos;
+    unsigned int vivos;
+    std::vector<unsigned int> triangulos;
+    std::vector<glm::vec3> posiciones;
+    std::vector<unsigned int> soldado;          // Primer vertice con la misma posicion
+    std::vector<TipoVertice> tipos;
+    std::vector<Cuadrica> cuadricas;
+    std::vector<char> trianguloVivo;
+    std::vector<std::vector<unsigned int>> triangulosVertice;
+    std::vector<char> colapsado;
+    std::vector<unsigned int> versiones;
+    std::priority_queue<Colapso, std::vector<Colapso>, std::greater<Colapso>> cola;
+    std::unordered_map<uint64_t, unsigned int> usosArista;
+
+    void soldarPosiciones()
+    {
+        soldado.resize(numVertices);
+        std::unordered_map<glm::vec3, unsigned int, HashPosicion> primeros;
+        for (unsigned int v = 0; v < numVertices; v++) {
+            auto it = primeros.insert(std::make_pair(posiciones[v], v)).first;
+            soldado[v] = it->second;
+        }
+    }
+
+    void clasificarVertices()
+    {
+        // Cuantas versiones de cada posicion usan los triangulos (mas de una es una costura)
+        std::vector<unsigned int> primerUso(numVertices, UINT32_MAX);
+        std::vector<char> costura(numVertices, 0);
+        for (unsigned int v : triangulos) {
+            unsigned int s = soldado[v];
+            if (primerUso[s] == UINT32_MAX) primerUso[s] = v;
+            else if (primerUso[s] != v) costura[s] = 1;
+        }
+
+        // Aristas de la superficie soldada: 1 uso es borde, mas de 2 es no manifold
+        for (unsigned int t = 0; t < numTriangulos; t++) {
+            for (int k = 0; k < 3; k++) {
+                usosArista[claveArista(soldado[triangulos[t * 3 + k]], soldado[triangulos[t * 3 + (k + 1) % 3]])]++;
+            }
+        }
+        std::vector<unsigned int> aristasBorde(numVertices, 0);
+        std::vector<char> noManifold(numVertices, 0);
+        for (const auto& arista : usosArista) {
+            unsigned int a = static_cast<unsigned int>(arista.first >> 32);
+            unsigned int b = static_cast<unsigned int>(arista.first & 0xFFFFFFFFu);
+            if (arista.second == 1) {
+                aristasBorde[a]++;
+                aristasBorde[b]++;
+            }
+            else if (arista.second > 2) {
+                noManifold[a] = noManifold[b] = 1;
+            }
+        }
+
+        tipos.resize(numVertices);
+        for (unsigned int v = 0; v < numVertices; v++) {
+            unsigned int s = soldado[v];
+            if (costura[s] || noManifold[s]) tipos[v] = TipoVertice::FIJO;
+            else if (aristasBorde[s] == 0) tipos[v] = TipoVertice::LIBRE;
+            else if (aristasBorde[s] == 2) tipos[v] = TipoVertice::BORDE;
+            else tipos[v] = TipoVertice::FIJO;
+        }
+    }
+
+    void calcularCuadricas()
+    {
+        cuadricas.resize(numVertices);
+        for (unsigned int t = 0; t < numTriangulos; t++) {
+            const unsigned int* tri = &triangulos[t * 3];
+            glm::dvec3 p[3] = { glm::dvec3(posiciones[tri[0]]), glm::dvec3(posiciones[tri[1]]), glm::dvec3(posiciones[tri[2]]) };
+            glm::dvec3 cruz = glm::cross(p[1] - p[0], p[2] - p[0]);
+            double area = glm::length(cruz);
+            if (area <= 0.0) continue;
+            glm::dvec3 normal = cruz / area;
+            double d = -glm::dot(normal, p[0]);
+            for (int k = 0; k < 3; k++) {
+                cuadricas[tri[k]].agregarPlano(normal, d, area);
+            }
+
+            // En los bordes se agrega un plano perpendicular al triangulo que pasa por la arista
+            for (int k = 0; k < 3; k++) {
+                unsigned int a = tri[k];
+                unsigned int b = tri[(k + 1) % 3];
+                if (usosArista[claveArista(soldado[a], soldado[b])] != 1) continue;
+                glm::dvec3 arista = p[(k + 1) % 3] - p[k];
+                double largo2 = glm::dot(arista, arista);
+                if (largo2 <= 0.0) continue;
+                glm::dvec3 normalBorde = glm::normalize(glm::cross(arista, normal));
+                double dBorde = -glm::dot(normalBorde, p[k]);
+                cuadricas[a].agregarPlano(normalBorde, dBorde, largo2 * PESO_BORDE);
+                cuadricas[b].agregarPlano(normalBorde, dBorde, largo2 * PESO_BORDE);
+            }
+        }
+    }
+
+    bool contieneSoldado(unsigned int t, unsigned int s) const
+    {
+        return soldado[triangulos[t * 3]] == s || soldado[triangulos[t * 3 + 1]] == s ||
+               soldado[triangulos[t * 3 + 2]] == s;
+    }
+
+    bool esColapsoValido(unsigned int origen, unsigned int destino) const
+    {
+        if (tipos[origen] == TipoVertice::FIJO || colapsado[destino]) return false;
+
+        // La arista debe seguir existiendo; en el borde debe ser arista de borde
+        unsigned int sDestino = soldado[destino];
+        unsigned int compartidos = 0;
+        for (unsigned int t : triangulosVertice[origen]) {
+            if (trianguloVivo[t] && contieneSoldado(t, sDestino)) compartidos++;
+        }
+        if (compartidos == 0) return false;
+        if (tipos[origen] == TipoVertice::BORDE &&
+            (compartidos != 1 || tipos[destino] == TipoVertice::LIBRE)) return false;
+
+        // Ningun triangulo que sobreviva puede voltearse ni quedar casi plano sobre si mismo
+        const glm::vec3& nueva = posiciones[destino];
+        for (unsigned int t : triangulosVertice[origen]) {
+            if (!trianguloVivo[t] || contieneSoldado(t, sDestino)) continue;
+            const unsigned int* tri = &triangulos[t * 3];
+            glm::vec3 p[3], q[3];
+            for (int k = 0; k < 3; k++) {
+                p[k] = posiciones[tri[k]];
+                q[k] = tri[k] == origen ? nueva : p[k];
+            }
+            glm::vec3 antes = glm::cross(p[1] - p[0], p[2] - p[0]);
+            glm::vec3 despues = glm::cross(q[1] - q[0], q[2] - q[0]);
+            float largos = glm::length(antes) * glm::length(despues);
+            if (largos <= 0.0f || glm::dot(antes, despues) < COSENO_MINIMO * largos) return false;
+        }
+        return true;
+    }
+
+    void encolarMejorColapso(unsigned int origen)
+    {
+        if (colapsado[origen] || tipos[origen] == TipoVertice::FIJO) return;
+
+        Colapso mejor;
+        mejor.costo = -1.0;
+        for (unsigned int t : triangulosVertice[origen]) {
+            if (!trianguloVivo[t]) continue;
+            for (int k = 0; k < 3; k++) {
+                unsigned int destino = triangulos[t * 3 + k];
+                if (destino == origen) continue;
+                double costo = cuadricas[origen].evaluar(posiciones[destino]);
+                if (mejor.costo >= 0.0 && costo >= mejor.costo) continue;
+                if (!esColapsoValido(origen, destino)) continue;
+                mejor.costo = costo;
+                mejor.destino = destino;
+            }
+        }
+        if (mejor.costo < 0.0) return;
+
+        mejor.origen = origen;
+        mejor.version = versiones[origen];
+        cola.push(mejor);
+    }
+
+    void colapsar(unsigned int origen, unsigned int destino)
+    {
+        unsigned int sDestino = soldado[destino];
+        std::vector<unsigned int>& trisDestino = triangulosVertice[destino];
+        for (unsigned int t : triangulosVertice[origen]) {
+            if (!trianguloVivo[t]) continue;
+            // Los triangulos sobre la arista (o sobre una copia de costura del destino) desaparecen
+            if (contieneSoldado(t, sDestino)) {
+                trianguloVivo[t] = 0;
+                vivos--;
+                continue;
+            }
+            for (int k = 0; k < 3; k++) {
+                if (triangulos[t * 3 + k] == origen) triangulos[t * 3 + k] = destino;
+            }
+            trisDestino.push_back(t);
+        }
+        triangulosVertice[origen].clear();
+        colapsado[origen] = 1;
+        cuadricas[destino].sumar(cuadricas[origen]);
+
+        trisDestino.erase(std::remove_if(trisDestino.begin(), trisDestino.end(),
+            [this](unsigned int t) { return !trianguloVivo[t]; }), trisDestino.end());
+
+        // El abanico del destino cambio: sus vertices recalculan su mejor colapso
+        std::vector<unsigned int> afectados(1, destino);
+        for (unsigned int t : trisDestino) {
+            afectados.insert(afectados.end(), triangulos.begin() + t * 3, triangulos.begin() + t * 3 + 3);
+        }
+        std::sort(afectados.begin(), afectados.end());
+        afectados.erase(std::unique(afectados.begin(), afectados.end()), afectados.end());
+        for (unsigned int v : afectados) {
+            versiones[v]++;
+            encolarMejorColapso(v);
+        }
+    }
+};
+
+}
+
+namespace SimplificadorMesh {
+
+std::vector<unsigned int> simplificar(const float* vertices, unsigned int numFlotantes,
+                                      const std::vector<unsigned int>& indices,
+                                      size_t indicesObjetivo, float errorMaximo,
+                                      float* errorResultante)
+{
+    unsigned int numVertices = numFlotantes / FLOTANTES_POR_VERTICE;
+    for (unsigned int indice : indices) {
+        if (indice >= numVertices) {
+            if (errorResultante != nullptr) *errorResultante = 0.0f;
+            return indices;
+        }
+    }
+
+    Simplificador simplificador(vertices, numVertices, indices);
+    return simplificador.ejecutar(indicesObjetivo, errorMaximo, errorResultante);
+}
+
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+// Simplificacion de meshes de triangulos (8 flotantes por vertice) para generar niveles de LOD.
+// Colapsa aristas en orden de error cuadratico (Garland y Heckbert 1997). Cada vertice se
+// colapsa sobre un vecino, sin crear vertices nuevos, asi que los UV y las normales se
+// conservan tal cual. Los vertices en costuras (misma posicion con distintos UV o normales)
+// no se mueven y los de borde solo se deslizan a lo largo del borde.
+namespace SimplificadorMesh {
+
+// Devuelve los indices del mesh simplificado sobre el mismo arreglo de vertices.
+// Se detiene al llegar a indicesObjetivo o cuando el siguiente colapso moveria la
+// superficie mas de errorMaximo (en unidades del modelo)
+std::vector<unsigned int> simplificar(const float* vertices, unsigned int numFlotantes,
+                                      const std::vector<unsigned int>& indices,
+                                      size_t indicesObjetivo, float errorMaximo,
+                                      float* errorResultante = nullptr);
+
+}
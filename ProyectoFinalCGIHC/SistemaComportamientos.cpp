@@ -0,0 +1,64 @@
+#include "SistemaComportamientos.h"
+#include <algorithm>
+
+SistemaComportamientos::SistemaComportamientos()
+{
+}
+
+SistemaComportamientos::~SistemaComportamientos()
+{
+}
+
+void SistemaComportamientos::registrarAnimada(Entidad* entidad)
+{
+    if (entidad != nullptr && entidad->animacion != nullptr) {
+        animadas.push_back(entidad);
+    }
+}
+
+void SistemaComportamientos::registrarKeyframes(Entidad* entidad)
+{
+    if (entidad != nullptr && entidad->animacion != nullptr) {
+        keyframes.push_back(entidad);
+    }
+}
+
+void SistemaComportamientos::registrarEmisorLuz(Entidad* fuente, TipoEmisorLuz tipo,
+                                                const bool* encendida, glm::vec3 desplazamiento)
+{
+    if (fuente != nullptr) {
+        emisoresLuz.push_back({ fuente, tipo, desplazamiento, encendida });
+    }
+}
+
+void SistemaComportamientos::registrarEmisorAudio(Entidad* entidad, const std::string& sonido, float volumen)
+{
+    if (entidad != nullptr && entidad->animacion != nullptr) {
+        emisoresAudio.push_back({ entidad, sonido, volumen, false });
+    }
+}
+
+void SistemaComportamientos::recolectarJerarquia(Entidad* entidad, std::vector<Entidad*>& jerarquia)
+{
+    if (entidad == nullptr) return;
+    jerarquia.push_back(entidad);
+    for (auto* hijo : entidad->hijos) {
+        recolectarJerarquia(hijo, jerarquia);
+    }
+}
+
+void SistemaComportamientos::remover(Entidad* raiz)
+{
+    std::vector<Entidad*> jerarquia;
+    recolectarJerarquia(raiz, jerarquia);
+    auto enJerarquia = [&jerarquia](Entidad* entidad) {
+        return std::find(jerarquia.begin(), jerarquia.end(), entidad) != jerarquia.end();
+    };
+
+    animadas.erase(std::remove_if(animadas.begin(), animadas.end(), enJerarquia), animadas.end());
+    keyframes.erase(std::remove_if(keyframes.begin(), keyframes.end(), enJerarquia), keyframes.end());
+    emisoresLuz.erase(std::remove_if(emisoresLuz.begin(), emisoresLuz.end(),
+        [&](const EmisorLuz& emisor) { return enJerarquia(emisor.fuente); }), emisoresLuz.end());
+    emisoresAudio.erase(std::remove_if(emisoresAudio.begin(), emisoresAudio.end(),
+        [&](const EmisorAudio& emisor) { return enJerarquia(emisor.entidad); }), emisoresAudio.end());
+}
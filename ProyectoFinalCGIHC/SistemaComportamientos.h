@@ -0,0 +1,64 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <glm.hpp>
+#include "Entidad.h"
+
+// Tipos de luz que puede emitir una entidad
+enum class TipoEmisorLuz {
+    FUEGO_AZUL,     // Luz puntual azul sobre la fogata
+    LAMPARA_CALLE,  // Luz puntual calida, solo de noche
+    SPOT_RING       // Spotlight apuntando al ring
+};
+
+// Entidad que agrega una luz a la escena cada frame
+struct EmisorLuz {
+    Entidad* fuente;              // Entidad cuya posicion mundial es la de la luz
+    TipoEmisorLuz tipo;
+    glm::vec3 desplazamiento;     // Desplazamiento de la luz respecto a la fuente
+    const bool* encendida;        // Bandera que la prende o apaga (nullptr = siempre)
+};
+
+// Entidad que reproduce un sonido mientras su animacion esta en curso
+struct EmisorAudio {
+    Entidad* entidad;
+    std::string sonido;
+    float volumen;
+    bool sonando;
+};
+
+// Listas densas de entidades por comportamiento
+// Las entidades se registran al crearse y el frame solo recorre las listas que le interesan,
+// sin comparar nombres contra todas las entidades de la escena
+class SistemaComportamientos {
+public:
+    SistemaComportamientos();
+    ~SistemaComportamientos();
+
+    // Registrar comportamientos
+    void registrarAnimada(Entidad* entidad);
+    void registrarKeyframes(Entidad* entidad);
+    void registrarEmisorLuz(Entidad* fuente, TipoEmisorLuz tipo,
+                            const bool* encendida = nullptr,
+                            glm::vec3 desplazamiento = glm::vec3(0.0f));
+    void registrarEmisorAudio(Entidad* entidad, const std::string& sonido, float volumen);
+
+    // Quitar la entidad y sus hijos de todas las listas
+    void remover(Entidad* raiz);
+
+    // Acceso a las listas
+    const std::vector<Entidad*>& getAnimadas() const { return animadas; }
+    const std::vector<Entidad*>& getKeyframes() const { return keyframes; }
+    const std::vector<EmisorLuz>& getEmisoresLuz() const { return emisoresLuz; }
+    std::vector<EmisorAudio>& getEmisoresAudio() { return emisoresAudio; }
+
+private:
+    std::vector<Entidad*> animadas;
+    std::vector<Entidad*> keyframes;
+    std::vector<EmisorLuz> emisoresLuz;
+    std::vector<EmisorAudio> emisoresAudio;
+
+    // Agrega la entidad y todos sus descendientes al arreglo
+    void recolectarJerarquia(Entidad* entidad, std::vector<Entidad*>& jerarquia);
+};
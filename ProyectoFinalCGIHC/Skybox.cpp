@@ -1,40 +1,48 @@
 #include "Skybox.h"
 
+Mesh* Skybox::skyMesh = nullptr;
+Shader* Skybox::skyShader = nullptr;
+unsigned int Skybox::instancias = 0;
 
-
-Skybox::Skybox()
-{
-}
-
-Skybox::Skybox(std::vector<std::string> faceLocations)
+Skybox::Skybox(const std::vector<std::string>& faceLocations, PoolHilos& pool)
+	: carasSubidas(0), textureId(0)
 {
-	skyShader = new Shader();
-	skyShader->CreateFromFiles("shaders/skybox.vert", "shaders/skybox.frag");
-	uniformProjection = skyShader->GetProjectionLocation();
-	uniformView = skyShader->GetViewLocation();
+	if (instancias++ == 0)
+	{
+		crearRecursosCompartidos();
+	}
 
 	glGenTextures(1, &textureId);
 	glBindTexture(GL_TEXTURE_CUBE_MAP, textureId);
-	int width, height, bitDepth;
-	for (size_t i = 0; i < 6; i++)
-	{
-		unsigned char *texData = stbi_load(faceLocations[i].c_str(), &width, &height, &bitDepth, 0); //el tipo unsigned char es para un array de bytes de la imagen, obtener datos de la imagen 
-		GLint format = (bitDepth == 4) ? GL_RGBA : GL_RGB;
-		if (!texData)
-		{
-			printf("No se encontr : %s", faceLocations[i].c_str());
-			return;
-		}
-		//para cambiar el origen a la esquina inferior izquierda como necesitamos
-		//stbi_set_flip_vertically_on_load(true);
-		glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X +i, 0, GL_RGB, width, height, 0, format, GL_UNSIGNED_BYTE, texData); //SIN CANAL ALPHA A ENOS QUE QUERAMOS AGREGAR EFECTO DE PARALLAX
-		stbi_image_free(texData); //para liberar la informacin de la imagen
-	}
 	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+
+	// Cada cara se decodifica en su propio hilo; los punteros a las caras son estables
+	// porque el skybox no se copia ni se mueve
+	for (size_t i = 0; i < 6; i++)
+	{
+		CaraPendiente* cara = &caras[i];
+		cara->ruta = faceLocations[i];
+		cara->datos = nullptr;
+		cara->ancho = cara->alto = cara->canales = 0;
+		cara->subida = false;
+		cara->decodificacion = pool.encolar([cara]() {
+			// Las caras se voltean como siempre se cargaron: la bandera global que dejaban las
+			// texturas ya estaba activa y skybox.vert muestrea con TexCoords = -pos contando con eso
+			stbi_set_flip_vertically_on_load_thread(true);
+			cara->datos = stbi_load(cara->ruta.c_str(), &cara->ancho, &cara->alto, &cara->canales, 0); //el tipo unsigned char es para un array de bytes de la imagen, obtener datos de la imagen
+		});
+	}
+}
+
+void Skybox::crearRecursosCompartidos()
+{
+	skyShader = new Shader();
+	skyShader->CreateFromFiles("shaders/skybox.vert", "shaders/skybox.frag");
 
 	//Creando el Mesh del skybox
 	unsigned int skyboxIndices[] = {
@@ -70,20 +78,70 @@ Skybox::Skybox(std::vector<std::string> faceLocations)
 	};
 	skyMesh = new Mesh();
 	skyMesh->CreateMesh(skyboxVertices, skyboxIndices, 64, 36);
+}
+
+unsigned int Skybox::subirCaras(unsigned int maximo, bool esperar)
+{
+	unsigned int subidas = 0;
+	for (size_t i = 0; i < 6 && subidas < maximo; i++)
+	{
+		CaraPendiente& cara = caras[i];
+		if (cara.subida || !cara.decodificacion.valid()) continue;
+		if (!esperar && cara.decodificacion.wait_for(std::chrono::seconds(0)) != std::future_status::ready) continue;
+		cara.decodificacion.get();
 
+		if (!cara.datos)
+		{
+			// El cielo queda incompleto y no se dibuja
+			printf("No se encontr : %s\n", cara.ruta.c_str());
+			continue;
+		}
+
+		GLint format = (cara.canales == 4) ? GL_RGBA : GL_RGB;
+		glBindTexture(GL_TEXTURE_CUBE_MAP, textureId);
+		glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + (GLenum)i, 0, GL_RGB, cara.ancho, cara.alto, 0, format, GL_UNSIGNED_BYTE, cara.datos); //SIN CANAL ALPHA A ENOS QUE QUERAMOS AGREGAR EFECTO DE PARALLAX
+		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+		stbi_image_free(cara.datos); //para liberar la informacin de la imagen
+		cara.datos = nullptr;
+		cara.subida = true;
+		carasSubidas++;
+		subidas++;
+	}
+	return subidas;
 }
 
-void Skybox::DrawSkybox(glm::mat4 viewMatrix, glm::mat4 projectionMatrix)
+void Skybox::DrawSkybox(const Skybox* anterior, float mezcla) const
 {
-	viewMatrix = glm::mat4(glm::mat3(viewMatrix));
+	bool hayAnterior = anterior != nullptr && anterior->estaCompleto();
+	if (!estaCompleto())
+	{
+		// Mientras este cielo termina de subirse se sigue viendo el anterior
+		if (hayAnterior)
+		{
+			dibujarCubemaps(anterior->textureId, anterior->textureId, 1.0f);
+		}
+		return;
+	}
+	if (hayAnterior)
+	{
+		dibujarCubemaps(textureId, anterior->textureId, mezcla);
+	}
+	else
+	{
+		dibujarCubemaps(textureId, textureId, 1.0f);
+	}
+}
 
+void Skybox::dibujarCubemaps(GLuint cielo, GLuint cieloAnterior, float mezcla)
+{
 	glDepthMask(false);
 	skyShader->UseShader();
-	glUniformMatrix4fv(uniformProjection, 1, GL_FALSE, glm::value_ptr(projectionMatrix));
-	glUniformMatrix4fv(uniformView, 1, GL_FALSE, glm::value_ptr(viewMatrix));
+	// Las unidades de los samplers y la ubicacion de la mezcla estan fijas en skybox.frag
+	glUniform1f(0, mezcla);
+	glActiveTexture(GL_TEXTURE1);
+	glBindTexture(GL_TEXTURE_CUBE_MAP, cieloAnterior);
 	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_CUBE_MAP, textureId);
-	//skyShader->Validate();
+	glBindTexture(GL_TEXTURE_CUBE_MAP, cielo);
 	skyMesh->RenderMesh();
 	glDepthMask(true);
 
@@ -92,4 +150,27 @@ void Skybox::DrawSkybox(glm::mat4 viewMatrix, glm::mat4 projectionMatrix)
 
 Skybox::~Skybox()
 {
+	for (size_t i = 0; i < 6; i++)
+	{
+		if (caras[i].decodificacion.valid())
+		{
+			caras[i].decodificacion.wait();
+		}
+		if (caras[i].datos)
+		{
+			stbi_image_free(caras[i].datos);
+		}
+	}
+	if (textureId != 0)
+	{
+		glDeleteTextures(1, &textureId);
+	}
+
+	if (--instancias == 0)
+	{
+		delete skyMesh;
+		delete skyShader;
+		skyMesh = nullptr;
+		skyShader = nullptr;
+	}
 }
@@ -3,6 +3,7 @@
 #include "CommonValues.h"
 #include <vector>
 #include <string>
+#include <future>
 #include<glew.h>
 #include<glm.hpp>
 #include<glfw3.h>
@@ -10,19 +11,49 @@
 #include<gtc\type_ptr.hpp>
 #include "Mesh.h"
 #include "Shader_light.h"
+#include "PoolHilos.h"
+
+// Cubemap del cielo. Las seis caras se decodifican en un pool de hilos y se suben a la GPU
+// de a poco con subirCaras; el cubo y el shader son los mismos para todos los skyboxes
 class Skybox
 {
 public:
-	Skybox();
-	Skybox(std::vector<std::string> faceLocations);
-	void DrawSkybox(glm::mat4 viewMatrix, glm::mat4 projectionMatrix);
-		
+	Skybox(const std::vector<std::string>& faceLocations, PoolHilos& pool);
+
+	Skybox(const Skybox&) = delete;
+	Skybox& operator=(const Skybox&) = delete;
+
+	// Subir hasta maximo caras ya decodificadas; con esperar se bloquea hasta que terminen
+	// de decodificarse. Devuelve cuantas se subieron
+	unsigned int subirCaras(unsigned int maximo, bool esperar);
+	// true cuando las seis caras estan en la GPU
+	bool estaCompleto() const { return carasSubidas == 6; }
+
+	// La vista y la proyeccion se leen del UBO DatosFrame
+	// Se mezcla este cielo sobre el anterior (0 = solo el anterior, 1 = solo este); sin
+	// anterior se dibuja este cielo solo. La transicion la guarda el paquete del frame
+	void DrawSkybox(const Skybox* anterior = nullptr, float mezcla = 1.0f) const;
+
 	~Skybox();
 private:
-	Mesh* skyMesh;
-	Shader* skyShader;
+	// Imagen de una cara decodificada en un hilo de trabajo que aun no se sube
+	struct CaraPendiente {
+		std::string ruta;
+		std::future<void> decodificacion;
+		unsigned char* datos;
+		int ancho, alto, canales;
+		bool subida;
+	};
+
+	CaraPendiente caras[6];
+	unsigned int carasSubidas;
 	GLuint textureId;
-	GLuint uniformProjection, uniformView;
 
-};
+	// Cubo y shader compartidos; se crean con el primer skybox y se borran con el ultimo
+	static Mesh* skyMesh;
+	static Shader* skyShader;
+	static unsigned int instancias;
 
+	static void crearRecursosCompartidos();
+	static void dibujarCubemaps(GLuint cielo, GLuint cieloAnterior, float mezcla);
+};
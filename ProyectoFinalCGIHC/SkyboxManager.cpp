@@ -1,14 +1,15 @@
 #include "SkyboxManager.h"
 
-// Carga todos las skyboxes al inicializar el SkyboxManager
+// Encola la carga de todos las skyboxes al inicializar el SkyboxManager
 SkyboxManager::SkyboxManager()
+	: pool(6)
 {
 	loadSkybox(AssetConstants::SkyboxNames::DAY);
 	loadSkybox(AssetConstants::SkyboxNames::NIGHT);
 }
 
 
-// Carga las texturas del skybox
+// Encola la decodificacion de las texturas del skybox
 void SkyboxManager::loadSkybox(const std::string& skyboxName)
 {
 	std::string basePath = AssetConstants::SkyboxPaths::SKYBOX_PATH + skyboxName + "/";
@@ -19,7 +20,7 @@ void SkyboxManager::loadSkybox(const std::string& skyboxName)
 	skyboxFaces.push_back(basePath + AssetConstants::SkyboxPaths::BOTTOM);
 	skyboxFaces.push_back(basePath + AssetConstants::SkyboxPaths::BACK);
 	skyboxFaces.push_back(basePath + AssetConstants::SkyboxPaths::FRONT);
-	skyboxes[skyboxName] = Skybox(skyboxFaces);
+	skyboxes[skyboxName] = std::unique_ptr<Skybox>(new Skybox(skyboxFaces, pool));
 }
 
 // Obtiene un skybox por su nombre
@@ -27,11 +28,40 @@ Skybox* SkyboxManager::getSkybox(const std::string& skyboxName)
 {
 	auto it = skyboxes.find(skyboxName);
 	if (it != skyboxes.end()) {
-		return &(it->second);
+		return it->second.get();
 	}
 	return nullptr;
 }
 
+// Sube las caras listas sin pasar de CARAS_POR_FRAME para no frenar el frame
+void SkyboxManager::actualizar()
+{
+	unsigned int restantes = CARAS_POR_FRAME;
+	for (auto& par : skyboxes) {
+		if (restantes == 0) break;
+		if (!par.second->estaCompleto()) {
+			restantes -= par.second->subirCaras(restantes, false);
+		}
+	}
+}
+
+void SkyboxManager::completarCarga(const std::string& skyboxName)
+{
+	Skybox* skybox = getSkybox(skyboxName);
+	if (skybox != nullptr) {
+		skybox->subirCaras(6, true);
+	}
+}
+
+void SkyboxManager::completarTodos()
+{
+	for (auto& par : skyboxes) {
+		if (!par.second->estaCompleto()) {
+			par.second->subirCaras(6, true);
+		}
+	}
+}
+
 SkyboxManager::~SkyboxManager()
 {
 }
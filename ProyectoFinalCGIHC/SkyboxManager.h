@@ -1,7 +1,9 @@
 #pragma once
 #include "AssetConstants.h"
 #include "Skybox.h"
+#include "PoolHilos.h"
 #include <map>
+#include <memory>
 
 
 // Clase para gestionar el skybox
@@ -13,11 +15,27 @@ public:
 	// Mtodo para obtener un skybox por nombre 
 	Skybox* getSkybox(const std::string& skyboxName);
 
+	// Subir a la GPU las caras que ya se decodificaron (unas pocas por frame)
+	void actualizar();
+
+	// Terminar de cargar un skybox esperando sus caras (para el cielo inicial)
+	void completarCarga(const std::string& skyboxName);
+
+	// Terminar de cargar todos los skyboxes (benchmark)
+	void completarTodos();
+
 	~SkyboxManager();
 
 private:
+	// Caras que se suben por frame entre todos los skyboxes
+	static const unsigned int CARAS_POR_FRAME = 2;
+
+	// Hilos que decodifican las imagenes; se declara antes del mapa para que los
+	// skyboxes se destruyan primero y esperen sus tareas con el pool vivo
+	PoolHilos pool;
+
 	// Mapa para almacenar los skyboxes con su nombre como clave
-	std::map<std::string, Skybox> skyboxes;
+	std::map<std::string, std::unique_ptr<Skybox>> skyboxes;
 
 	void loadSkybox(const std::string& skyboxName);
-};
\ No newline at end of file
+};
@@ -23,6 +23,10 @@ public:
 
 	void SetFlash(glm::vec3 pos, glm::vec3 dir);
 	void SetPos(glm::vec3 pos);
+
+	glm::vec3 GetDirection() const { return direction; }
+	// Coseno del angulo de apertura, como lo usa el shader
+	GLfloat GetProcEdge() const { return procEdge; }
 	~SpotLight();
 
 private:
@@ -1,5 +1,6 @@
 #include "Texture.h"
 #include "CommonValues.h"
+#include "ImagenKTX2.h"
 
 
 Texture::Texture()
@@ -8,7 +9,12 @@ Texture::Texture()
 	width = 0;
 	height = 0;
 	bitDepth = 0;
-	fileLocation = 0;
+	fileLocation = "";
+	datosPendientes = nullptr;
+	imagenComprimida = nullptr;
+	conAlfa = false;
+	transparente = false;
+	bytesVideo = 0;
 }
 Texture::Texture(const char *FileLoc)
 {
@@ -17,17 +23,70 @@ Texture::Texture(const char *FileLoc)
 	height = 0;
 	bitDepth = 0;
 	fileLocation = FileLoc;
+	datosPendientes = nullptr;
+	imagenComprimida = nullptr;
+	conAlfa = false;
+	transparente = false;
+	bytesVideo = 0;
 }
 
 bool Texture::LoadTextureA()
+{
+	DecodificarTextura(true);
+	return SubirTextura();
+}
+bool Texture::LoadTexture()
+{
+	DecodificarTextura(false);
+	return SubirTextura();
+}
+
+bool Texture::DecodificarTextura(bool alfa)
 {
 	//para cambiar el origen a la esquina inferior izquierda como necesitamos
-	stbi_set_flip_vertically_on_load(true);
-	unsigned char *texData = stbi_load(fileLocation, &width, &height, &bitDepth,STBI_rgb_alpha); //el tipo unsigned char es para un array de bytes de la imagen, obtener datos de la imagen 
-	if (!texData)
+	//la version por hilo para que los hilos de carga no compartan la bandera global de stb;
+	//lo demas que decodifica con stb (las caras del skybox) fija tambien su propia bandera
+	stbi_set_flip_vertically_on_load_thread(true);
+	conAlfa = alfa;
+	transparente = false;
+
+	// Si ya se cocino la imagen se sube comprimida y con sus mipmaps, sin decodificarla
+	if (ImagenKTX2::hayVersionCocinada(fileLocation))
+	{
+		ImagenKTX2* imagen = new ImagenKTX2();
+		if (imagen->abrir(ImagenKTX2::rutaCocinada(fileLocation)))
+		{
+			imagenComprimida = imagen;
+			// El cocinador usa BC1 (sin alfa) cuando todos los texeles son opacos
+			transparente = alfa && imagen->tieneAlfa();
+			width = imagen->getAncho();
+			height = imagen->getAlto();
+			return true;
+		}
+		delete imagen;
+	}
+
+	datosPendientes = stbi_load(fileLocation.c_str(), &width, &height, &bitDepth, alfa ? STBI_rgb_alpha : 0); //el tipo unsigned char es para un array de bytes de la imagen, obtener datos de la imagen 
+	if (!datosPendientes)
 	{
-		printf("No se encontr el archivo: %s", fileLocation);
+		printf("No se encontr el archivo: %s", fileLocation.c_str());
+		return false;
 	}
+	// Casi todos los PNG/TGA se cargan con alfa aunque sean opacos; solo se marcan como
+	// transparentes los que de verdad tienen algun texel con alfa menor a 255
+	if (alfa)
+	{
+		size_t numTexeles = (size_t)width * height;
+		for (size_t i = 0; i < numTexeles && !transparente; i++)
+		{
+			transparente = datosPendientes[i * 4 + 3] < 255;
+		}
+	}
+	return true;
+}
+
+bool Texture::SubirTextura()
+{
 	glGenTextures(1, &textureID); //parecido al VAO: crear una textura y asignarle un ndice
 	glBindTexture(GL_TEXTURE_2D, textureID);//se indica que la textura es de tipo 2D, para superficies planas es suficiente esta textura
 	
@@ -42,55 +101,53 @@ bool Texture::LoadTextureA()
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 	//glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-	//if(RGBA) {
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, texData);
-	glGenerateMipmap(GL_TEXTURE_2D);
-	/*}else{
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, texData)
-	glGenerateMipmap(GL_TEXTURE_2D); */
-	glBindTexture(GL_TEXTURE_2D, 0);//para hacer un unbind de la textura
-	stbi_image_free(texData); //para liberar la informacin de la imagen
-	return true;
-}
-bool Texture::LoadTexture()
-{
-	//para cambiar el origen a la esquina inferior izquierda como necesitamos
-	stbi_set_flip_vertically_on_load(true);
-	unsigned char *texData = stbi_load(fileLocation, &width, &height, &bitDepth, 0); //el tipo unsigned char es para un array de bytes de la imagen, obtener datos de la imagen 
-	if (!texData)
+	if (imagenComprimida)
 	{
-		printf("No se encontr el archivo: %s", fileLocation);
+		// Cambia el filtro de reduccion a GL_LINEAR_MIPMAP_LINEAR si el archivo trae mipmaps
+		bytesVideo = imagenComprimida->subir();
+		delete imagenComprimida;
+		imagenComprimida = nullptr;
+		glBindTexture(GL_TEXTURE_2D, 0);
+		return true;
+	}
+	if (conAlfa)
+	{
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, datosPendientes);
+	}
+	else
+	{
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, datosPendientes);
 	}
-	glGenTextures(1, &textureID); //parecido al VAO: crear una textura y asignarle un ndice
-	glBindTexture(GL_TEXTURE_2D, textureID);//se indica que la textura es de tipo 2D, para superficies planas es suficiente esta textura
-
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);// eje S paralelo a X, repetir sobre el eje
-/*	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);// eje S paralelo a X, repetir sobre el eje pero rotando con forme a un centro
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);// eje S paralelo a X, envolver toda la superficie
-*/
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);// eje T paralelo a Y, repetir sobre el eje
-	/*GL_TEXTURE_MIN_FILTER: Para ms cerca o textura se escala a menor tamao. GL_TEXTURE_MAG_FILTER: Para ms lejos o textura se escala a mayor tamao.
-	GL_LINEAR  aplica sampling y blending de texels ms cercanos. GL_NEAREST aplica sample de texel ms cercano
-	*/
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	//glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, texData);
-	glGenerateMipmap(GL_TEXTURE_2D);
 	glGenerateMipmap(GL_TEXTURE_2D);
 	glBindTexture(GL_TEXTURE_2D, 0);//para hacer un unbind de la textura
-	stbi_image_free(texData); //para liberar la informacin de la imagen
+	// El tercio extra es la cadena de mipmaps
+	bytesVideo = (size_t)width * height * (conAlfa ? 4 : 3) * 4 / 3;
+	stbi_image_free(datosPendientes); //para liberar la informacin de la imagen
+	datosPendientes = nullptr;
 	return true;
 }
 void Texture::ClearTexture()
 {
 
-	glDeleteTextures(1, &textureID);
+	// Una textura que no llego a subirse se puede liberar desde un hilo de carga sin tocar OpenGL
+	if (textureID != 0)
+	{
+		glDeleteTextures(1, &textureID);
+	}
 	textureID = 0;
 	width = 0;
 	height = 0;
 	bitDepth = 0;
 	fileLocation = "";
+	if (datosPendientes)
+	{
+		stbi_image_free(datosPendientes);
+		datosPendientes = nullptr;
+	}
+	delete imagenComprimida;
+	imagenComprimida = nullptr;
+	transparente = false;
+	bytesVideo = 0;
 }
 void Texture::UseTexture()
 {	//UnitTexture
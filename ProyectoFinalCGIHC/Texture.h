@@ -1,5 +1,8 @@
 #pragma once
 #include<glew.h>
+#include <string>
+
+class ImagenKTX2;
 
 class Texture
 {
@@ -8,13 +11,33 @@ public:
 	Texture(const char* FileLoc);
 	bool LoadTexture();
 	bool LoadTextureA();
+	// Carga en dos fases: decodificar la imagen (se puede hacer en otro hilo, no usa OpenGL)
+	// y subirla a la GPU en el hilo de OpenGL
+	bool DecodificarTextura(bool alfa);
+	bool SubirTextura();
 	void UseTexture();
 	void ClearTexture();
+	GLuint GetTextureID() const { return textureID; }
+	const std::string& GetFileLocation() const { return fileLocation; }
+	bool GetAlfa() const { return conAlfa; }
+	// true si algun texel tiene alfa menor a 255 (se dibuja con blending despues de lo opaco)
+	bool TieneTransparencia() const { return transparente; }
+	int GetWidth() const { return width; }
+	int GetHeight() const { return height; }
+	// Memoria de video que ocupa la textura con sus mipmaps (0 si no se ha subido)
+	size_t GetBytesVideo() const { return bytesVideo; }
 	~Texture();
 private: 
 	GLuint textureID;
 	int width, height, bitDepth;
-	const char *fileLocation;
+	std::string fileLocation;
+	// Pixeles decodificados que esperan a SubirTextura
+	unsigned char *datosPendientes;
+	// Version cocinada (.ktx2) comprimida por bloques con mipmaps, en lugar de los pixeles
+	ImagenKTX2 *imagenComprimida;
+	bool conAlfa;
+	bool transparente;
+	size_t bytesVideo;
 
 };
 
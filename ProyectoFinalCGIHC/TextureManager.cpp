@@ -1,4 +1,7 @@
 #include "TextureManager.h"
+#include "PoolHilos.h"
+#include "ReporteCarga.h"
+#include "CacheTexturas.h"
 
 // Carga todas las texturas al inicializar el TextureManager
 TextureManager::TextureManager() 
@@ -15,6 +18,8 @@ TextureManager::TextureManager()
 	loadTexture(AssetConstants::TextureNames::POPOTE_ROJO, AssetConstants::TexturePaths::POPOTE_ROJO_PATH);
 
 	loadTexture(AssetConstants::TextureNames::CAUCHO, AssetConstants::TexturePaths::CAUCHO_PATH);
+
+	cargarPendientes();
 }
 
 // Obtiene una textura por su nombre 
@@ -27,15 +32,50 @@ Texture* TextureManager::getTexture(const std::string& textureName)
 	return nullptr;
 }
 
-// Carga una textura en el manager
+// Registra una textura para cargarla con las demas
 void TextureManager::loadTexture(const std::string& textureName, const std::string& texturePath)
 {
-	Texture* texture = new Texture(texturePath.c_str());
-	if (texture->LoadTextureA()) {
-		textures[textureName] = texture;
+	pendientes.push_back({ textureName, texturePath, nullptr, 0.0 });
+}
+
+// Decodifica las texturas registradas en hilos de trabajo y las sube a la GPU en orden
+void TextureManager::cargarPendientes()
+{
+	auto inicio = std::chrono::steady_clock::now();
+	ReporteCarga reporte("TextureManager");
+	PoolHilos pool;
+
+	std::vector<std::future<void>> decodificaciones;
+	decodificaciones.reserve(pendientes.size());
+	for (auto& carga : pendientes) {
+		CargaPendiente* pendiente = &carga;
+		decodificaciones.push_back(pool.encolar([pendiente]() {
+			auto inicioCpu = std::chrono::steady_clock::now();
+			// Las texturas se comparten con los modelos a traves del cache
+			pendiente->textura = CacheTexturas::instancia().adquirir(pendiente->ruta, true);
+			pendiente->msCpu = ReporteCarga::msDesde(inicioCpu);
+		}));
 	}
+
+	for (size_t i = 0; i < pendientes.size(); i++) {
+		decodificaciones[i].get();
+		CargaPendiente& carga = pendientes[i];
+
+		auto inicioGpu = std::chrono::steady_clock::now();
+		if (carga.textura) {
+			CacheTexturas::instancia().subir(carga.textura);
+			textures[carga.nombre] = carga.textura;
+		}
+		reporte.agregar(carga.nombre, carga.msCpu, ReporteCarga::msDesde(inicioGpu));
+	}
+
+	reporte.imprimir(ReporteCarga::msDesde(inicio), pool.getNumHilos());
+	pendientes.clear();
 }
 
 TextureManager::~TextureManager() 
 {
+	for (auto& par : textures) {
+		CacheTexturas::instancia().liberar(par.second);
+	}
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "AssetConstants.h"
 #include "Texture.h"
 #include <map>
+#include <vector>
 
 // Clase para gestionar las texturas
 class TextureManager 
@@ -19,7 +20,18 @@ public:
 private:	
 	std::map<std::string, Texture*> textures;
 
+	// loadTexture solo registra la textura; cargarPendientes decodifica todas en paralelo
+	// y las sube a la GPU en el hilo principal
+	struct CargaPendiente {
+		std::string nombre;
+		std::string ruta;
+		Texture* textura;
+		double msCpu;
+	};
+	std::vector<CargaPendiente> pendientes;
+
 	void loadTexture(const std::string& textureName, const std::string& texturePath);
+	void cargarPendientes();
 
 
 
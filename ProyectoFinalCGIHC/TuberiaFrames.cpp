@@ -0,0 +1,66 @@
+#include "TuberiaFrames.h"
+
+TuberiaFrames::TuberiaFrames(SceneInformation& escena, bool enParalelo)
+    : escena(escena), enParalelo(enParalelo), listo(0), entrada(), hiloSimulacion(1)
+{
+    escena.llenarPaqueteFrame(paquetes[listo], 1.0f);
+}
+
+TuberiaFrames::~TuberiaFrames()
+{
+    // La simulacion usa la escena; no puede quedar corriendo despues de este punto
+    if (simulacion.valid()) {
+        simulacion.wait();
+    }
+}
+
+void TuberiaFrames::iniciar(const EntradaFrame& entradaFrame, std::function<void()> antes)
+{
+    terminar();
+    entrada = entradaFrame;
+    antesDeSimular = std::move(antes);
+
+    if (enParalelo) {
+        simulacion = hiloSimulacion.encolar([this]() { simular(); });
+    }
+    else {
+        simular();
+        completar();
+    }
+}
+
+void TuberiaFrames::terminar()
+{
+    if (!simulacion.valid()) return;
+    // get vuelve a lanzar aqui la excepcion de la simulacion, si hubo
+    simulacion.get();
+    completar();
+}
+
+void TuberiaFrames::completar()
+{
+    // Si las subidas cambiaron el grafo o los lotes, el paquete ya no coincide y se vuelve a llenar
+    unsigned int siguiente = 1 - listo;
+    if (escena.actualizarRecursosGPU()) {
+        escena.llenarPaqueteFrame(paquetes[siguiente], entrada.alpha);
+    }
+    listo = siguiente;
+}
+
+void TuberiaFrames::simular()
+{
+    if (antesDeSimular) {
+        antesDeSimular();
+    }
+
+    // El mouse se entrega en el primer tick
+    for (unsigned int tick = 0; tick < entrada.ticks; tick++) {
+        bool primero = tick == 0;
+        escena.simularTick(entrada.teclas,
+                           primero ? entrada.cambioX : 0.0f,
+                           primero ? entrada.cambioY : 0.0f,
+                           primero ? entrada.cambioScroll : 0.0f,
+                           entrada.deltaTick);
+    }
+    escena.llenarPaqueteFrame(paquetes[1 - listo], entrada.alpha);
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <functional>
+#include <future>
+#include "SceneInformation.h"
+#include "PaqueteFrame.h"
+#include "PoolHilos.h"
+
+// Input de un frame copiado en el hilo principal: la ventana lo sigue escribiendo en
+// glfwPollEvents mientras el hilo de simulacion avanza
+struct EntradaFrame {
+    bool teclas[1024];
+    GLfloat cambioX;
+    GLfloat cambioY;
+    GLfloat cambioScroll;
+    unsigned int ticks;     // Ticks de la simulacion que tocan en este frame
+    float deltaTick;
+    float alpha;            // Mezcla entre el tick anterior y el ultimo para dibujar
+};
+
+// Simulacion y envio a la GPU en paralelo con dos paquetes de frame
+// Mientras el hilo principal dibuja el ultimo paquete terminado, el hilo de simulacion avanza
+// los ticks del frame siguiente y llena el otro paquete. Lo que llama a OpenGL (subidas de
+// modelos y skyboxes y lotes estaticos) se hace en el hilo principal al terminar la simulacion.
+// El paquete que se ve va un frame atras de la simulacion; sin paralelo se simula y se dibuja
+// en orden en el hilo principal. El audio y los mensajes de consola de los ticks tambien salen
+// del hilo de simulacion; la escena se crea antes y se destruye despues de la tuberia, asi que
+// AudioManager nunca se usa desde dos hilos a la vez.
+class TuberiaFrames {
+public:
+    // Llena el primer paquete con el estado inicial de la escena
+    TuberiaFrames(SceneInformation& escena, bool enParalelo);
+    ~TuberiaFrames();
+
+    TuberiaFrames(const TuberiaFrames&) = delete;
+    TuberiaFrames& operator=(const TuberiaFrames&) = delete;
+
+    // Simular el frame siguiente. antesDeSimular corre en el hilo de simulacion antes de los
+    // ticks (el benchmark mueve ahi la camara). Sin paralelo regresa con el paquete ya listo
+    void iniciar(const EntradaFrame& entrada, std::function<void()> antesDeSimular = nullptr);
+
+    // Esperar a la simulacion, subir los recursos a la GPU y dejar su paquete como el listo
+    // No hace nada si no hay una simulacion pendiente
+    void terminar();
+
+    // Ultimo paquete terminado; es el que se dibuja entre iniciar y terminar
+    const PaqueteFrame& getPaqueteListo() const { return paquetes[listo]; }
+
+    bool esParalelo() const { return enParalelo; }
+
+private:
+    SceneInformation& escena;
+    bool enParalelo;
+
+    // Dos paquetes: uno se dibuja mientras el otro se llena
+    PaqueteFrame paquetes[2];
+    unsigned int listo;
+
+    // La entrada se guarda aqui porque el hilo de simulacion la lee despues de que iniciar regresa
+    EntradaFrame entrada;
+    std::function<void()> antesDeSimular;
+
+    // Un solo hilo: los ticks son secuenciales y reparten su trabajo en el PlanificadorTareas
+    PoolHilos hiloSimulacion;
+    std::future<void> simulacion;
+
+    // Ticks del frame y llenado del paquete que no es el listo
+    void simular();
+    // Subidas a la GPU e intercambio de paquetes (hilo principal, sin simulacion corriendo)
+    void completar();
+};
@@ -0,0 +1,104 @@
+#include "VolumenEnvolvente.h"
+#include <cmath>
+
+void AABB::expandir(const glm::vec3& punto)
+{
+    if (!valido) {
+        minimo = punto;
+        maximo = punto;
+        valido = true;
+        return;
+    }
+    minimo = glm::min(minimo, punto);
+    maximo = glm::max(maximo, punto);
+}
+
+void AABB::expandir(const AABB& otra)
+{
+    if (!otra.valido) return;
+    expandir(otra.minimo);
+    expandir(otra.maximo);
+}
+
+AABB AABB::transformar(const glm::mat4& matriz) const
+{
+    AABB resultado;
+    if (!valido) return resultado;
+
+    // Se transforma el centro y la extension se proyecta con el valor absoluto de la matriz
+    glm::vec3 centro = glm::vec3(matriz * glm::vec4(getCentro(), 1.0f));
+    glm::vec3 extension = getExtension();
+    glm::vec3 nuevaExtension(0.0f);
+    for (int i = 0; i < 3; i++) {
+        nuevaExtension += glm::abs(glm::vec3(matriz[i])) * extension[i];
+    }
+
+    resultado.minimo = centro - nuevaExtension;
+    resultado.maximo = centro + nuevaExtension;
+    resultado.valido = true;
+    return resultado;
+}
+
+EsferaEnvolvente EsferaEnvolvente::transformar(const glm::mat4& matriz) const
+{
+    EsferaEnvolvente resultado;
+    if (!valido) return resultado;
+
+    // El radio se escala con el eje de mayor escala
+    float escalaMaxima = glm::max(glm::length(glm::vec3(matriz[0])),
+                         glm::max(glm::length(glm::vec3(matriz[1])), glm::length(glm::vec3(matriz[2]))));
+    resultado.centro = glm::vec3(matriz * glm::vec4(centro, 1.0f));
+    resultado.radio = radio * escalaMaxima;
+    resultado.valido = true;
+    return resultado;
+}
+
+void Frustum::extraer(const glm::mat4& m)
+{
+    // Metodo de Gribb/Hartmann: cada plano es una suma o resta de filas de la matriz
+    glm::vec4 fila0(m[0][0], m[1][0], m[2][0], m[3][0]);
+    glm::vec4 fila1(m[0][1], m[1][1], m[2][1], m[3][1]);
+    glm::vec4 fila2(m[0][2], m[1][2], m[2][2], m[3][2]);
+    glm::vec4 fila3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+    planos[0] = fila3 + fila0;  // Izquierda
+    planos[1] = fila3 - fila0;  // Derecha
+    planos[2] = fila3 + fila1;  // Abajo
+    planos[3] = fila3 - fila1;  // Arriba
+    planos[4] = fila3 + fila2;  // Cerca
+    planos[5] = fila3 - fila2;  // Lejos
+
+    for (int i = 0; i < 6; i++) {
+        planos[i] /= glm::length(glm::vec3(planos[i]));
+    }
+}
+
+ResultadoFrustum Frustum::probarEsfera(const EsferaEnvolvente& esfera) const
+{
+    ResultadoFrustum resultado = ResultadoFrustum::DENTRO;
+    for (int i = 0; i < 6; i++) {
+        float distancia = glm::dot(glm::vec3(planos[i]), esfera.centro) + planos[i].w;
+        if (distancia < -esfera.radio) {
+            return ResultadoFrustum::FUERA;
+        }
+        if (distancia < esfera.radio) {
+            resultado = ResultadoFrustum::INTERSECTA;
+        }
+    }
+    return resultado;
+}
+
+bool Frustum::intersectaAABB(const AABB& caja) const
+{
+    for (int i = 0; i < 6; i++) {
+        // Vertice de la caja mas adentro en la direccion de la normal del plano
+        glm::vec3 normal(planos[i]);
+        glm::vec3 positivo(normal.x >= 0.0f ? caja.maximo.x : caja.minimo.x,
+                           normal.y >= 0.0f ? caja.maximo.y : caja.minimo.y,
+                           normal.z >= 0.0f ? caja.maximo.z : caja.minimo.z);
+        if (glm::dot(normal, positivo) + planos[i].w < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
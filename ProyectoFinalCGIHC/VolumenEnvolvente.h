@@ -0,0 +1,54 @@
+#pragma once
+
+#include <glm.hpp>
+
+// Caja alineada a los ejes
+struct AABB {
+    glm::vec3 minimo;
+    glm::vec3 maximo;
+    bool valido;
+
+    AABB() : minimo(0.0f), maximo(0.0f), valido(false) {}
+
+    // Crecer la caja para incluir un punto u otra caja
+    void expandir(const glm::vec3& punto);
+    void expandir(const AABB& otra);
+
+    glm::vec3 getCentro() const { return (minimo + maximo) * 0.5f; }
+    glm::vec3 getExtension() const { return (maximo - minimo) * 0.5f; }
+
+    // Caja que envuelve a esta caja transformada por la matriz
+    AABB transformar(const glm::mat4& matriz) const;
+};
+
+// Esfera envolvente
+struct EsferaEnvolvente {
+    glm::vec3 centro;
+    float radio;
+    bool valido;
+
+    EsferaEnvolvente() : centro(0.0f), radio(0.0f), valido(false) {}
+
+    // Esfera que envuelve a esta esfera transformada por la matriz
+    EsferaEnvolvente transformar(const glm::mat4& matriz) const;
+};
+
+// Resultado de probar un volumen contra el frustum
+enum class ResultadoFrustum {
+    FUERA,
+    INTERSECTA,
+    DENTRO
+};
+
+// Los seis planos del volumen de vision de la camara
+class Frustum {
+public:
+    // Extraer los planos de la matriz proyeccion * vista
+    void extraer(const glm::mat4& proyeccionVista);
+
+    ResultadoFrustum probarEsfera(const EsferaEnvolvente& esfera) const;
+    bool intersectaAABB(const AABB& caja) const;
+
+private:
+    glm::vec4 planos[6];  // (normal, distancia) con la normal hacia adentro
+};
@@ -1,4 +1,5 @@
 #include "Window.h"
+#include "CommonValues.h"
 
 Window::Window()
 {
@@ -27,7 +28,7 @@ Window::Window(GLint windowWidth, GLint windowHeight)
 		keys[i] = 0;
 	}
 }
-int Window::Initialise()
+int Window::Initialise(bool oculta)
 {
 	//Inicializacin de GLFW
 	if (!glfwInit())
@@ -42,6 +43,11 @@ int Window::Initialise()
 	//para solo usar el core profile de OpenGL y no tener retrocompatibilidad
 	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+	if (oculta)
+	{
+		// Se dibuja en un framebuffer propio; la ventana solo aporta el contexto
+		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	}
 
 	//CREAR VENTANA
 	mainWindow = glfwCreateWindow(width, height, "Proyecto Final", NULL, NULL);
@@ -58,6 +64,9 @@ int Window::Initialise()
 	//asignar el contexto
 	glfwMakeContextCurrent(mainWindow);
 
+	// La simulacin va en ticks fijos, as que el render puede ir con o sin sincrona vertical
+	glfwSwapInterval(!oculta && SINCRONIA_VERTICAL ? 1 : 0);
+
 	//MANEJAR TECLADO y MOUSE
 	createCallbacks();
 
@@ -66,7 +75,10 @@ int Window::Initialise()
 	glewExperimental = GL_TRUE;
 
 	// Deshabilitar cursor 
-	glfwSetInputMode(mainWindow, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+	if (!oculta)
+	{
+		glfwSetInputMode(mainWindow, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+	}
 
 	if (glewInit() != GLEW_OK)
 	{
@@ -83,6 +95,7 @@ int Window::Initialise()
 	glViewport(0, 0, bufferWidth, bufferHeight);
 	//Callback para detectar que se est usando la ventana
 	glfwSetWindowUserPointer(mainWindow, this);
+	return 0;
 }
 
 void Window::createCallbacks()
@@ -153,8 +166,9 @@ void Window::ManejaMouse(GLFWwindow* window, double xPos, double yPos)
 		theWindow->mouseFirstMoved = false;
 	}
 
-	theWindow->xChange = xPos - theWindow->lastX;
-	theWindow->yChange = theWindow->lastY - yPos;
+	// Se acumula hasta que se lee: puede haber frames sin tick de simulacin
+	theWindow->xChange += xPos - theWindow->lastX;
+	theWindow->yChange += theWindow->lastY - yPos;
 
 	theWindow->lastX = xPos;
 	theWindow->lastY = yPos;
@@ -162,7 +176,7 @@ void Window::ManejaMouse(GLFWwindow* window, double xPos, double yPos)
 
 void Window::ManejaScroll(GLFWwindow* window, double xOffset, double yOffset) {
 	Window* theWindow = static_cast<Window*>(glfwGetWindowUserPointer(window));
-	theWindow->scrollChange = (GLfloat)yOffset;
+	theWindow->scrollChange += (GLfloat)yOffset;
 }
 
 GLfloat Window::getScrollChange() {
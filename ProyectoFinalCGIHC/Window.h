@@ -8,7 +8,8 @@ class Window
 public:
 	Window();
 	Window(GLint windowWidth, GLint windowHeight);
-	int Initialise();
+	// oculta: contexto sin ventana visible ni captura del cursor (modo benchmark)
+	int Initialise(bool oculta = false);
 	GLfloat getBufferWidth() { return bufferWidth; }
 	GLfloat getBufferHeight() { return bufferHeight; }
 	GLfloat getXChange();
@@ -0,0 +1,140 @@
+// Microbenchmark del SceneGraph del proyecto sobre una jerarquia generada de 100k Entidad:
+// reconstruir y actualizarTransformaciones contra el recorrido recursivo por apuntadores de
+// Entidad::actualizarTransformacionMundial, con distintas fracciones de nodos moviendose por tick.
+//
+// No forma parte del proyecto de Visual Studio. Para compilarlo desde ProyectoFinalCGIHC:
+//   g++ -std=c++14 -O2 -fpermissive -I glm -I include -I . benchmarks/BenchmarkGrafoEscena.cpp
+//       SceneGraph.cpp Entidad.cpp PlanificadorTareas.cpp VolumenEnvolvente.cpp -lpthread -o benchmark_grafo
+//   cl /std:c++14 /O2 /EHsc /I glm /I include /I . benchmarks\BenchmarkGrafoEscena.cpp
+//       SceneGraph.cpp Entidad.cpp PlanificadorTareas.cpp VolumenEnvolvente.cpp
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include <glm.hpp>
+#include "Entidad.h"
+#include "SceneGraph.h"
+#include "PlanificadorTareas.h"
+
+static const int NUM_NODOS = 100000;
+static const int NUM_ITERACIONES = 50;
+
+// Jerarquia de entidades con las raices aparte, como el vector de SceneInformation
+struct Escena {
+    std::vector<Entidad*> entidades;
+    std::vector<Entidad*> raices;
+
+    ~Escena()
+    {
+        for (auto* entidad : entidades) delete entidad;
+    }
+};
+
+// Se crean los nodos con padres al azar para imitar un heap ya fragmentado; con la misma
+// semilla las dos escenas quedan iguales
+static void generar(Escena& escena, unsigned int semilla)
+{
+    std::mt19937 rng(semilla);
+    std::uniform_real_distribution<float> dist(-50.0f, 50.0f);
+    escena.entidades.reserve(NUM_NODOS);
+    for (int i = 0; i < NUM_NODOS; i++) {
+        Entidad* entidad = new Entidad("entidad_" + std::to_string(i),
+                                       glm::vec3(dist(rng), dist(rng), dist(rng)),
+                                       glm::vec3(dist(rng), dist(rng), dist(rng)));
+        entidad->setTipoObjeto(TipoObjeto::MESH);
+        // Aproximadamente uno de cada diez nodos es raiz, como personajes con sus partes
+        if (i == 0 || rng() % 10 == 0) {
+            escena.raices.push_back(entidad);
+        } else {
+            std::uniform_int_distribution<int> padreDist(0, i - 1);
+            escena.entidades[padreDist(rng)]->agregarHijo(entidad);
+        }
+        escena.entidades.push_back(entidad);
+    }
+}
+
+// Mueve una fraccion de las entidades (las mismas en cada escena) como lo harian las animaciones
+static void mover(Escena& escena, int iteracion, int cadaCuantas)
+{
+    if (cadaCuantas <= 0) return;
+    float desplazamiento = (iteracion % 2 == 0) ? 0.01f : -0.01f;
+    for (size_t i = 0; i < escena.entidades.size(); i += cadaCuantas) {
+        escena.entidades[i]->posicionLocal.x += desplazamiento;
+    }
+}
+
+// Tiempo medio de actualizar, sin contar el movimiento
+template <typename F>
+static double medirMs(Escena& escena, int cadaCuantas, F actualizar)
+{
+    double total = 0.0;
+    for (int i = 0; i < NUM_ITERACIONES; i++) {
+        mover(escena, i, cadaCuantas);
+        auto inicio = std::chrono::high_resolution_clock::now();
+        actualizar();
+        auto fin = std::chrono::high_resolution_clock::now();
+        total += std::chrono::duration<double, std::milli>(fin - inicio).count();
+    }
+    return total / NUM_ITERACIONES;
+}
+
+int main()
+{
+    Escena arbol;
+    Escena plana;
+    generar(arbol, 1234);
+    generar(plana, 1234);
+
+    // Recorrido por apuntadores: cada raiz baja por sus hijos
+    glm::mat4 identidad(1.0f);
+    auto recorrerArbol = [&]() {
+        for (auto* raiz : arbol.raices) raiz->actualizarTransformacionMundial(identidad);
+    };
+
+    SceneGraph grafo;
+    auto inicio = std::chrono::high_resolution_clock::now();
+    grafo.reconstruir(plana.raices);
+    double msReconstruir = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - inicio).count();
+    auto actualizarGrafo = [&]() { grafo.actualizarTransformaciones(); };
+
+    // Primera pasada: todas las matrices se calculan
+    inicio = std::chrono::high_resolution_clock::now();
+    recorrerArbol();
+    double msArbolCompleto = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - inicio).count();
+    inicio = std::chrono::high_resolution_clock::now();
+    actualizarGrafo();
+    double msGrafoCompleto = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - inicio).count();
+
+    std::printf("Nodos: %d (%zu raices), iteraciones: %d, hilos del planificador: %u\n",
+                NUM_NODOS, plana.raices.size(), NUM_ITERACIONES,
+                PlanificadorTareas::instancia().getNumHilos());
+    std::printf("SceneGraph::reconstruir:                          %8.3f ms\n", msReconstruir);
+    std::printf("Primera pasada   arbol: %8.3f ms   SceneGraph: %8.3f ms\n", msArbolCompleto, msGrafoCompleto);
+
+    // Quieto, 1 de cada 100, 1 de cada 10 y todas las entidades moviendose en cada tick
+    const int fracciones[] = { 0, 100, 10, 1 };
+    for (int cadaCuantas : fracciones) {
+        double msArbol = medirMs(arbol, cadaCuantas, recorrerArbol);
+        double msGrafo = medirMs(plana, cadaCuantas, actualizarGrafo);
+        if (cadaCuantas == 0) {
+            std::printf("Sin movimiento   arbol: %8.3f ms   SceneGraph: %8.3f ms\n", msArbol, msGrafo);
+        } else {
+            std::printf("Moviendo 1/%-4d  arbol: %8.3f ms   SceneGraph: %8.3f ms\n", cadaCuantas, msArbol, msGrafo);
+        }
+    }
+
+    // Verificar que ambos recorridos den el mismo resultado
+    float sumaArbol = 0.0f;
+    float sumaGrafo = 0.0f;
+    for (size_t i = 0; i < plana.entidades.size(); i++) {
+        sumaArbol += arbol.entidades[i]->transformacionMundial[3][0];
+        sumaGrafo += grafo.getTransformacionMundial(plana.entidades[i]->getIndiceNodo())[3][0];
+    }
+    std::printf("Comprobacion: %.3f / %.3f\n", sumaArbol, sumaGrafo);
+    return 0;
+}
@@ -0,0 +1,387 @@
+// Cocinador de texturas: convierte las imagenes PNG/TGA/JPG a KTX2 comprimido por bloques
+// (BC1 si la imagen es opaca, BC3 si tiene transparencia) con toda la cadena de mipmaps.
+// Texture carga el archivo <imagen>.ktx2 en lugar de la imagen cuando existe y no es mas
+// viejo que la original, asi que no decodifica ni llama a glGenerateMipmap en el arranque.
+//
+// No forma parte del proyecto de Visual Studio. Para compilarlo desde ProyectoFinalCGIHC:
+//   g++ -std=c++17 -O2 -I . herramientas/CocinarTexturas.cpp -o cocinar_texturas
+//   cl /std:c++17 /O2 /EHsc /I . herramientas\CocinarTexturas.cpp
+//
+// Uso (desde el directorio de trabajo del juego):
+//   cocinar_texturas [--forzar] [archivos o carpetas...]     (por omision: Textures)
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+#include "FormatoKTX2.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// Imagen RGBA8 de un nivel de la cadena de mipmaps
+struct Imagen {
+    uint32_t ancho;
+    uint32_t alto;
+    std::vector<uint8_t> pixeles;
+
+    const uint8_t* pixel(uint32_t x, uint32_t y) const
+    {
+        x = std::min(x, ancho - 1);
+        y = std::min(y, alto - 1);
+        return &pixeles[(static_cast<size_t>(y) * ancho + x) * 4];
+    }
+};
+
+// Siguiente nivel con un filtro de caja de 2x2 (como glGenerateMipmap)
+Imagen reducir(const Imagen& fuente)
+{
+    Imagen destino;
+    destino.ancho = std::max(1u, fuente.ancho / 2);
+    destino.alto = std::max(1u, fuente.alto / 2);
+    destino.pixeles.resize(static_cast<size_t>(destino.ancho) * destino.alto * 4);
+    for (uint32_t y = 0; y < destino.alto; y++) {
+        for (uint32_t x = 0; x < destino.ancho; x++) {
+            const uint8_t* a = fuente.pixel(2 * x, 2 * y);
+            const uint8_t* b = fuente.pixel(2 * x + 1, 2 * y);
+            const uint8_t* c = fuente.pixel(2 * x, 2 * y + 1);
+            const uint8_t* d = fuente.pixel(2 * x + 1, 2 * y + 1);
+            uint8_t* salida = &destino.pixeles[(static_cast<size_t>(y) * destino.ancho + x) * 4];
+            for (int canal = 0; canal < 4; canal++) {
+                salida[canal] = static_cast<uint8_t>((a[canal] + b[canal] + c[canal] + d[canal] + 2) / 4);
+            }
+        }
+    }
+    return destino;
+}
+
+uint16_t empacar565(const float color[3])
+{
+    int r = static_cast<int>(std::lround(std::min(std::max(color[0], 0.0f), 255.0f) * 31.0f / 255.0f));
+    int g = static_cast<int>(std::lround(std::min(std::max(color[1], 0.0f), 255.0f) * 63.0f / 255.0f));
+    int b = static_cast<int>(std::lround(std::min(std::max(color[2], 0.0f), 255.0f) * 31.0f / 255.0f));
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+void desempacar565(uint16_t color, int salida[3])
+{
+    int r = (color >> 11) & 31;
+    int g = (color >> 5) & 63;
+    int b = color & 31;
+    salida[0] = (r << 3) | (r >> 2);
+    salida[1] = (g << 2) | (g >> 4);
+    salida[2] = (b << 3) | (b >> 2);
+}
+
+// Bloque de color BC1 (siempre en modo de 4 colores) a partir de 16 texeles RGBA
+// Los extremos salen del eje principal de los colores del bloque
+void codificarColor(const uint8_t texeles[16][4], uint8_t salida[8])
+{
+    float media[3] = { 0.0f, 0.0f, 0.0f };
+    for (int i = 0; i < 16; i++) {
+        for (int c = 0; c < 3; c++) media[c] += texeles[i][c] / 16.0f;
+    }
+
+    float covarianza[6] = { 0.0f };  // xx xy xz yy yz zz
+    for (int i = 0; i < 16; i++) {
+        float d[3] = { texeles[i][0] - media[0], texeles[i][1] - media[1], texeles[i][2] - media[2] };
+        covarianza[0] += d[0] * d[0]; covarianza[1] += d[0] * d[1]; covarianza[2] += d[0] * d[2];
+        covarianza[3] += d[1] * d[1]; covarianza[4] += d[1] * d[2]; covarianza[5] += d[2] * d[2];
+    }
+
+    // Iteracion de potencias para el eje de mayor varianza
+    float eje[3] = { 1.0f, 1.0f, 1.0f };
+    for (int iteracion = 0; iteracion < 8; iteracion++) {
+        float siguiente[3] = {
+            covarianza[0] * eje[0] + covarianza[1] * eje[1] + covarianza[2] * eje[2],
+            covarianza[1] * eje[0] + covarianza[3] * eje[1] + covarianza[4] * eje[2],
+            covarianza[2] * eje[0] + covarianza[4] * eje[1] + covarianza[5] * eje[2]
+        };
+        float longitud = std::sqrt(siguiente[0] * siguiente[0] + siguiente[1] * siguiente[1] + siguiente[2] * siguiente[2]);
+        if (longitud < 1e-6f) break;
+        for (int c = 0; c < 3; c++) eje[c] = siguiente[c] / longitud;
+    }
+
+    float minimo = 1e30f, maximo = -1e30f;
+    for (int i = 0; i < 16; i++) {
+        float proyeccion = (texeles[i][0] - media[0]) * eje[0] + (texeles[i][1] - media[1]) * eje[1] +
+                           (texeles[i][2] - media[2]) * eje[2];
+        minimo = std::min(minimo, proyeccion);
+        maximo = std::max(maximo, proyeccion);
+    }
+
+    float extremo0[3], extremo1[3];
+    for (int c = 0; c < 3; c++) {
+        extremo0[c] = media[c] + eje[c] * maximo;
+        extremo1[c] = media[c] + eje[c] * minimo;
+    }
+    uint16_t color0 = empacar565(extremo0);
+    uint16_t color1 = empacar565(extremo1);
+    // color0 > color1 selecciona el modo de 4 colores
+    if (color0 < color1) std::swap(color0, color1);
+
+    uint32_t indices = 0;
+    if (color0 != color1) {
+        int paleta[4][3];
+        desempacar565(color0, paleta[0]);
+        desempacar565(color1, paleta[1]);
+        for (int c = 0; c < 3; c++) {
+            paleta[2][c] = (2 * paleta[0][c] + paleta[1][c]) / 3;
+            paleta[3][c] = (paleta[0][c] + 2 * paleta[1][c]) / 3;
+        }
+        for (int i = 0; i < 16; i++) {
+            int mejor = 0, menorDistancia = 1 << 30;
+            for (int p = 0; p < 4; p++) {
+                int dr = texeles[i][0] - paleta[p][0];
+                int dg = texeles[i][1] - paleta[p][1];
+                int db = texeles[i][2] - paleta[p][2];
+                int distancia = dr * dr + dg * dg + db * db;
+                if (distancia < menorDistancia) {
+                    menorDistancia = distancia;
+                    mejor = p;
+                }
+            }
+            indices |= static_cast<uint32_t>(mejor) << (2 * i);
+        }
+    }
+
+    salida[0] = static_cast<uint8_t>(color0 & 0xFF);
+    salida[1] = static_cast<uint8_t>(color0 >> 8);
+    salida[2] = static_cast<uint8_t>(color1 & 0xFF);
+    salida[3] = static_cast<uint8_t>(color1 >> 8);
+    for (int i = 0; i < 4; i++) salida[4 + i] = static_cast<uint8_t>(indices >> (8 * i));
+}
+
+// Bloque de alfa de BC3 en modo de 8 valores interpolados
+void codificarAlfa(const uint8_t texeles[16][4], uint8_t salida[8])
+{
+    int alfa0 = 0, alfa1 = 255;
+    for (int i = 0; i < 16; i++) {
+        alfa0 = std::max(alfa0, static_cast<int>(texeles[i][3]));
+        alfa1 = std::min(alfa1, static_cast<int>(texeles[i][3]));
+    }
+
+    uint64_t indices = 0;
+    if (alfa0 != alfa1) {
+        int paleta[8] = { alfa0, alfa1 };
+        for (int p = 1; p < 7; p++) {
+            paleta[p + 1] = ((7 - p) * alfa0 + p * alfa1) / 7;
+        }
+        for (int i = 0; i < 16; i++) {
+            int mejor = 0, menorDistancia = 1 << 30;
+            for (int p = 0; p < 8; p++) {
+                int distancia = std::abs(texeles[i][3] - paleta[p]);
+                if (distancia < menorDistancia) {
+                    menorDistancia = distancia;
+                    mejor = p;
+                }
+            }
+            indices |= static_cast<uint64_t>(mejor) << (3 * i);
+        }
+    }
+
+    salida[0] = static_cast<uint8_t>(alfa0);
+    salida[1] = static_cast<uint8_t>(alfa1);
+    for (int i = 0; i < 6; i++) salida[2 + i] = static_cast<uint8_t>(indices >> (8 * i));
+}
+
+std::vector<uint8_t> comprimirNivel(const Imagen& imagen, uint32_t vkFormat)
+{
+    std::vector<uint8_t> bloques;
+    bloques.reserve(static_cast<size_t>(FormatoKTX2::bytesNivel(vkFormat, imagen.ancho, imagen.alto)));
+    for (uint32_t by = 0; by < imagen.alto; by += 4) {
+        for (uint32_t bx = 0; bx < imagen.ancho; bx += 4) {
+            // Los bloques del borde repiten el ultimo texel
+            uint8_t texeles[16][4];
+            for (uint32_t i = 0; i < 16; i++) {
+                memcpy(texeles[i], imagen.pixel(bx + i % 4, by + i / 4), 4);
+            }
+            uint8_t bloque[16];
+            if (vkFormat == FormatoKTX2::VK_FORMAT_BC3_UNORM_BLOCK) {
+                codificarAlfa(texeles, bloque);
+                codificarColor(texeles, bloque + 8);
+                bloques.insert(bloques.end(), bloque, bloque + 16);
+            }
+            else {
+                codificarColor(texeles, bloque);
+                bloques.insert(bloques.end(), bloque, bloque + 8);
+            }
+        }
+    }
+    return bloques;
+}
+
+void agregarU32(std::vector<uint8_t>& destino, uint32_t valor)
+{
+    for (int i = 0; i < 4; i++) destino.push_back(static_cast<uint8_t>(valor >> (8 * i)));
+}
+
+// Descriptor de formato de datos (DFD) basico que exige KTX2 para BC1 y BC3
+std::vector<uint8_t> crearDescriptor(uint32_t vkFormat)
+{
+    bool bc3 = vkFormat == FormatoKTX2::VK_FORMAT_BC3_UNORM_BLOCK;
+    uint32_t numMuestras = bc3 ? 2 : 1;
+    uint32_t tamanoBloque = 24 + 16 * numMuestras;
+
+    std::vector<uint8_t> dfd;
+    agregarU32(dfd, 4 + tamanoBloque);                       // dfdTotalSize
+    agregarU32(dfd, 0);                                      // vendorId = Khronos, descriptorType = basico
+    agregarU32(dfd, 2 | (tamanoBloque << 16));               // versionNumber = 2, descriptorBlockSize
+    agregarU32(dfd, (bc3 ? 130u : 128u) | (1u << 8) | (1u << 16));  // modelo BC3/BC1A, primarios BT.709, lineal
+    agregarU32(dfd, 3 | (3 << 8));                           // bloque de 4x4x1x1
+    agregarU32(dfd, bc3 ? 16 : 8);                           // bytesPlane0
+    agregarU32(dfd, 0);
+    if (bc3) {
+        agregarU32(dfd, 0 | (63u << 16) | (15u << 24));      // alfa en los bits 0-63
+        agregarU32(dfd, 0); agregarU32(dfd, 0); agregarU32(dfd, 0xFFFFFFFFu);
+        agregarU32(dfd, 64 | (63u << 16) | (0u << 24));      // color en los bits 64-127
+    }
+    else {
+        agregarU32(dfd, 0 | (63u << 16) | (0u << 24));       // color en los bits 0-63
+    }
+    agregarU32(dfd, 0); agregarU32(dfd, 0); agregarU32(dfd, 0xFFFFFFFFu);
+    return dfd;
+}
+
+bool cocinar(const fs::path& rutaFuente, const fs::path& rutaSalida, size_t& bytesAntes, size_t& bytesDespues)
+{
+    // Mismo origen que usa Texture al decodificar (esquina inferior izquierda)
+    stbi_set_flip_vertically_on_load(true);
+    int ancho, alto, canales;
+    unsigned char* datos = stbi_load(rutaFuente.string().c_str(), &ancho, &alto, &canales, STBI_rgb_alpha);
+    if (!datos) {
+        printf("No se pudo leer %s: %s\n", rutaFuente.string().c_str(), stbi_failure_reason());
+        return false;
+    }
+
+    Imagen imagen;
+    imagen.ancho = static_cast<uint32_t>(ancho);
+    imagen.alto = static_cast<uint32_t>(alto);
+    imagen.pixeles.assign(datos, datos + static_cast<size_t>(ancho) * alto * 4);
+    stbi_image_free(datos);
+
+    bool transparente = false;
+    for (size_t i = 3; i < imagen.pixeles.size(); i += 4) {
+        if (imagen.pixeles[i] != 255) {
+            transparente = true;
+            break;
+        }
+    }
+    uint32_t vkFormat = transparente ? FormatoKTX2::VK_FORMAT_BC3_UNORM_BLOCK
+                                     : FormatoKTX2::VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+
+    std::vector<std::vector<uint8_t>> niveles;
+    niveles.push_back(comprimirNivel(imagen, vkFormat));
+    bytesAntes += imagen.pixeles.size();
+    while (imagen.ancho > 1 || imagen.alto > 1) {
+        imagen = reducir(imagen);
+        niveles.push_back(comprimirNivel(imagen, vkFormat));
+        bytesAntes += imagen.pixeles.size();
+    }
+
+    std::vector<uint8_t> dfd = crearDescriptor(vkFormat);
+    uint32_t numNiveles = static_cast<uint32_t>(niveles.size());
+
+    FormatoKTX2::Cabecera cabecera;
+    memset(&cabecera, 0, sizeof(cabecera));
+    memcpy(cabecera.identificador, FormatoKTX2::IDENTIFICADOR, sizeof(cabecera.identificador));
+    cabecera.vkFormat = vkFormat;
+    cabecera.typeSize = 1;
+    cabecera.pixelWidth = static_cast<uint32_t>(ancho);
+    cabecera.pixelHeight = static_cast<uint32_t>(alto);
+    cabecera.faceCount = 1;
+    cabecera.levelCount = numNiveles;
+    cabecera.dfdByteOffset = static_cast<uint32_t>(sizeof(cabecera) + sizeof(FormatoKTX2::Nivel) * numNiveles);
+    cabecera.dfdByteLength = static_cast<uint32_t>(dfd.size());
+
+    // KTX2 guarda los niveles del mas pequeno al mas grande, alineados al tamano de bloque
+    uint64_t alineacion = FormatoKTX2::bytesPorBloque(vkFormat);
+    std::vector<FormatoKTX2::Nivel> indice(numNiveles);
+    uint64_t posicion = cabecera.dfdByteOffset + cabecera.dfdByteLength;
+    for (uint32_t i = numNiveles; i-- > 0;) {
+        posicion = (posicion + alineacion - 1) / alineacion * alineacion;
+        indice[i].byteOffset = posicion;
+        indice[i].byteLength = niveles[i].size();
+        indice[i].uncompressedByteLength = niveles[i].size();
+        posicion += niveles[i].size();
+    }
+
+    std::vector<uint8_t> archivo(static_cast<size_t>(posicion), 0);
+    memcpy(archivo.data(), &cabecera, sizeof(cabecera));
+    memcpy(archivo.data() + sizeof(cabecera), indice.data(), sizeof(FormatoKTX2::Nivel) * numNiveles);
+    memcpy(archivo.data() + cabecera.dfdByteOffset, dfd.data(), dfd.size());
+    for (uint32_t i = 0; i < numNiveles; i++) {
+        memcpy(archivo.data() + indice[i].byteOffset, niveles[i].data(), niveles[i].size());
+        bytesDespues += niveles[i].size();
+    }
+
+    std::ofstream salida(rutaSalida, std::ios::binary | std::ios::trunc);
+    salida.write(reinterpret_cast<const char*>(archivo.data()), static_cast<std::streamsize>(archivo.size()));
+    if (!salida) {
+        printf("No se pudo escribir %s\n", rutaSalida.string().c_str());
+        return false;
+    }
+
+    printf("%-48s %5dx%-5d %s %2u niveles\n", rutaFuente.string().c_str(), ancho, alto,
+           transparente ? "BC3" : "BC1", numNiveles);
+    return true;
+}
+
+bool esImagen(const fs::path& ruta)
+{
+    std::string extension = ruta.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(tolower(c)); });
+    return extension == ".png" || extension == ".tga" || extension == ".jpg" || extension == ".jpeg";
+}
+
+int main(int argc, char** argv)
+{
+    bool forzar = false;
+    std::vector<fs::path> entradas;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--forzar") == 0) forzar = true;
+        else entradas.push_back(argv[i]);
+    }
+    if (entradas.empty()) entradas.push_back("Textures");
+
+    std::vector<fs::path> imagenes;
+    for (const auto& entrada : entradas) {
+        if (fs::is_directory(entrada)) {
+            for (const auto& archivo : fs::recursive_directory_iterator(entrada)) {
+                if (archivo.is_regular_file() && esImagen(archivo.path())) imagenes.push_back(archivo.path());
+            }
+        }
+        else if (esImagen(entrada)) {
+            imagenes.push_back(entrada);
+        }
+    }
+
+    unsigned int cocinadas = 0, alDia = 0, fallidas = 0;
+    size_t bytesAntes = 0, bytesDespues = 0;
+    for (const auto& imagen : imagenes) {
+        // Misma convencion que ImagenKTX2::rutaCocinada
+        fs::path salida = imagen.string() + ".ktx2";
+        std::error_code error;
+        if (!forzar && fs::exists(salida) && fs::last_write_time(salida, error) >= fs::last_write_time(imagen, error)) {
+            alDia++;
+            continue;
+        }
+        if (cocinar(imagen, salida, bytesAntes, bytesDespues)) cocinadas++;
+        else fallidas++;
+    }
+
+    printf("%u cocinadas, %u al dia, %u con error\n", cocinadas, alDia, fallidas);
+    if (bytesDespues > 0) {
+        printf("Memoria de video con mipmaps: %.2f MB en RGBA8 -> %.2f MB comprimida (%.1fx)\n",
+               bytesAntes / (1024.0 * 1024.0), bytesDespues / (1024.0 * 1024.0),
+               static_cast<double>(bytesAntes) / bytesDespues);
+    }
+    return fallidas == 0 ? 0 : 1;
+}
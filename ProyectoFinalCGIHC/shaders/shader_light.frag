@@ -1,16 +1,15 @@
-#version 330
+#version 430
 
 in vec4 vCol;
 in vec2 TexCoord;
 in vec3 Normal;
 in vec3 FragPos;
 in vec4 vColor;
+// Intensidad especular y brillo del dibujo
+flat in vec2 vMaterial;
 
 out vec4 color;
 
-const int MAX_POINT_LIGHTS = 5;
-const int MAX_SPOT_LIGHTS = 2;
-
 struct Light
 {
 	vec3 color;
@@ -47,17 +46,39 @@ struct Material
 	float shininess;
 };
 
-uniform int pointLightCount;
-uniform int spotLightCount;
+// Luces puntuales y spot que llena ClustersLuces cada frame
+struct LuzGPU
+{
+	vec4 colorAmbiente;		// rgb = color, a = intensidad ambiental
+	vec4 posicionDifusa;	// xyz = posicion, w = intensidad difusa
+	vec4 atenuacion;		// constante, lineal, exponencial, radio
+	vec4 direccionBorde;	// xyz = direccion, w = borde del spot (< -1 = luz puntual)
+};
+
+layout (std140, binding = 0) uniform ParametrosClusters
+{
+	uvec4 dimensionesClusters;	// clusters en x, y, z
+	vec4 tamanoTile;			// ancho y alto del tile en pixeles, escala y sesgo de la rebanada
+	vec4 planosCamara;			// cerca, lejos
+};
 
-uniform DirectionalLight directionalLight;
-uniform PointLight pointLights[MAX_POINT_LIGHTS];
-uniform SpotLight spotLights[MAX_SPOT_LIGHTS];
+layout (std430, binding = 1) readonly buffer BufferLuces { LuzGPU luces[]; };
+layout (std430, binding = 2) readonly buffer BufferClusters { uvec2 rangosClusters[]; };
+layout (std430, binding = 3) readonly buffer BufferIndicesLuces { uint indicesLuces[]; };
+
+// Camara y luz direccional del frame (DatosFrame en C++, compartido con los demas programas)
+layout (std140, binding = 1) uniform DatosFrame
+{
+	mat4 projection;
+	mat4 view;
+	vec4 posicionCamara;			// xyz
+	vec4 luzDireccionalColor;		// rgb = color, a = intensidad ambiental
+	vec4 luzDireccionalDireccion;	// xyz = direccion, w = intensidad difusa
+};
 
 uniform sampler2D theTexture;
-uniform Material material;
+Material material;
 
-uniform vec3 eyePosition;
 
 vec4 CalcLightByDirection(Light light, vec3 direction)
 {
@@ -70,7 +91,7 @@ vec4 CalcLightByDirection(Light light, vec3 direction)
 	
 	if(diffuseFactor > 0.0f)
 	{//si hay diffuse color entonces existe specular color; dependemos de la posición de la cámara
-		vec3 fragToEye = normalize(eyePosition - FragPos);
+		vec3 fragToEye = normalize(posicionCamara.xyz - FragPos);
 		vec3 reflectedVertex = normalize(reflect(direction, normalize(Normal)));
 		
 		float specularFactor = dot(fragToEye, reflectedVertex);
@@ -86,6 +107,11 @@ vec4 CalcLightByDirection(Light light, vec3 direction)
 
 vec4 CalcDirectionalLight()
 {
+	DirectionalLight directionalLight;
+	directionalLight.base.color = luzDireccionalColor.rgb;
+	directionalLight.base.ambientIntensity = luzDireccionalColor.a;
+	directionalLight.base.diffuseIntensity = luzDireccionalDireccion.w;
+	directionalLight.direction = luzDireccionalDireccion.xyz;
 	return CalcLightByDirection(directionalLight.base, directionalLight.direction);
 }
 
@@ -132,23 +158,54 @@ vec4 CalcSpotLight(SpotLight sLight)
 
 
 
-vec4 CalcPointLights()
+// Cluster al que pertenece el fragmento: tile en pantalla y rebanada por profundidad de vista
+uint IndiceCluster()
 {
-	vec4 totalcolor = vec4(0, 0, 0, 0);
-	for(int i = 0; i < pointLightCount; i++)
-	{		
-		totalcolor += CalcPointLight(pointLights[i]);
-	}
-	
-	return totalcolor;
+	float cerca = planosCamara.x;
+	float lejos = planosCamara.y;
+	float zNdc = gl_FragCoord.z * 2.0 - 1.0;
+	float zVista = 2.0 * cerca * lejos / (lejos + cerca - zNdc * (lejos - cerca));
+
+	uvec3 cluster;
+	cluster.xy = uvec2(gl_FragCoord.xy / tamanoTile.xy);
+	cluster.z = uint(max(log(zVista) * tamanoTile.z - tamanoTile.w, 0.0));
+	cluster = min(cluster, dimensionesClusters.xyz - uvec3(1));
+	return (cluster.z * dimensionesClusters.y + cluster.y) * dimensionesClusters.x + cluster.x;
+}
+
+PointLight LeerLuzPuntual(LuzGPU luz)
+{
+	PointLight pLight;
+	pLight.base.color = luz.colorAmbiente.rgb;
+	pLight.base.ambientIntensity = luz.colorAmbiente.a;
+	pLight.base.diffuseIntensity = luz.posicionDifusa.w;
+	pLight.position = luz.posicionDifusa.xyz;
+	pLight.constant = luz.atenuacion.x;
+	pLight.linear = luz.atenuacion.y;
+	pLight.exponent = luz.atenuacion.z;
+	return pLight;
 }
 
-vec4 CalcSpotLights()
+// Solo se recorren las luces asignadas al cluster del fragmento
+vec4 CalcLucesCluster()
 {
 	vec4 totalcolor = vec4(0, 0, 0, 0);
-	for(int i = 0; i < spotLightCount; i++)
-	{		
-		totalcolor += CalcSpotLight(spotLights[i]);
+	uvec2 rango = rangosClusters[IndiceCluster()];
+	for(uint i = 0u; i < rango.y; i++)
+	{
+		LuzGPU luz = luces[indicesLuces[rango.x + i]];
+		if(luz.direccionBorde.w < -1.0)
+		{
+			totalcolor += CalcPointLight(LeerLuzPuntual(luz));
+		}
+		else
+		{
+			SpotLight sLight;
+			sLight.base = LeerLuzPuntual(luz);
+			sLight.direction = luz.direccionBorde.xyz;
+			sLight.edge = luz.direccionBorde.w;
+			totalcolor += CalcSpotLight(sLight);
+		}
 	}
 	
 	return totalcolor;
@@ -157,9 +214,9 @@ vec4 CalcSpotLights()
 
 void main()
 {
+	material = Material(vMaterial.x, vMaterial.y);
 	vec4 finalcolor = CalcDirectionalLight();
-	finalcolor += CalcPointLights();
-	finalcolor += CalcSpotLights();
+	finalcolor += CalcLucesCluster();
 	color = texture(theTexture, TexCoord)*vColor;
 	color = texture(theTexture, TexCoord)*vColor*finalcolor;
 	
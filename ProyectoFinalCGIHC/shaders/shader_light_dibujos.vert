@@ -0,0 +1,51 @@
+#version 430
+
+layout (location = 0) in vec3 pos;
+layout (location = 1) in vec2 tex;
+layout (location = 2) in vec3 norm;
+// Indice del dibujo en BufferDibujos (atributo por instancia que empieza en la base instance)
+layout (location = 7) in uint indiceDibujo;
+
+out vec4 vCol;
+out vec2 TexCoord;
+out vec3 Normal;
+out vec3 FragPos;
+out vec4 vColor;
+flat out vec2 vMaterial;
+
+uniform vec3 color;
+
+// Camara del frame (bloque DatosFrame, igual que en shader_light.frag)
+layout (std140, binding = 1) uniform DatosFrame
+{
+	mat4 projection;
+	mat4 view;
+	vec4 posicionCamara;
+	vec4 luzDireccionalColor;
+	vec4 luzDireccionalDireccion;
+};
+
+// Datos de cada dibujo del frame (DatosDibujoGPU en C++)
+struct DatosDibujo
+{
+	mat4 model;
+	mat4 normal;		// Transpuesta de la inversa de model, calculada una vez por nodo
+	vec4 material;		// x = intensidad especular, y = brillo
+};
+
+layout (std430, binding = 4) readonly buffer BufferDibujos { DatosDibujo dibujos[]; };
+
+
+void main()
+{
+	DatosDibujo dibujo = dibujos[indiceDibujo];
+	gl_Position = projection * view * dibujo.model * vec4(pos, 1.0);
+	vCol = vec4(0.0, 1.0, 0.0, 1.0f);
+	vColor=vec4(color,1.0f);
+	TexCoord = tex;
+	// La transpuesta de la inversa viene calculada para soportar escalas no uniformes
+	Normal = mat3(dibujo.normal) * norm;
+	vMaterial = dibujo.material.xy;
+
+	FragPos = (dibujo.model * vec4(pos, 1.0)).xyz;
+}
@@ -1,8 +1,11 @@
-#version 330
+#version 430
 in vec3 TexCoords;
 out vec4 color;
-uniform samplerCube skybox;
+// Unidades y ubicacion fijas: Skybox las usa sin buscarlas y sobreviven a la recarga en caliente
+layout(binding = 0) uniform samplerCube skybox;
+layout(binding = 1) uniform samplerCube skyboxAnterior;
+layout(location = 0) uniform float mezcla;
 void main()
 {
-color=texture(skybox,TexCoords);
-}
\ No newline at end of file
+color=mix(texture(skyboxAnterior,TexCoords),texture(skybox,TexCoords),mezcla);
+}
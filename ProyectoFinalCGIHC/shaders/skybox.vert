@@ -1,12 +1,20 @@
-#version 330
+#version 430
 
 layout (location = 0) in vec3 pos;
 out vec3 TexCoords;
 
-uniform mat4 projection;
-uniform mat4 view;
+// Camara del frame (bloque DatosFrame, igual que en shader_light.frag)
+layout (std140, binding = 1) uniform DatosFrame
+{
+	mat4 projection;
+	mat4 view;
+	vec4 posicionCamara;
+	vec4 luzDireccionalColor;
+	vec4 luzDireccionalDireccion;
+};
 void main()
 {
 TexCoords= -pos;
-gl_Position= projection*view * vec4(pos,1.0);
+// Sin la traslacion de la camara para que el cubo siempre la rodee
+gl_Position= projection*mat4(mat3(view)) * vec4(pos,1.0);
 }
\ No newline at end of file